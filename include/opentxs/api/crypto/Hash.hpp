@@ -11,6 +11,7 @@
 #include "opentxs/Bytes.hpp"
 #include "opentxs/Proto.hpp"
 
+#include <array>
 #include <cstdint>
 #include <string>
 
@@ -44,6 +45,10 @@ public:
         const std::uint32_t& key,
         const Data& data,
         std::uint32_t& output) const noexcept = 0;
+    OPENTXS_EXPORT virtual void MurmurHash3_128(
+        const std::uint32_t& key,
+        const ReadView data,
+        std::array<std::uint64_t, 2>& output) const noexcept = 0;
     OPENTXS_EXPORT virtual bool PKCS5_PBKDF2_HMAC(
         const Data& input,
         const Data& salt,
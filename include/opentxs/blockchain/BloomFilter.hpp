@@ -8,6 +8,8 @@
 
 #include "opentxs/Forward.hpp"
 
+#include <vector>
+
 namespace opentxs
 {
 using OTBloomFilter = Pimpl<blockchain::BloomFilter>;
@@ -19,6 +21,9 @@ class BloomFilter
 public:
     OPENTXS_EXPORT virtual OTData Serialize() const noexcept = 0;
     OPENTXS_EXPORT virtual bool Test(const Data& element) const noexcept = 0;
+    /// Returns true if any of the elements may be present in the filter
+    OPENTXS_EXPORT virtual bool Test(
+        const std::vector<OTData>& elements) const noexcept = 0;
 
     OPENTXS_EXPORT virtual void AddElement(const Data& element) noexcept = 0;
 
@@ -14,6 +14,7 @@
 #include <iostream>
 #include <vector>
 #include <map>
+#include <memory>
 #include <string>
 #include <cstdint>
 
@@ -541,6 +542,14 @@ public:
         const std::string& twoStr,
         const std::string& threeStr);
 
+    // Values stored by the calling thread until its next Sync are staged,
+    // and only replace the previous contents once that Sync makes them
+    // durable.
+    virtual void Stage() {}
+    // Returns once every value stored or erased by the calling thread has
+    // reached the disk. Writes from other threads may share the same barrier.
+    virtual bool Sync() { return true; }
+
     // Note:
     // Make sure to use: %newobject Factory::createObj();  IN OTAPI.i file!
     //
@@ -686,6 +695,14 @@ OPENTXS_EXPORT bool EraseValueByKey(
     const std::string& twoStr,
     const std::string& threeStr);
 
+// Stage the values stored by this thread until its next Sync.
+
+OPENTXS_EXPORT void Stage();
+
+// Make every value stored by this thread durable.
+
+OPENTXS_EXPORT bool Sync();
+
 #define DECLARE_GET_ADD_REMOVE(name)                                           \
                                                                                \
 protected:                                                                     \
@@ -1668,6 +1685,22 @@ public:
         const std::string& threeStr);
 
 private:
+    struct SyncState;
+
+    // Writes waiting for the next barrier
+    std::unique_ptr<SyncState> sync_;
+
+    // Moves a newly written temporary file into place, or stages it for the
+    // next barrier if the calling thread stages its writes
+    bool commit(const std::string& path, const std::string& temp);
+    // Returns the file which currently holds the contents of path
+    std::string current(const std::string& path) const;
+    // Drops any staged contents for path before it is erased
+    void discard(const std::string& path);
+    bool flush(const std::uint64_t target);
+    void mark_dirty(const std::string& path);
+    std::string temp_path(const std::string& path);
+
     std::int64_t ConstructAndConfirmPathImp(
         const api::internal::Core& api,
         const bool bMakePath,
@@ -1745,6 +1778,9 @@ public:
         const std::string& twoStr,
         const std::string& threeStr) override;
 
+    void Stage() override;
+    bool Sync() override;
+
     static StorageFS* Instantiate() { return new StorageFS; }
 
     ~StorageFS() override;
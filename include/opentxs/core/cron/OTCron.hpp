@@ -12,7 +12,16 @@
 #include "opentxs/core/Contract.hpp"
 #include "opentxs/core/Log.hpp"
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <queue>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace opentxs
 {
@@ -78,7 +87,7 @@ public:
             return false;
     }
     // RECURRING TRANSACTIONS
-    bool AddCronItem(
+    OPENTXS_EXPORT bool AddCronItem(
         std::shared_ptr<OTCronItem> theItem,
         const bool bSaveReceipt,
         const Time tDateAdded);  // Date it was FIRST added to Cron.
@@ -87,7 +96,7 @@ public:
         std::int64_t lTransactionNum,
         Nym_p theRemover,
         const PasswordPrompt& reason);
-    std::shared_ptr<OTCronItem> GetItemByOfficialNum(
+    OPENTXS_EXPORT std::shared_ptr<OTCronItem> GetItemByOfficialNum(
         std::int64_t lTransactionNum);
     std::shared_ptr<OTCronItem> GetItemByValidOpeningNum(
         std::int64_t lOpeningNum);
@@ -127,7 +136,7 @@ public:
      * transaction numbers in there must be enough to last for the entire
      * ProcessCronItems() call, and all the trades and payment plans within,
      * since it will not be replenished again at least until the call has
-     * finished.) */
+     * finished.) Only items which are due are processed. */
     void ProcessCronItems();
 
     std::chrono::milliseconds computeTimeout();
@@ -145,10 +154,16 @@ public:
     }
     inline Nym_p GetServerNym() const { return m_pServerNym; }
 
-    bool LoadCron();
-    bool SaveCron();
+    OPENTXS_EXPORT bool LoadCron();
+    // Writes the items which were marked as changed, and rewrites the cron
+    // file itself only if its lists of items, markets or transaction numbers
+    // have changed since it was last saved.
+    OPENTXS_EXPORT bool SaveCron();
+    // Items modified outside of ProcessCronItems() must be marked so that the
+    // next SaveCron() writes them.
+    OPENTXS_EXPORT void MarkDirty(const std::int64_t lTransactionNum);
 
-    ~OTCron() final;
+    OPENTXS_EXPORT ~OTCron() final;
 
     void InitCron();
 
@@ -175,11 +190,29 @@ private:
     static std::int32_t __cron_max_items_per_nym;
     static Time last_executed_;
 
+    using DueItem = std::pair<Time, std::int64_t>;
+    using DueQueue = std::priority_queue<
+        DueItem,
+        std::vector<DueItem>,
+        std::greater<DueItem>>;
+
     // A list of all valid markets.
     mapOfMarkets m_mapMarkets;
     // Cron Items are found on both lists.
     mapOfCronItems m_mapCronItems;
     multimapOfCronItems m_multimapCronItems;
+    // Cron items by the time they next need processing, earliest first.
+    // Entries for items which have been removed are skipped when they reach
+    // the top.
+    DueQueue m_queueDueItems;
+    // Due date at the top of the queue. computeTimeout() reads it from the
+    // server's cron thread while requests may be adding items.
+    std::atomic<Time> m_tNextDueDate;
+    // Date each cron item was added, and a digest of the item as last
+    // written to its own file.
+    std::map<std::int64_t, std::pair<Time, std::string>> m_mapItemState;
+    // Items which may have changed since they were last written.
+    std::set<std::int64_t> m_setDirtyItems;
     // Always store this in any object that's associated with a specific server.
     OTServerID m_NOTARY_ID;
     // I can't put receipts in people's inboxes without a supply of these.
@@ -187,9 +220,17 @@ private:
     // I don't want to start Cron processing until everything else is all loaded
     //  up and ready to go.
     bool m_bIsActivated{false};
+    // The cron file no longer matches the lists held in memory.
+    bool m_bListsChanged{false};
     // I'll need this for later.
     Nym_p m_pServerNym{nullptr};
 
+    bool erase_item(const std::int64_t lTransactionNum);
+    std::shared_ptr<OTCronItem> load_item(const std::int64_t lTransactionNum);
+    bool save_item(const OTCronItem& item);
+    void schedule(const OTCronItem& item);
+    void update_next_due();
+
     explicit OTCron(const api::internal::Core& server);
 
     OTCron() = delete;
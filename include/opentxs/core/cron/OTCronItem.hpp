@@ -125,6 +125,9 @@ public:
     {
         return m_PROCESS_INTERVAL;
     }
+    // The earliest time at which ProcessCron could do more than wait. OTCron
+    // does not process the item again before then.
+    virtual Time GetNextDueDate() const;
 
     inline OTCron* GetCron() const { return m_pCron; }
     void setServerNym(Nym_p serverNym) { serverNym_ = serverNym; }
@@ -207,6 +207,7 @@ public:
         return m_nNoFailedPayments;
     }
 
+    Time GetNextDueDate() const override;
     // Return True if should stay on OTCron's list for more processing.
     // Return False if expired or otherwise should be removed.
     bool ProcessCron(const PasswordPrompt& reason) override;  // OTCron calls
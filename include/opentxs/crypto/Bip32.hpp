@@ -37,6 +37,29 @@ public:
         const EcdsaCurve& curve,
         const OTPassword& seed,
         const Path& path) const = 0;
+    /** Derive a non-hardened descendant of an extended public key
+     *
+     *  Only the chain code and public key of the parent are used, so no seed
+     *  or password is required. The private key of the output is empty and
+     *  the output path is the parent path extended by path. Only secp256k1
+     *  keys are supported.
+     */
+    OPENTXS_EXPORT virtual Key DerivePublic(
+        const EcdsaCurve& curve,
+        const Key& parent,
+        const Path& path) const = 0;
+    /** Derive count consecutive non-hardened children of an extended
+     *  public key, starting at index first
+     *
+     *  The compressed public keys are written back to back into keys. The
+     *  parent node is validated once for the whole range.
+     */
+    OPENTXS_EXPORT virtual bool DerivePublic(
+        const EcdsaCurve& curve,
+        const Key& parent,
+        const Bip32Index first,
+        const std::size_t count,
+        const AllocateOutput keys) const = 0;
 #endif  // OT_CRYPTO_WITH_BIP32
     OPENTXS_EXPORT virtual bool DeserializePrivate(
         const std::string& serialized,
@@ -17,6 +17,11 @@ namespace crypto
 class EcdsaProvider : virtual public AsymmetricProvider
 {
 public:
+    /// Adds scalar * G to the compressed point pubkey
+    OPENTXS_EXPORT virtual bool PubkeyAdd(
+        const ReadView pubkey,
+        const ReadView scalar,
+        const AllocateOutput result) const noexcept = 0;
     OPENTXS_EXPORT virtual bool ScalarAdd(
         const ReadView lhs,
         const ReadView rhs,
@@ -35,6 +35,8 @@ namespace zeromq
 class Message
 {
 public:
+    using FrameCleanup = void (*)(void* data, void* hint);
+
     OPENTXS_EXPORT static Pimpl<Message> Factory();
 
     OPENTXS_EXPORT virtual const Frame& at(const std::size_t index) const = 0;
@@ -54,6 +56,7 @@ public:
 
     OPENTXS_EXPORT virtual Frame& AddFrame() = 0;
     OPENTXS_EXPORT virtual Frame& AddFrame(const ProtobufType& input) = 0;
+    OPENTXS_EXPORT virtual Frame& AddFrame(const Frame& input) = 0;
 #ifndef SWIG
     template <
         typename Input,
@@ -83,6 +86,16 @@ public:
     OPENTXS_EXPORT virtual Frame& AddFrame(
         const void* input,
         const std::size_t size) = 0;
+    /** Adopt an existing buffer without copying
+     *
+     *  cleanup(input, hint) is called when the last frame referencing the
+     *  buffer is destroyed, which may happen on any thread.
+     */
+    OPENTXS_EXPORT virtual Frame& AddFrame(
+        void* input,
+        const std::size_t size,
+        FrameCleanup cleanup,
+        void* hint) = 0;
     OPENTXS_EXPORT virtual Frame& at(const std::size_t index) = 0;
 
     OPENTXS_EXPORT virtual void EnsureDelimiter() = 0;
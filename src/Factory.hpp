@@ -210,6 +210,10 @@ public:
         const blockchain::block::Hash& hash,
         const blockchain::block::Hash& parent,
         const blockchain::block::Height height);
+    static blockchain::block::bitcoin::internal::Header* BitcoinBlockHeader(
+        const api::internal::Core& api,
+        const blockchain::block::Hash& hash,
+        const blockchain::block::internal::FlatHeaderView& record);
     static blockchain::p2p::bitcoin::message::internal::Addr* BitcoinP2PAddr(
         const api::internal::Core& api,
         std::unique_ptr<blockchain::p2p::bitcoin::Header> pHeader,
@@ -634,7 +638,7 @@ public:
         const proto::HDAccount& serialized,
         Identifier& id);
 #if OT_BLOCKCHAIN
-    static auto BlockchainAddress(
+    OPENTXS_EXPORT static auto BlockchainAddress(
         const api::internal::Core& api,
         const blockchain::p2p::Protocol protocol,
         const blockchain::p2p::Network network,
@@ -658,6 +662,7 @@ public:
         const api::internal::Core& api,
         const blockchain::client::internal::Network& network,
         const blockchain::client::internal::FilterDatabase& database,
+        const blockchain::client::internal::IO& io,
         const blockchain::Type type,
         const std::string& shutdown) noexcept
         -> std::unique_ptr<blockchain::client::internal::FilterOracle>;
@@ -676,6 +681,17 @@ public:
         const std::string& seednode,
         const std::string& shutdown) noexcept
         -> std::unique_ptr<blockchain::client::internal::PeerManager>;
+    OPENTXS_EXPORT static auto BlockchainSnapshot(
+        const std::string& path) noexcept
+        -> std::unique_ptr<blockchain::client::internal::Snapshot>;
+    OPENTXS_EXPORT static auto BlockedBloomFilter(
+        const api::internal::Core& api,
+        const std::uint32_t tweak,
+        const std::size_t targets,
+        const double falsePositiveRate) -> blockchain::BloomFilter*;
+    OPENTXS_EXPORT static auto BlockedBloomFilter(
+        const api::internal::Core& api,
+        const Data& serialized) -> blockchain::BloomFilter*;
     OPENTXS_EXPORT static auto BloomFilter(
         const api::internal::Core& api,
         const std::uint32_t tweak,
@@ -1664,6 +1680,8 @@ public:
         -> blockchain::Work*;
     OPENTXS_EXPORT static auto Work(const blockchain::NumericHash& target)
         -> blockchain::Work*;
+    OPENTXS_EXPORT static auto WorkBigEndian(const ReadView bytes)
+        -> blockchain::Work*;
 #endif  // OT_BLOCKCHAIN
     static api::client::Workflow* Workflow(
         const api::internal::Core& api,
@@ -1678,6 +1696,11 @@ public:
     OPENTXS_EXPORT static auto ZMQFrame(
         const void* data,
         const std::size_t size) -> network::zeromq::Frame*;
+    OPENTXS_EXPORT static auto ZMQFrame(
+        void* data,
+        const std::size_t size,
+        void (*cleanup)(void*, void*),
+        void* hint) -> network::zeromq::Frame*;
     OPENTXS_EXPORT static auto ZMQFrame(const ProtobufType& data)
         -> network::zeromq::Frame*;
     OPENTXS_EXPORT static auto ZMQMessage() -> network::zeromq::Message*;
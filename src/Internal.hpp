@@ -181,6 +181,13 @@ namespace internal
 struct Header;
 }  // namespace internal
 }  // namespace bitcoin
+
+namespace internal
+{
+struct FlatHeader;
+
+class FlatHeaderView;
+}  // namespace internal
 }  // namespace block
 
 namespace client
@@ -195,6 +202,7 @@ struct IO;
 struct Network;
 struct PeerDatabase;
 struct PeerManager;
+struct Snapshot;
 struct Wallet;
 }  // namespace internal
 
@@ -28,6 +28,10 @@ public:
         const PasswordPrompt& reason) noexcept;
 
     const crypto::Asymmetric& Asymmetric() const final { return asymmetric_; }
+    const api::internal::BoxCache* Boxes() const noexcept override
+    {
+        return nullptr;
+    }
     const api::Settings& Config() const final { return config_; }
     const api::Crypto& Crypto() const final { return crypto_; }
     const std::string& DataFolder() const final { return data_folder_; }
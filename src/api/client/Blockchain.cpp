@@ -29,7 +29,12 @@
 #include "opentxs/crypto/Bip32.hpp"
 #if OT_BLOCKCHAIN
 #include "opentxs/network/zeromq/socket/Publish.hpp"
+#include "opentxs/network/zeromq/socket/Subscribe.hpp"
 #include "opentxs/network/zeromq/Context.hpp"
+#include "opentxs/network/zeromq/Frame.hpp"
+#include "opentxs/network/zeromq/FrameSection.hpp"
+#include "opentxs/network/zeromq/ListenCallback.hpp"
+#include "opentxs/network/zeromq/Message.hpp"
 #endif  // OT_BLOCKCHAIN
 
 #if OT_BLOCKCHAIN
@@ -43,6 +48,7 @@
 
 #include <map>
 #include <mutex>
+#include <optional>
 #include <set>
 
 #include "Blockchain.hpp"
@@ -114,6 +120,9 @@ Blockchain::Blockchain(
     , io_(api)
     , db_(api, legacy, dataFolder)
     , reorg_(api_.ZeroMQ().PublishSocket())
+    , reorg_callback_(opentxs::network::zeromq::ListenCallback::Factory(
+          [this](const auto& in) -> void { process_reorg(in); }))
+    , reorg_listener_(api_.ZeroMQ().SubscribeSocket(reorg_callback_))
     , networks_()
 #endif  // OT_BLOCKCHAIN
 {
@@ -122,6 +131,10 @@ Blockchain::Blockchain(
     auto listen = reorg_->Start(api_.Endpoints().BlockchainReorg());
 
     OT_ASSERT(listen);
+
+    listen = reorg_listener_->Start(api_.Endpoints().BlockchainReorg());
+
+    OT_ASSERT(listen);
 #endif  // OT_BLOCKCHAIN
 }
 
@@ -226,6 +239,30 @@ std::vector<Blockchain::Txo::Status> Blockchain::Txo::Lookup(
     const Data& element) const noexcept
 {
     Lock lock(lock_);
+
+    return lookup(lock, nym, element);
+}
+
+std::vector<std::vector<Blockchain::Txo::Status>> Blockchain::Txo::Lookup(
+    const identifier::Nym& nym,
+    const std::vector<OTData>& elements) const noexcept
+{
+    Lock lock(lock_);
+    auto output = std::vector<std::vector<Status>>{};
+    output.reserve(elements.size());
+
+    for (const auto& element : elements) {
+        output.emplace_back(lookup(lock, nym, element));
+    }
+
+    return output;
+}
+
+std::vector<Blockchain::Txo::Status> Blockchain::Txo::lookup(
+    const Lock& lock,
+    const identifier::Nym& nym,
+    const Data& element) const noexcept
+{
     auto output = std::vector<Status>{};
     const auto& storage = parent_.API().Storage();
     const auto transactions = storage.LookupElement(nym, element);
@@ -850,6 +887,21 @@ Blockchain::ParsedTransaction Blockchain::parse_transaction(
                 blockchain::Activity{coin, key, txout.value()});
         } else {
             const auto& external = txout.external();
+            const auto owned = [&]() -> std::optional<blockchain::Key> {
+                for (const auto& bytes : external.data()) {
+                    auto key = tree.LookupElement(bytes);
+
+                    if (key) { return key; }
+                }
+
+                return std::nullopt;
+            }();
+
+            // Owned outputs still go through the contact and txo path below
+            if (owned) {
+                unspent.emplace_back(
+                    blockchain::Activity{coin, owned.value(), txout.value()});
+            }
 
             switch (external.type()) {
                 case proto::BTOUTPUT_P2PK:
@@ -898,6 +950,24 @@ Blockchain::ParsedTransaction Blockchain::parse_transaction(
     return output;
 }
 
+#if OT_BLOCKCHAIN
+void Blockchain::process_reorg(
+    const opentxs::network::zeromq::Message& in) const noexcept
+{
+    const auto body = in.Body();
+
+    if (3 > body.size()) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid message").Flush();
+
+        return;
+    }
+
+    const auto chain = body.at(0).as<Chain>();
+    const auto parent = body.at(2).as<opentxs::blockchain::block::Height>();
+    balance_lists_.Get(chain).Reorg(parent);
+}
+#endif  // OT_BLOCKCHAIN
+
 OTData Blockchain::PubkeyHash(
     [[maybe_unused]] const Chain chain,
     const Data& pubkey) const noexcept(false)
@@ -994,8 +1064,8 @@ bool Blockchain::StoreTransaction(
     const auto& tree = balance_lists_.Get(chain).Nym(nymID);
     const auto parsed = parse_transaction(nymID, transaction, tree, contacts);
     const auto& [unspent, spent] = parsed;
-    const auto associated =
-        tree.AssociateTransaction(unspent, spent, contacts, reason);
+    const auto associated = tree.AssociateTransaction(
+        transaction.txid(), unspent, spent, contacts, reason);
 
     if (false == associated) {
         LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid transaction.").Flush();
@@ -1090,6 +1160,7 @@ bool Blockchain::validate_nym(const identifier::Nym& nymID) const noexcept
 Blockchain::~Blockchain()
 {
 #if OT_BLOCKCHAIN
+    reorg_listener_->Close();
     LogVerbose("Shutting down ")(networks_.size())(" blockchain clients")
         .Flush();
     for (auto& [chain, network] : networks_) { network->Shutdown().get(); }
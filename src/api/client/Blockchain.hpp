@@ -144,12 +144,20 @@ private:
         std::vector<Status> Lookup(
             const identifier::Nym& nym,
             const Data& element) const noexcept final;
+        std::vector<std::vector<Status>> Lookup(
+            const identifier::Nym& nym,
+            const std::vector<OTData>& elements) const noexcept final;
 
         Txo(api::client::internal::Blockchain& parent);
 
     private:
         api::client::internal::Blockchain& parent_;
         mutable std::mutex lock_;
+
+        std::vector<Status> lookup(
+            const Lock& lock,
+            const identifier::Nym& nym,
+            const Data& element) const noexcept;
     };
 
     static const AddressMap address_prefix_map_;
@@ -168,6 +176,8 @@ private:
     opentxs::blockchain::client::internal::IO io_;
     blockchain::database::implementation::Database db_;
     OTZMQPublishSocket reorg_;
+    OTZMQListenCallback reorg_callback_;
+    OTZMQSubscribeSocket reorg_listener_;
     mutable std::map<
         Chain,
         std::unique_ptr<opentxs::blockchain::client::internal::Network>>
@@ -203,6 +213,10 @@ private:
         std::set<OTIdentifier>& contacts) const noexcept;
     std::string p2pkh(const Chain chain, const Data& pubkeyHash) const noexcept;
     std::string p2sh(const Chain chain, const Data& scriptHash) const noexcept;
+#if OT_BLOCKCHAIN
+    void process_reorg(
+        const opentxs::network::zeromq::Message& in) const noexcept;
+#endif  // OT_BLOCKCHAIN
     bool update_transactions(
         const Lock& lock,
         const identifier::Nym& nym,
@@ -0,0 +1,165 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "stdafx.hpp"
+
+#include "Internal.hpp"
+
+#include "opentxs/blockchain/Blockchain.hpp"
+
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+
+#include "BalanceLedger.hpp"
+
+namespace opentxs::api::client::blockchain::implementation
+{
+BalanceLedger::BalanceLedger() noexcept
+    : lock_()
+    , unconfirmed_()
+    , blocks_()
+    , confirmed_()
+    , balance_lock_()
+    , total_()
+    , accounts_()
+{
+}
+
+void BalanceLedger::accumulate(
+    const Deltas& deltas,
+    const Amount confirmed,
+    const Amount unconfirmed,
+    Changes& changes) noexcept
+{
+    for (const auto& [account, amount] : deltas) {
+        auto& [confirmedChange, unconfirmedChange] = changes[account];
+        confirmedChange += confirmed * amount;
+        unconfirmedChange += unconfirmed * amount;
+    }
+}
+
+void BalanceLedger::Add(const std::string& txid, const Deltas& deltas) noexcept
+{
+    if (deltas.empty()) { return; }
+
+    auto changes = Changes{};
+    Lock lock(lock_);
+    const auto it = confirmed_.find(txid);
+    const auto confirmed = (confirmed_.end() != it);
+    auto& existing =
+        confirmed ? blocks_[it->second][txid] : unconfirmed_[txid];
+    auto difference = deltas;
+
+    for (const auto& [account, amount] : existing) {
+        difference[account] -= amount;
+    }
+
+    existing = deltas;
+
+    if (confirmed) {
+        accumulate(difference, 1, 0, changes);
+    } else {
+        accumulate(difference, 0, 1, changes);
+    }
+
+    apply(changes);
+}
+
+void BalanceLedger::apply(const Changes& changes) noexcept
+{
+    eLock lock(balance_lock_);
+
+    for (const auto& [account, change] : changes) {
+        auto& balance = accounts_[account];
+        balance.first += change.first;
+        balance.second += change.second;
+        total_.first += change.first;
+        total_.second += change.second;
+    }
+}
+
+bool BalanceLedger::Confirm(
+    const std::string& txid,
+    const Height height) noexcept
+{
+    Lock lock(lock_);
+    auto it = confirmed_.find(txid);
+
+    if (confirmed_.end() != it) {
+        const auto previous = it->second;
+
+        if (height == previous) { return true; }
+
+        // Moving a transaction between blocks does not change any balance
+        auto& from = blocks_.at(previous);
+        blocks_[height].insert(from.extract(txid));
+
+        if (from.empty()) { blocks_.erase(previous); }
+
+        it->second = height;
+
+        return true;
+    }
+
+    auto transaction = unconfirmed_.extract(txid);
+
+    if (transaction.empty()) { return false; }
+
+    auto changes = Changes{};
+    accumulate(transaction.mapped(), 1, -1, changes);
+    blocks_[height].insert(std::move(transaction));
+    confirmed_.emplace(txid, height);
+    apply(changes);
+
+    return true;
+}
+
+BalanceLedger::Balance BalanceLedger::Get() const noexcept
+{
+    sLock lock(balance_lock_);
+
+    return total_;
+}
+
+BalanceLedger::Balance BalanceLedger::Get(const std::string& account) const
+    noexcept
+{
+    sLock lock(balance_lock_);
+
+    try {
+
+        return accounts_.at(account);
+    } catch (...) {
+
+        return {};
+    }
+}
+
+void BalanceLedger::merge(const Deltas& from, Deltas& to) noexcept
+{
+    for (const auto& [account, amount] : from) { to[account] += amount; }
+}
+
+void BalanceLedger::Reorg(const Height parent) noexcept
+{
+    Lock lock(lock_);
+    auto changes = Changes{};
+    const auto first = blocks_.upper_bound(parent);
+
+    for (auto block = first; block != blocks_.end(); ++block) {
+        for (const auto& [txid, deltas] : block->second) {
+            accumulate(deltas, -1, 1, changes);
+            merge(deltas, unconfirmed_[txid]);
+            confirmed_.erase(txid);
+        }
+    }
+
+    blocks_.erase(first, blocks_.end());
+    apply(changes);
+}
+}  // namespace opentxs::api::client::blockchain::implementation
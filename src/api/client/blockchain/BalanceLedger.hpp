@@ -0,0 +1,71 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+namespace opentxs::api::client::blockchain::implementation
+{
+/** Running confirmed and unconfirmed balances for a set of subaccounts
+ *
+ *  Every transaction is recorded as a set of per subaccount deltas, either
+ *  as unconfirmed or under the height of the block which confirmed it.
+ *  Totals are maintained incrementally, so a balance query never walks the
+ *  history and a reorg only visits the blocks it disconnects. Each update
+ *  is prepared before the totals are locked, so queries only wait for the
+ *  net change to be applied.
+ */
+class BalanceLedger
+{
+public:
+    using Balance = std::pair<Amount, Amount>;  // confirmed, unconfirmed
+    using Deltas = std::map<std::string, Amount>;
+    using Height = opentxs::blockchain::block::Height;
+
+    OPENTXS_EXPORT Balance Get() const noexcept;
+    OPENTXS_EXPORT Balance Get(const std::string& account) const noexcept;
+
+    /// Sets the complete per subaccount deltas of a transaction
+    ///
+    /// Only the difference from any previously recorded deltas is applied
+    /// to the totals, so adding the same transaction again has no effect.
+    OPENTXS_EXPORT void Add(
+        const std::string& txid,
+        const Deltas& deltas) noexcept;
+    /// Moves a transaction to the block at the specified height
+    OPENTXS_EXPORT bool Confirm(
+        const std::string& txid,
+        const Height height) noexcept;
+    /// Returns every transaction above the parent height to unconfirmed
+    OPENTXS_EXPORT void Reorg(const Height parent) noexcept;
+
+    OPENTXS_EXPORT BalanceLedger() noexcept;
+
+private:
+    using Changes = std::map<std::string, Balance>;
+    using Transactions = std::map<std::string, Deltas>;
+
+    mutable std::mutex lock_;
+    Transactions unconfirmed_;
+    std::map<Height, Transactions> blocks_;
+    std::map<std::string, Height> confirmed_;
+    mutable std::shared_mutex balance_lock_;
+    Balance total_;
+    std::map<std::string, Balance> accounts_;
+
+    static void accumulate(
+        const Deltas& deltas,
+        const Amount confirmed,
+        const Amount unconfirmed,
+        Changes& changes) noexcept;
+    static void merge(const Deltas& from, Deltas& to) noexcept;
+
+    void apply(const Changes& changes) noexcept;
+
+    BalanceLedger(const BalanceLedger&) = delete;
+    BalanceLedger(BalanceLedger&&) = delete;
+    BalanceLedger& operator=(const BalanceLedger&) = delete;
+    BalanceLedger& operator=(BalanceLedger&&) = delete;
+};
+}  // namespace opentxs::api::client::blockchain::implementation
@@ -147,4 +147,12 @@ internal::BalanceTree& BalanceList::Nym(const identifier::Nym& id) noexcept
 
     return get_or_create(lock, id);
 }
+
+void BalanceList::Reorg(
+    const opentxs::blockchain::block::Height parent) noexcept
+{
+    Lock lock(lock_);
+
+    for (const auto& tree : trees_) { tree->Reorg(parent); }
+}
 }  // namespace opentxs::api::client::blockchain::implementation
@@ -41,6 +41,7 @@ public:
         const proto::HDPath& path,
         Identifier& id) noexcept final;
     internal::BalanceTree& Nym(const identifier::Nym& id) noexcept final;
+    void Reorg(const opentxs::blockchain::block::Height parent) noexcept final;
 
     ~BalanceList() final = default;
 
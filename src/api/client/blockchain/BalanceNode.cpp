@@ -46,7 +46,8 @@ BalanceNode::Element::Element(
     const Bip32Index index,
     const std::string label,
     const OTIdentifier contact,
-    std::unique_ptr<opentxs::crypto::key::EllipticCurve> key) noexcept(false)
+    std::unique_ptr<opentxs::crypto::key::EllipticCurve> key,
+    const std::optional<ReadView> pubkeyHash) noexcept(false)
     : parent_(parent)
     , api_(api)
     , chain_(chain)
@@ -58,6 +59,11 @@ BalanceNode::Element::Element(
     , contact_(contact)
     , pkey_(key->asPublicEC())
     , key_(*pkey_)
+    , pubkey_hash_(
+          pubkeyHash.has_value()
+              ? api_.API().Factory().Data(pubkeyHash.value())
+              : api_.PubkeyHash(
+                    chain_, api_.API().Factory().Data(key_.PublicKey())))
 {
     if (false == bool(key_)) { throw std::runtime_error("No key provided"); }
 }
@@ -78,7 +84,30 @@ BalanceNode::Element::Element(
           index,
           "",
           Identifier::Factory(),
-          std::move(key))
+          std::move(key),
+          std::nullopt)
+{
+}
+
+BalanceNode::Element::Element(
+    const internal::BalanceNode& parent,
+    const client::internal::Blockchain& api,
+    const opentxs::blockchain::Type chain,
+    const Subchain subchain,
+    const Bip32Index index,
+    std::unique_ptr<opentxs::crypto::key::HD> key,
+    const ReadView pubkeyHash) noexcept(false)
+    : Element(
+          parent,
+          api,
+          chain,
+          DefaultVersion,
+          subchain,
+          index,
+          "",
+          Identifier::Factory(),
+          std::move(key),
+          pubkeyHash)
 {
 }
 
@@ -97,7 +126,8 @@ BalanceNode::Element::Element(
           address.index(),
           address.label(),
           Identifier::Factory(address.contact()),
-          instantiate(api.API(), address.key()))
+          instantiate(api.API(), address.key()),
+          std::nullopt)
 {
 }
 
@@ -117,17 +147,7 @@ OTIdentifier BalanceNode::Element::Contact() const noexcept
 
 std::set<OTData> BalanceNode::Element::Elements() const noexcept
 {
-    auto output = std::set<OTData>{};
-    Lock lock(lock_);
-    auto pubkey = api_.API().Factory().Data(key_.PublicKey());
-
-    try {
-        output.emplace(api_.PubkeyHash(chain_, pubkey));
-    } catch (...) {
-        OT_FAIL;
-    }
-
-    return output;
+    return {pubkey_hash_};
 }
 
 std::set<std::string> BalanceNode::Element::IncomingTransactions() const
@@ -169,9 +189,7 @@ std::string BalanceNode::Element::Label() const noexcept
 
 OTData BalanceNode::Element::PubkeyHash() const noexcept
 {
-    const auto key = api_.API().Factory().Data(key_.PublicKey());
-
-    return api_.PubkeyHash(chain_, key);
+    return pubkey_hash_;
 }
 
 BalanceNode::Element::SerializedType BalanceNode::Element::Serialize() const
@@ -236,25 +254,36 @@ bool BalanceNode::AssociateTransaction(
     return save(lock);
 }
 
-void BalanceNode::claim_element(
+void BalanceNode::claim_elements(
     const Lock& lock,
-    const Data& element,
-    const blockchain::Key key) const noexcept
+    const std::vector<std::pair<OTData, blockchain::Key>>& elements)
+    const noexcept
 {
     const auto& db = parent_.Parent().Parent().DB();
     const auto& nymID = parent_.NymID();
-    const auto status = db.Lookup(nymID, element);
+    auto query = std::vector<OTData>{};
+    query.reserve(elements.size());
 
-    for (const auto& txo : status) {
-        const auto [coin, spent] = txo;
+    for (const auto& [element, key] : elements) { query.emplace_back(element); }
 
-        if (spent) {
-            process_spent(lock, coin, key, 0);
-        } else {
-            process_unspent(lock, coin, key, 0);
-        }
+    const auto status = db.Lookup(nymID, query);
+
+    OT_ASSERT(status.size() == elements.size());
 
-        db.Claim(nymID, coin);
+    for (std::size_t i{0}; i < elements.size(); ++i) {
+        const auto& key = elements.at(i).second;
+
+        for (const auto& txo : status.at(i)) {
+            const auto [coin, spent] = txo;
+
+            if (spent) {
+                process_spent(lock, coin, key, 0);
+            } else {
+                process_unspent(lock, coin, key, 0);
+            }
+
+            db.Claim(nymID, coin);
+        }
     }
 }
 
@@ -12,6 +12,9 @@
 #include "internal/api/client/blockchain/Blockchain.hpp"
 
 #include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
 
 namespace opentxs::api::client::blockchain::implementation
 {
@@ -71,6 +74,15 @@ protected:
             const Subchain subchain,
             const Bip32Index index,
             std::unique_ptr<opentxs::crypto::key::HD> key) noexcept(false);
+        /// pubkeyHash must be the hash160 of the key
+        Element(
+            const internal::BalanceNode& parent,
+            const client::internal::Blockchain& api,
+            const opentxs::blockchain::Type chain,
+            const Subchain subchain,
+            const Bip32Index index,
+            std::unique_ptr<opentxs::crypto::key::HD> key,
+            const ReadView pubkeyHash) noexcept(false);
         Element(
             const internal::BalanceNode& parent,
             const client::internal::Blockchain& api,
@@ -93,6 +105,7 @@ protected:
         OTIdentifier contact_;
         std::shared_ptr<opentxs::crypto::key::EllipticCurve> pkey_;
         opentxs::crypto::key::EllipticCurve& key_;
+        const OTData pubkey_hash_;
 
         static std::unique_ptr<opentxs::crypto::key::EllipticCurve> instantiate(
             const api::internal::Core& api,
@@ -107,8 +120,8 @@ protected:
             const Bip32Index index,
             const std::string label,
             const OTIdentifier contact,
-            std::unique_ptr<opentxs::crypto::key::EllipticCurve>
-                key) noexcept(false);
+            std::unique_ptr<opentxs::crypto::key::EllipticCurve> key,
+            const std::optional<ReadView> pubkeyHash) noexcept(false);
         Element() = delete;
     };
 
@@ -126,10 +139,10 @@ protected:
     static internal::ActivityMap convert(
         const std::vector<Activity>& in) noexcept;
 
-    void claim_element(
+    void claim_elements(
         const Lock& lock,
-        const Data& element,
-        const blockchain::Key key) const noexcept;
+        const std::vector<std::pair<OTData, blockchain::Key>>& elements)
+        const noexcept;
     void process_spent(
         const Lock& lock,
         const Coin& coin,
@@ -16,6 +16,11 @@
 #include "internal/api/client/blockchain/Blockchain.hpp"
 #include "internal/api/Api.hpp"
 
+#include <cstring>
+
+#include "BalanceLedger.hpp"
+#include "HashIndex.hpp"
+
 #include "BalanceTree.tpp"
 
 #define OT_METHOD                                                              \
@@ -50,9 +55,12 @@ BalanceTree::BalanceTree(
     , imported_(*this)
     , payment_code_(*this)
     , node_index_()
+    , elements_()
+    , outpoints_()
     , lock_()
     , unspent_()
     , spent_()
+    , ledger_()
 {
     init(accounts);
 }
@@ -82,6 +90,7 @@ internal::BalanceNode* BalanceTree::NodeIndex::Find(const std::string& id) const
 }
 
 bool BalanceTree::AssociateTransaction(
+    const std::string& txid,
     const std::vector<Activity>& unspent,
     const std::vector<Activity>& spent,
     std::set<OTIdentifier>& contacts,
@@ -115,6 +124,9 @@ bool BalanceTree::AssociateTransaction(
         sorted[account].second.emplace_back(Activity{coin, key, amount});
     }
 
+    auto deltas = BalanceLedger::Deltas{};
+    auto output{true};
+
     for (const auto& [accountID, value] : sorted) {
         auto* pNode = node_index_.Find(accountID);
 
@@ -132,10 +144,14 @@ bool BalanceTree::AssociateTransaction(
 
         if (accepted) {
             for (const auto& [coin, key, amount] : value.first) {
-                unspent_.emplace(
+                const auto [it, added] = unspent_.emplace(
                     std::piecewise_construct,
                     std::forward_as_tuple(coin),
                     std::forward_as_tuple(key, amount));
+
+                if (added) { outpoints_.Add(outpoint(coin), it->second); }
+
+                deltas[accountID] += amount;
             }
 
             for (const auto& [coin, key, amount] : value.second) {
@@ -143,17 +159,23 @@ bool BalanceTree::AssociateTransaction(
                     std::piecewise_construct,
                     std::forward_as_tuple(coin),
                     std::forward_as_tuple(key, amount));
+                deltas[accountID] -= amount;
             }
         } else {
             LogOutput(OT_METHOD)(__FUNCTION__)(
                 ": Failed processing transaction")
                 .Flush();
+            output = false;
 
-            return false;
+            break;
         }
     }
 
-    return true;
+    // The ledger replaces any deltas previously recorded for this txid, so
+    // storing the same transaction again does not change any balance
+    ledger_.Add(txid, deltas);
+
+    return output;
 }
 
 void BalanceTree::ClaimAccountID(
@@ -163,6 +185,14 @@ void BalanceTree::ClaimAccountID(
     node_index_.Add(id, node);
 }
 
+void BalanceTree::IndexElements(
+    const std::vector<std::pair<OTData, Key>>& elements) const noexcept
+{
+    for (const auto& [element, key] : elements) {
+        elements_.Add(element->Bytes(), key);
+    }
+}
+
 void BalanceTree::init(const std::set<OTIdentifier>& accounts) noexcept
 {
     for (const auto& accountID : accounts) {
@@ -180,18 +210,16 @@ void BalanceTree::init(const std::set<OTIdentifier>& accounts) noexcept
     }
 }
 
+std::optional<Key> BalanceTree::LookupElement(const ReadView element) const
+    noexcept
+{
+    return elements_.Find(element);
+}
+
 std::optional<std::pair<Key, Amount>> BalanceTree::LookupUTXO(
     const Coin& coin) const noexcept
 {
-    Lock lock(lock_);
-
-    try {
-
-        return unspent_.at(coin);
-    } catch (...) {
-
-        return {};
-    }
+    return outpoints_.Find(outpoint(coin));
 }
 
 internal::BalanceNode& BalanceTree::Node(const Identifier& id) const
@@ -203,4 +231,14 @@ internal::BalanceNode& BalanceTree::Node(const Identifier& id) const
 
     return *output;
 }
+
+std::string BalanceTree::outpoint(const Coin& coin) noexcept
+{
+    const auto& [txid, index] = coin;
+    auto output = std::string(txid.size() + sizeof(index), '\0');
+    std::memcpy(output.data(), txid.data(), txid.size());
+    std::memcpy(std::next(output.data(), txid.size()), &index, sizeof(index));
+
+    return output;
+}
 }  // namespace opentxs::api::client::blockchain::implementation
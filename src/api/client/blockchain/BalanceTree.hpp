@@ -12,6 +12,7 @@ class BalanceTree final : public internal::BalanceTree
 public:
     const api::internal::Core& API() const noexcept { return api_; }
     bool AssociateTransaction(
+        const std::string& txid,
         const std::vector<Activity>& unspent,
         const std::vector<Activity>& spent,
         std::set<OTIdentifier>& contacts,
@@ -19,6 +20,17 @@ public:
     opentxs::blockchain::Type Chain() const noexcept final { return chain_; }
     void ClaimAccountID(const std::string& id, internal::BalanceNode* node)
         const noexcept final;
+    bool ConfirmTransaction(
+        const std::string& txid,
+        const opentxs::blockchain::block::Height height) const noexcept final
+    {
+        return ledger_.Confirm(txid, height);
+    }
+    Balance GetBalance() const noexcept final { return ledger_.Get(); }
+    Balance GetBalance(const Identifier& account) const noexcept final
+    {
+        return ledger_.Get(account.str());
+    }
     const HDAccounts& GetHD() const noexcept final { return hd_; }
     const ImportedAccounts& GetImported() const noexcept final
     {
@@ -33,6 +45,10 @@ public:
     {
         return hd_.at(account);
     }
+    void IndexElements(const std::vector<std::pair<OTData, Key>>& elements)
+        const noexcept final;
+    std::optional<Key> LookupElement(const ReadView element) const
+        noexcept final;
     std::optional<std::pair<Key, Amount>> LookupUTXO(const Coin& coin) const
         noexcept final;
     internal::BalanceNode& Node(const Identifier& id) const
@@ -42,6 +58,11 @@ public:
     {
         return parent_;
     }
+    void Reorg(const opentxs::blockchain::block::Height parent) const
+        noexcept final
+    {
+        ledger_.Reorg(parent);
+    }
 
     bool AddHDNode(const proto::HDPath& path, Identifier& id) noexcept final
     {
@@ -186,9 +207,14 @@ private:
     ImportedNodes imported_;
     PaymentCodeNodes payment_code_;
     mutable NodeIndex node_index_;
+    mutable HashIndex<Key> elements_;
+    mutable HashIndex<std::pair<Key, Amount>> outpoints_;
     mutable std::mutex lock_;
     mutable internal::ActivityMap unspent_;
     mutable internal::ActivityMap spent_;
+    mutable BalanceLedger ledger_;
+
+    static std::string outpoint(const Coin& coin) noexcept;
 
     void init(const std::set<OTIdentifier>& HDAccounts) noexcept;
 
@@ -64,7 +64,10 @@ void Deterministic::check_lookahead(
     const Subchain type,
     const PasswordPrompt& reason) const noexcept(false)
 {
-    while (need_lookahead(lock, type)) { generate_next(lock, type, reason); }
+    if (false == need_lookahead(lock, type)) { return; }
+
+    const auto available = generated_.at(type) - used_.at(type);
+    generate(lock, type, Lookahead - available, reason);
 }
 
 std::optional<Bip32Index> Deterministic::GenerateNext(
@@ -90,6 +93,17 @@ std::optional<Bip32Index> Deterministic::GenerateNext(
         return {};
     }
 }
+
+Bip32Index Deterministic::generate_next(
+    const Lock& lock,
+    const Subchain type,
+    const PasswordPrompt& reason) const noexcept(false)
+{
+    const auto output = generated_.at(type);
+    generate(lock, type, 1, reason);
+
+    return output;
+}
 #endif  // OT_CRYPTO_WITH_BIP32
 
 #if OT_CRYPTO_WITH_BIP32
@@ -75,6 +75,10 @@ protected:
         const Lock& lock,
         const Subchain type,
         const PasswordPrompt& reason) const noexcept(false);
+    Bip32Index generate_next(
+        const Lock& lock,
+        const Subchain type,
+        const PasswordPrompt& reason) const noexcept(false);
     bool need_lookahead(const Lock& lock, const Subchain type) const noexcept;
     std::optional<Bip32Index> use_next(
         const Lock& lock,
@@ -100,9 +104,11 @@ private:
         const Subchain type,
         IndexMap map) const noexcept;
 #if OT_CRYPTO_WITH_BIP32
-    virtual Bip32Index generate_next(
+    // Append count consecutive keys to the subchain
+    virtual void generate(
         const Lock& lock,
         const Subchain type,
+        const Bip32Index count,
         const PasswordPrompt& reason) const noexcept(false) = 0;
 #endif  // OT_CRYPTO_WITH_BIP32
     virtual void set_metadata(
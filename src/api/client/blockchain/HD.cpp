@@ -7,20 +7,33 @@
 
 #include "Internal.hpp"
 
+#include "opentxs/api/crypto/Asymmetric.hpp"
+#include "opentxs/api/crypto/Crypto.hpp"
+#include "opentxs/api/crypto/Hash.hpp"
 #include "opentxs/api/storage/Storage.hpp"
 #include "opentxs/api/Core.hpp"
 #include "opentxs/api/Factory.hpp"
 #include "opentxs/api/HDSeed.hpp"
+#include "opentxs/api/Settings.hpp"
+#include "opentxs/core/crypto/OTPassword.hpp"
 #include "opentxs/core/identifier/Nym.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/PasswordPrompt.hpp"
+#include "opentxs/core/String.hpp"
+#include "opentxs/crypto/key/HD.hpp"
+#include "opentxs/crypto/Bip32.hpp"
 
 #include "api/client/blockchain/Deterministic.hpp"
 #include "internal/api/Api.hpp"
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <future>
 #include <map>
 #include <set>
+#include <thread>
+#include <vector>
 
 #include "HD.hpp"
 
@@ -85,6 +98,10 @@ HD::HD(
     , revision_(0)
     , internal_addresses_()
     , external_addresses_()
+#if OT_CRYPTO_WITH_BIP32
+    , node_lifetime_(node_lifetime(api_))
+    , nodes_()
+#endif  // OT_CRYPTO_WITH_BIP32
 {
     id.Assign(id_);
     Lock lock(lock_);
@@ -129,12 +146,18 @@ HD::HD(
           extract_internal(*this, parent.Parent().Parent(), chain_, serialized))
     , external_addresses_(
           extract_external(*this, parent.Parent().Parent(), chain_, serialized))
+#if OT_CRYPTO_WITH_BIP32
+    , node_lifetime_(node_lifetime(api_))
+    , nodes_()
+#endif  // OT_CRYPTO_WITH_BIP32
 {
     id.Assign(id_);
 
     if (Translate(serialized.type()) != chain_) {
         throw std::runtime_error("Wrong account type");
     }
+
+    index_elements();
 }
 
 const HD::Element& HD::BalanceElement(
@@ -211,6 +234,73 @@ bool HD::check_activity(
     }
 }
 
+#if OT_CRYPTO_WITH_BIP32
+void HD::derive_public(
+    const opentxs::crypto::Bip32::Key& node,
+    const Bip32Index first,
+    const std::size_t count,
+    Space& keys,
+    Space& hashes) const noexcept(false)
+{
+    keys.resize(count * PubkeySize);
+    hashes.resize(count * HashSize);
+    const auto& bip32 = api_.Crypto().BIP32();
+    const auto& hash = api_.Crypto().Hash();
+    // Each range writes only to its own slice of keys and hashes
+    const auto job = [&](const std::size_t begin, const std::size_t end) {
+        auto* key = std::next(keys.data(), begin * PubkeySize);
+        auto* out = std::next(hashes.data(), begin * HashSize);
+        const auto derived = bip32.DerivePublic(
+            EcdsaCurve::secp256k1,
+            node,
+            first + static_cast<Bip32Index>(begin),
+            end - begin,
+            [key](const auto size) { return WritableView{key, size}; });
+
+        if (false == derived) { return false; }
+
+        for (auto i{begin}; i < end; ++i) {
+            const auto hashed = hash.Digest(
+                proto::HASHTYPE_BITCOIN,
+                ReadView{reinterpret_cast<const char*>(key), PubkeySize},
+                [out](const auto size) { return WritableView{out, size}; });
+
+            if (false == hashed) { return false; }
+
+            std::advance(key, PubkeySize);
+            std::advance(out, HashSize);
+        }
+
+        return true;
+    };
+    const auto threads = std::min<std::size_t>(
+        std::max(std::thread::hardware_concurrency(), 1u),
+        count / ParallelKeys);
+    auto success{true};
+
+    if (2 > threads) {
+        success = job(0, count);
+    } else {
+        const auto step = (count + threads - 1) / threads;
+        auto jobs = std::vector<std::future<bool>>{};
+
+        for (std::size_t begin{0}; begin < count; begin += step) {
+            jobs.emplace_back(std::async(
+                std::launch::async,
+                job,
+                begin,
+                std::min(count, begin + step)));
+        }
+
+        for (auto& future : jobs) { success &= future.get(); }
+    }
+
+    if (false == success) {
+        throw std::runtime_error("Failed to generate keys");
+    }
+}
+#endif  // OT_CRYPTO_WITH_BIP32
+
 HD::AddressMap HD::extract_external(
     const internal::BalanceNode& parent,
     const client::internal::Blockchain& api,
@@ -272,47 +362,58 @@ std::vector<Activity> HD::extract_outgoing(const SerializedType& in)
 }
 
 #if OT_CRYPTO_WITH_BIP32
-Bip32Index HD::generate_next(
+void HD::generate(
     const Lock& lock,
     const Subchain type,
+    const Bip32Index count,
     const PasswordPrompt& reason) const noexcept(false)
 {
     auto& index = generated_.at(type);
 
-    if (MaxIndex <= index) { throw std::runtime_error("Account is full"); }
-
-    auto pKey = api_.Seeds().AccountChildKey(
-        path_,
-        (Subchain::Internal == type) ? INTERNAL_CHAIN : EXTERNAL_CHAIN,
-        index,
-        reason);
-
-    if (false == bool(pKey)) {
-        throw std::runtime_error("Failed to generate key");
+    if ((MaxIndex <= index) || ((MaxIndex - index) < count)) {
+        throw std::runtime_error("Account is full");
     }
 
+    const auto& node = subchain_node(lock, type, reason);
+    const auto parent = opentxs::crypto::key::HD::CalculateFingerprint(
+        api_.Crypto().Hash(), std::get<2>(node)->Bytes());
+    auto keys = Space{};
+    auto hashes = Space{};
+    derive_public(node, index, count, keys, hashes);
     auto& addressMap = (Subchain::Internal == type) ? internal_addresses_
                                                     : external_addresses_;
-    const auto [it, added] = addressMap.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(index),
-        std::forward_as_tuple(
-            *this,
-            parent_.Parent().Parent(),
-            chain_,
-            type,
-            index,
-            std::move(pKey)));
-
-    if (false == added) { throw std::runtime_error("Failed to add key"); }
-
-    const auto elements = it->second.Elements();
-
-    for (const auto& element : elements) {
-        claim_element(lock, element, {id_->str(), type, index});
+    auto elements = std::vector<std::pair<OTData, blockchain::Key>>{};
+    elements.reserve(count);
+
+    for (std::size_t i{0}; i < count; ++i) {
+        const auto key = ReadView{
+            reinterpret_cast<const char*>(keys.data()) + (i * PubkeySize),
+            PubkeySize};
+        const auto hash = ReadView{
+            reinterpret_cast<const char*>(hashes.data()) + (i * HashSize),
+            HashSize};
+        const auto [it, added] = addressMap.emplace(
+            std::piecewise_construct,
+            std::forward_as_tuple(index),
+            std::forward_as_tuple(
+                *this,
+                parent_.Parent().Parent(),
+                chain_,
+                type,
+                index,
+                public_key(parent, key),
+                hash));
+
+        if (false == added) { throw std::runtime_error("Failed to add key"); }
+
+        elements.emplace_back(
+            api_.Factory().Data(hash),
+            blockchain::Key{id_->str(), type, index});
+        ++index;
     }
 
-    return index++;
+    parent_.IndexElements(elements);
+    claim_elements(lock, elements);
 }
 #endif  // OT_CRYPTO_WITH_BIP32
 
@@ -338,6 +439,26 @@ ECKey HD::Key(const Subchain type, const Bip32Index index) const noexcept
     }
 }
 
+void HD::index_elements() const noexcept
+{
+    auto elements = std::vector<std::pair<OTData, blockchain::Key>>{};
+    elements.reserve(internal_addresses_.size() + external_addresses_.size());
+
+    for (const auto& [index, element] : internal_addresses_) {
+        elements.emplace_back(
+            element.PubkeyHash(),
+            blockchain::Key{id_->str(), Subchain::Internal, index});
+    }
+
+    for (const auto& [index, element] : external_addresses_) {
+        elements.emplace_back(
+            element.PubkeyHash(),
+            blockchain::Key{id_->str(), Subchain::External, index});
+    }
+
+    parent_.IndexElements(elements);
+}
+
 internal::BalanceElement& HD::mutable_element(
     const Lock& lock,
     const Subchain type,
@@ -356,6 +477,42 @@ internal::BalanceElement& HD::mutable_element(
     }
 }
 
+#if OT_CRYPTO_WITH_BIP32
+std::chrono::seconds HD::node_lifetime(const api::internal::Core& api) noexcept
+{
+    bool notUsed{false};
+    std::int64_t seconds{0};
+    api.Config().CheckSet_long(
+        String::Factory("blockchain"),
+        String::Factory("hd_node_cache_seconds"),
+        DefaultNodeLifetime,
+        seconds,
+        notUsed);
+
+    return std::chrono::seconds{std::max<std::int64_t>(seconds, 0)};
+}
+
+HDKey HD::public_key(const Bip32Fingerprint parent, const ReadView pubkey) const
+    noexcept(false)
+{
+    auto serialized = proto::AsymmetricKey{};
+    serialized.set_version(
+        opentxs::crypto::key::EllipticCurve::DefaultVersion);
+    serialized.set_type(proto::AKEYTYPE_SECP256K1);
+    serialized.set_mode(proto::KEYMODE_PUBLIC);
+    serialized.set_role(proto::KEYROLE_SIGN);
+    serialized.set_key(pubkey.data(), pubkey.size());
+    serialized.set_bip32_parent(parent);
+    auto output = api_.Asymmetric().InstantiateHDKey(serialized);
+
+    if ((false == bool(output)) || (false == bool(*output))) {
+        throw std::runtime_error("Failed to instantiate key");
+    }
+
+    return output;
+}
+#endif  // OT_CRYPTO_WITH_BIP32
+
 bool HD::save(const Lock& lock) const noexcept
 {
     const auto type = Translate(chain_);
@@ -423,4 +580,55 @@ void HD::set_metadata(
     } catch (...) {
     }
 }
+
+#if OT_CRYPTO_WITH_BIP32
+// The subchain node is derived from the account key once and then reused for
+// every address in the subchain until it expires, so neither the seed nor the
+// hardened part of the path is touched while generating addresses. A lifetime
+// of zero disables the cache.
+const opentxs::crypto::Bip32::Key& HD::subchain_node(
+    const Lock& lock,
+    const Subchain type,
+    const PasswordPrompt& reason) const noexcept(false)
+{
+    const auto now = Clock::now();
+    auto it = nodes_.find(type);
+
+    if (nodes_.end() != it) {
+        if (now < it->second.second) { return it->second.first; }
+
+        nodes_.erase(it);
+    }
+
+    OT_ASSERT(key_);
+
+    const auto& account = *key_;
+    auto path = opentxs::crypto::Bip32::Path{};
+
+    for (const auto& child : path_.child()) { path.emplace_back(child); }
+
+    const auto parent = opentxs::crypto::Bip32::Key{
+        OTPassword{},
+        OTPassword{OTPassword::Mode::Mem, account.Chaincode(reason)},
+        api_.Factory().Data(account.PublicKey()),
+        path,
+        0};
+    const Bip32Index change = (Subchain::Internal == type) ? 1 : 0;
+    auto node = api_.Crypto().BIP32().DerivePublic(
+        EcdsaCurve::secp256k1, parent, {change});
+
+    if (std::get<2>(node)->empty()) {
+        throw std::runtime_error("Failed to derive subchain node");
+    }
+
+    it = nodes_
+             .emplace(
+                 std::piecewise_construct,
+                 std::forward_as_tuple(type),
+                 std::forward_as_tuple(std::move(node), now + node_lifetime_))
+             .first;
+
+    return it->second.first;
+}
+#endif  // OT_CRYPTO_WITH_BIP32
 }  // namespace opentxs::api::client::blockchain::implementation
@@ -24,13 +24,28 @@ private:
     using AddressMap = std::map<Bip32Index, Element>;
     using Revision = std::uint64_t;
     using SerializedType = proto::HDAccount;
+#if OT_CRYPTO_WITH_BIP32
+    /// Extended public key of a subchain and the time it must be discarded
+    using CachedNode = std::pair<opentxs::crypto::Bip32::Key, Time>;
+    using NodeMap = std::map<Subchain, CachedNode>;
+#endif  // OT_CRYPTO_WITH_BIP32
 
     static const VersionNumber DefaultVersion{1};
+#if OT_CRYPTO_WITH_BIP32
+    static const std::int64_t DefaultNodeLifetime{300};
+    static const std::size_t HashSize{20};
+    static const std::size_t ParallelKeys{64};
+    static const std::size_t PubkeySize{33};
+#endif  // OT_CRYPTO_WITH_BIP32
 
     VersionNumber version_;
     mutable std::atomic<Revision> revision_;
     mutable AddressMap internal_addresses_;
     mutable AddressMap external_addresses_;
+#if OT_CRYPTO_WITH_BIP32
+    const std::chrono::seconds node_lifetime_;
+    mutable NodeMap nodes_;
+#endif  // OT_CRYPTO_WITH_BIP32
 
     static AddressMap extract_external(
         const internal::BalanceNode& parent,
@@ -44,6 +59,10 @@ private:
         const opentxs::blockchain::Type chain,
         const SerializedType& in) noexcept(false);
     static std::vector<Activity> extract_outgoing(const SerializedType& in);
+#if OT_CRYPTO_WITH_BIP32
+    static std::chrono::seconds node_lifetime(
+        const api::internal::Core& api) noexcept;
+#endif  // OT_CRYPTO_WITH_BIP32
 
     bool check_activity(
         const Lock& lock,
@@ -51,15 +70,27 @@ private:
         std::set<OTIdentifier>& contacts,
         const PasswordPrompt& reason) const noexcept final;
 #if OT_CRYPTO_WITH_BIP32
-    Bip32Index generate_next(
+    void derive_public(
+        const opentxs::crypto::Bip32::Key& node,
+        const Bip32Index first,
+        const std::size_t count,
+        Space& keys,
+        Space& hashes) const noexcept(false);
+    void generate(
         const Lock& lock,
         const Subchain type,
+        const Bip32Index count,
         const PasswordPrompt& reason) const noexcept(false) final;
 #endif  // OT_CRYPTO_WITH_BIP32
+    void index_elements() const noexcept;
     internal::BalanceElement& mutable_element(
         const Lock& lock,
         const Subchain type,
         const Bip32Index index) noexcept(false) final;
+#if OT_CRYPTO_WITH_BIP32
+    HDKey public_key(const Bip32Fingerprint parent, const ReadView pubkey) const
+        noexcept(false);
+#endif  // OT_CRYPTO_WITH_BIP32
     bool save(const Lock& lock) const noexcept final;
     void set_metadata(
         const Lock& lock,
@@ -67,6 +98,12 @@ private:
         const Bip32Index index,
         const Identifier& contact,
         const std::string& label) const noexcept final;
+#if OT_CRYPTO_WITH_BIP32
+    const opentxs::crypto::Bip32::Key& subchain_node(
+        const Lock& lock,
+        const Subchain type,
+        const PasswordPrompt& reason) const noexcept(false);
+#endif  // OT_CRYPTO_WITH_BIP32
 
     HD(const internal::BalanceTree& parent,
        const proto::HDPath& path,
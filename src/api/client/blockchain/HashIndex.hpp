@@ -0,0 +1,134 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Internal.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace opentxs::api::client::blockchain::implementation
+{
+/** Open addressing hash table from byte strings to ValueType
+ *
+ *  Lookups only take a shared lock on the table itself, so any number of
+ *  threads may probe it while another thread adds entries. Entries are never
+ *  removed, which keeps linear probing free of tombstones.
+ */
+template <typename ValueType, typename Hash = std::hash<ReadView>>
+class HashIndex
+{
+public:
+    auto Find(const ReadView key) const noexcept -> std::optional<ValueType>
+    {
+        const auto hash = hash_(key);
+        sLock lock(lock_);
+        const auto position = find(hash, key);
+
+        if (empty_ == position) { return {}; }
+
+        return entries_.at(position).second;
+    }
+    auto size() const noexcept -> std::size_t
+    {
+        sLock lock(lock_);
+
+        return entries_.size();
+    }
+
+    /// Returns false if the key is already present
+    auto Add(const ReadView key, const ValueType& value) noexcept -> bool
+    {
+        const auto hash = hash_(key);
+        eLock lock(lock_);
+
+        if (empty_ != find(hash, key)) { return false; }
+
+        // Keep the load factor at or below 3/4
+        if ((4 * (entries_.size() + 1)) > (3 * slots_.size())) {
+            resize(std::max(2 * slots_.size(), minimum_slots_));
+        }
+
+        const auto position = static_cast<std::uint32_t>(entries_.size());
+        entries_.emplace_back(std::string{key}, value);
+        insert(hash, position);
+
+        return true;
+    }
+
+    HashIndex() noexcept
+        : hash_()
+        , lock_()
+        , slots_()
+        , entries_()
+    {
+    }
+
+private:
+    struct Slot {
+        std::size_t hash_{};
+        std::uint32_t entry_{empty_};
+    };
+
+    static constexpr auto empty_ = std::numeric_limits<std::uint32_t>::max();
+    static constexpr auto minimum_slots_ = std::size_t{64};
+
+    const Hash hash_;
+    mutable std::shared_mutex lock_;
+    std::vector<Slot> slots_;
+    std::vector<std::pair<std::string, ValueType>> entries_;
+
+    auto find(const std::size_t hash, const ReadView key) const noexcept
+        -> std::uint32_t
+    {
+        if (slots_.empty()) { return empty_; }
+
+        const auto mask = slots_.size() - 1;
+
+        for (auto i = hash & mask;; i = (i + 1) & mask) {
+            const auto& slot = slots_[i];
+
+            if (empty_ == slot.entry_) { return empty_; }
+
+            if ((hash == slot.hash_) &&
+                (key == entries_[slot.entry_].first)) {
+                return slot.entry_;
+            }
+        }
+    }
+    auto insert(const std::size_t hash, const std::uint32_t entry) noexcept
+        -> void
+    {
+        const auto mask = slots_.size() - 1;
+        auto i = hash & mask;
+
+        while (empty_ != slots_[i].entry_) { i = (i + 1) & mask; }
+
+        slots_[i] = Slot{hash, entry};
+    }
+    auto resize(const std::size_t size) noexcept -> void
+    {
+        auto old = std::vector<Slot>(size);
+        old.swap(slots_);
+
+        for (const auto& slot : old) {
+            if (empty_ != slot.entry_) { insert(slot.hash_, slot.entry_); }
+        }
+    }
+
+    HashIndex(const HashIndex&) = delete;
+    HashIndex(HashIndex&&) = delete;
+    HashIndex& operator=(const HashIndex&) = delete;
+    HashIndex& operator=(HashIndex&&) = delete;
+};
+}  // namespace opentxs::api::client::blockchain::implementation
@@ -8,17 +8,25 @@
 #include "opentxs/api/crypto/Crypto.hpp"
 #include "opentxs/api/crypto/Encode.hpp"
 #include "opentxs/blockchain/block/Header.hpp"
+#include "opentxs/core/Log.hpp"
 #include "opentxs/Proto.tpp"
 
 #include "internal/api/Api.hpp"
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "BlockHeaders.hpp"
 
-// #define OT_METHOD
-// "opentxs::api::client::blockchain::database::implementation::BlockHeader::"
+#define OT_METHOD                                                              \
+    "opentxs::api::client::blockchain::database::implementation::BlockHeader::"
 
 namespace opentxs::api::client::blockchain::database::implementation
 {
+const std::size_t BlockHeader::hash_size_{32};
+const std::size_t BlockHeader::migration_batch_{10000};
+
 BlockHeader::BlockHeader(
     const api::internal::Core& api,
     opentxs::storage::lmdb::LMDB& lmdb) noexcept(false)
@@ -30,8 +38,7 @@ BlockHeader::BlockHeader(
 auto BlockHeader::BlockHeaderExists(
     const opentxs::blockchain::block::Hash& hash) const noexcept -> bool
 {
-    return lmdb_.Exists(
-        Table::BlockHeaders, api_.Crypto().Encode().IdentifierEncode(hash));
+    return lmdb_.Exists(Table::BlockHeaders, hash.Bytes());
 }
 
 auto BlockHeader::LoadBlockHeader(const opentxs::blockchain::block::Hash& hash)
@@ -40,7 +47,7 @@ auto BlockHeader::LoadBlockHeader(const opentxs::blockchain::block::Hash& hash)
     auto output = std::optional<proto::BlockchainBlockHeader>{};
     lmdb_.Load(
         Table::BlockHeaders,
-        api_.Crypto().Encode().IdentifierEncode(hash),
+        hash.Bytes(),
         [&](const auto data) -> void {
             output = proto::Factory<proto::BlockchainBlockHeader>(
                 data.data(), data.size());
@@ -53,6 +60,73 @@ auto BlockHeader::LoadBlockHeader(const opentxs::blockchain::block::Hash& hash)
     return output.value();
 }
 
+auto BlockHeader::MigrateKeys() const noexcept -> bool
+{
+    using Legacy = std::vector<std::pair<std::string, std::string>>;
+
+    auto migrated = std::size_t{0};
+    auto legacy = Legacy{};
+    auto last = std::string{};
+    legacy.reserve(migration_batch_);
+
+    // Records are moved in batches so the memory used by the upgrade does not
+    // scale with the size of the table. Each pass resumes after the last
+    // legacy key of the previous pass, so every record is visited once apart
+    // from migrated keys which happen to sort after the resume point.
+    do {
+        legacy.clear();
+        lmdb_.ReadFrom(
+            Table::BlockHeaders,
+            last,
+            [&](const auto key, const auto value) -> bool {
+                if (hash_size_ != key.size()) {
+                    legacy.emplace_back(std::string{key}, std::string{value});
+                }
+
+                return migration_batch_ > legacy.size();
+            },
+            opentxs::storage::lmdb::LMDB::Dir::Forward);
+
+        if (0 == legacy.size()) { break; }
+
+        auto parentTxn = lmdb_.TransactionRW();
+
+        for (const auto& [key, value] : legacy) {
+            const auto hash = api_.Crypto().Encode().IdentifierDecode(key);
+
+            if (hash_size_ != hash.size()) {
+                LogOutput(OT_METHOD)(__FUNCTION__)(
+                    ": Discarding invalid block header key ")(key)
+                    .Flush();
+            } else {
+                const auto stored = lmdb_.Store(
+                    Table::BlockHeaders,
+                    hash,
+                    value,
+                    parentTxn,
+                    MDB_NOOVERWRITE);
+
+                if ((false == stored.first) &&
+                    (MDB_KEYEXIST != stored.second)) {
+                    return false;
+                }
+            }
+
+            if (false == lmdb_.Delete(Table::BlockHeaders, key, parentTxn)) {
+                return false;
+            }
+        }
+
+        if (false == parentTxn.Finalize(true)) { return false; }
+
+        last = legacy.back().first;
+        migrated += legacy.size();
+        LogNormal("Upgraded ")(migrated)(" block header keys").Flush();
+    } while (true);
+
+    return true;
+}
+
 auto BlockHeader::StoreBlockHeader(
     const opentxs::blockchain::block::Header& header) const noexcept -> bool
 {
@@ -60,7 +134,7 @@ auto BlockHeader::StoreBlockHeader(
     serialized.clear_local();
     const auto result = lmdb_.Store(
         Table::BlockHeaders,
-        api_.Crypto().Encode().IdentifierEncode(header.Hash()),
+        header.Hash().Bytes(),
         proto::ToString(header.Serialize()),
         nullptr,
         MDB_NOOVERWRITE);
@@ -85,7 +159,7 @@ auto BlockHeader::StoreBlockHeaders(const UpdatedHeader& headers) const noexcept
             serialized.clear_local();
             const auto stored = lmdb_.Store(
                 Table::BlockHeaders,
-                api_.Crypto().Encode().IdentifierEncode(header->Hash()),
+                header->Hash().Bytes(),
                 proto::ToString(serialized),
                 parentTxn,
                 MDB_NOOVERWRITE);
@@ -19,6 +19,9 @@ public:
         noexcept -> bool;
     auto LoadBlockHeader(const opentxs::blockchain::block::Hash& hash) const
         noexcept(false) -> proto::BlockchainBlockHeader;
+    // Rewrites records stored under base58 identifier keys by earlier
+    // versions to use the raw block hash as the key
+    auto MigrateKeys() const noexcept -> bool;
     auto StoreBlockHeader(const opentxs::blockchain::block::Header& header)
         const noexcept -> bool;
     auto StoreBlockHeaders(const UpdatedHeader& headers) const noexcept -> bool;
@@ -28,6 +31,9 @@ public:
         opentxs::storage::lmdb::LMDB& lmdb) noexcept(false);
 
 private:
+    static const std::size_t hash_size_;
+    static const std::size_t migration_batch_;
+
     const api::internal::Core& api_;
     opentxs::storage::lmdb::LMDB& lmdb_;
 };
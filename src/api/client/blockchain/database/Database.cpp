@@ -6,9 +6,13 @@
 #include "stdafx.hpp"
 
 #include "opentxs/api/Legacy.hpp"
+#include "opentxs/core/Log.hpp"
 
 #include "internal/api/Api.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 #include "Database.hpp"
 
 // #define OT_METHOD
@@ -16,6 +20,16 @@
 
 namespace opentxs::api::client::blockchain::database::implementation
 {
+template <typename Input>
+ReadView tsv(const Input& in) noexcept
+{
+    return {reinterpret_cast<const char*>(&in), sizeof(in)};
+}
+
+// Version 1 keyed block headers by base58 identifier
+// Version 2 keys the block header table by raw hash bytes. The peer tables
+// are still keyed by the base58 peer identifier.
+const std::size_t Database::db_version_{2};
 const opentxs::storage::lmdb::TableNames Database::table_names_{
     {BlockHeaders, "block_headers"},
     {PeerDetails, "peers"},
@@ -30,6 +44,8 @@ const opentxs::storage::lmdb::TableNames Database::table_names_{
     {FilterHeadersBasic, "block_filter_headers_basic"},
     {FilterHeadersBCH, "block_filter_headers_bch"},
     {FilterHeadersOpentxs, "block_filter_headers_opentxs"},
+    {Config, "config"},
+    {PeerScores, "peer_scores"},
 };
 
 Database::Database(
@@ -57,11 +73,14 @@ Database::Database(
               {FilterHeadersBasic, 0},
               {FilterHeadersBCH, 0},
               {FilterHeadersOpentxs, 0},
+              {Config, MDB_INTEGERKEY},
+              {PeerScores, 0},
           })
     , headers_(api, lmdb_)
     , peers_(api, lmdb_)
     , filters_(api, lmdb_)
 {
+    init_db();
 }
 
 auto Database::AllocateStorageFolder(const std::string& dir) const noexcept
@@ -89,6 +108,53 @@ auto Database::init_folder(
     return output;
 }
 
+auto Database::init_db() noexcept(false) -> void
+{
+    auto version = std::size_t{0};
+    auto found = lmdb_.Load(
+        Config,
+        static_cast<std::size_t>(Key::Version),
+        [&](const auto in) -> void {
+            std::memcpy(
+                &version, in.data(), std::min(in.size(), sizeof(version)));
+        });
+
+    if (false == found) {
+        // Databases created before the version key was introduced use the
+        // version 1 layout unless they are empty
+        auto empty{true};
+        lmdb_.Read(
+            BlockHeaders,
+            [&](const auto, const auto) -> bool {
+                empty = false;
+
+                return false;
+            },
+            opentxs::storage::lmdb::LMDB::Dir::Forward);
+        version = empty ? db_version_ : std::size_t{1};
+    }
+
+    if (2 > version) {
+        LogNormal("Upgrading blockchain database to version ")(db_version_)
+            .Flush();
+
+        if (false == headers_.MigrateKeys()) {
+            throw std::runtime_error("Failed to upgrade block header keys");
+        }
+    }
+
+    if ((db_version_ > version) || (false == found)) {
+        const auto stored = lmdb_.Store(
+            Config,
+            static_cast<std::size_t>(Key::Version),
+            tsv(db_version_));
+
+        if (false == stored.first) {
+            throw std::runtime_error("Failed to store database version");
+        }
+    }
+}
+
 auto Database::init_storage_path(
     const api::Legacy& legacy,
     const std::string& dataFolder) noexcept(false) -> OTString
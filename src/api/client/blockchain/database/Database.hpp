@@ -37,9 +37,10 @@ public:
         const Chain chain,
         const Protocol protocol,
         const std::set<Type> onNetworks,
-        const std::set<Service> withServices) const noexcept -> Address_p
+        const std::set<Service> withServices,
+        const std::set<OTIdentifier>& exclude) const noexcept -> Address_p
     {
-        return peers_.Find(chain, protocol, onNetworks, withServices);
+        return peers_.Find(chain, protocol, onNetworks, withServices, exclude);
     }
     auto HaveFilter(const FilterType type, const ReadView blockHash) const
         noexcept -> bool
@@ -60,6 +61,11 @@ public:
     {
         return headers_.LoadBlockHeader(hash);
     }
+    auto LoadFilter(const FilterType type, const ReadView blockHash) const
+        noexcept -> std::unique_ptr<const opentxs::blockchain::internal::GCS>
+    {
+        return filters_.LoadFilter(type, blockHash);
+    }
     auto LoadFilterHash(
         const FilterType type,
         const ReadView blockHash,
@@ -74,6 +80,11 @@ public:
     {
         return filters_.LoadFilterHeader(type, blockHash, header);
     }
+    auto Score(const Identifier& address, const PeerScore& session) const
+        noexcept -> bool
+    {
+        return peers_.Score(address, session);
+    }
     auto StoreBlockHeader(
         const opentxs::blockchain::block::Header& header) const noexcept -> bool
     {
@@ -101,6 +112,11 @@ public:
         const std::string& dataFolder) noexcept(false);
 
 private:
+    enum class Key : std::size_t {
+        Version = 0,
+    };
+
+    static const std::size_t db_version_;
     static const opentxs::storage::lmdb::TableNames table_names_;
 
     const api::internal::Core& api_;
@@ -119,6 +135,8 @@ private:
         const api::Legacy& legacy,
         const std::string& dataFolder) noexcept(false) -> OTString;
 
+    auto init_db() noexcept(false) -> void;
+
     Database() = delete;
     Database(const Database&) = delete;
     Database(Database&&) = delete;
@@ -8,40 +8,66 @@
 #include "opentxs/core/Log.hpp"
 #include "opentxs/Proto.tpp"
 
-#include <random>
+#include <boost/endian/buffers.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
 
 #include "Peers.hpp"
 
 #define OT_METHOD                                                              \
     "opentxs::api::client::blockchain::database::implementation::Peers::"
 
+namespace be = boost::endian;
+
+namespace
+{
+struct SerializedScore {
+    be::little_uint32_buf_t handshakes_;
+    be::little_uint32_buf_t failures_;
+    be::little_uint32_buf_t misbehavior_;
+    be::little_uint32_buf_t rtt_;
+    be::little_uint64_buf_t bytes_;
+    be::little_int64_buf_t banned_until_;
+};
+}  // namespace
+
 namespace opentxs::api::client::blockchain::database::implementation
 {
+const std::chrono::hours Peers::ban_duration_{1};
+const std::chrono::hours Peers::max_ban_duration_{24};
+
 Peers::Peers(
     const api::internal::Core& api,
     opentxs::storage::lmdb::LMDB& lmdb) noexcept(false)
     : api_(api)
     , lmdb_(lmdb)
     , lock_()
-    , chains_()
-    , protocols_()
-    , services_()
-    , networks_()
-    , connected_()
+    , records_()
+    , ranked_()
 {
     using Dir = opentxs::storage::lmdb::LMDB::Dir;
 
     auto chain = [this](const auto key, const auto value) {
-        return read_index<Chain>(key, value, chains_);
+        return read_index<Chain>(key, value, [](auto& record, auto index) {
+            record.chain_ = index;
+        });
     };
     auto protocol = [this](const auto key, const auto value) {
-        return read_index<Protocol>(key, value, protocols_);
+        return read_index<Protocol>(key, value, [](auto& record, auto index) {
+            record.protocol_ = index;
+        });
     };
     auto service = [this](const auto key, const auto value) {
-        return read_index<Service>(key, value, services_);
+        return read_index<Service>(key, value, [](auto& record, auto index) {
+            record.services_.emplace(index);
+        });
     };
     auto type = [this](const auto key, const auto value) {
-        return read_index<Type>(key, value, networks_);
+        return read_index<Type>(key, value, [](auto& record, auto index) {
+            record.network_ = index;
+        });
     };
     auto last = [this](const auto key, const auto value) {
         auto input = std::size_t{};
@@ -51,7 +77,26 @@ Peers::Peers(
         }
 
         std::memcpy(&input, key.data(), key.size());
-        connected_.emplace(value, Clock::from_time_t(input));
+        records_[std::string{value}].connected_ = Clock::from_time_t(input);
+
+        return true;
+    };
+    auto score = [this](const auto key, const auto value) {
+        auto input = SerializedScore{};
+
+        if (sizeof(input) != value.size()) {
+            throw std::runtime_error("Invalid score");
+        }
+
+        std::memcpy(static_cast<void*>(&input), value.data(), value.size());
+        auto& record = records_[std::string{key}];
+        auto& out = record.score_;
+        out.handshakes_ = input.handshakes_.value();
+        out.failures_ = input.failures_.value();
+        out.misbehavior_ = input.misbehavior_.value();
+        out.rtt_ = input.rtt_.value();
+        out.bytes_ = input.bytes_.value();
+        record.banned_until_ = Clock::from_time_t(input.banned_until_.value());
 
         return true;
     };
@@ -61,124 +106,119 @@ Peers::Peers(
     lmdb_.Read(PeerServiceIndex, service, Dir::Forward);
     lmdb_.Read(PeerNetworkIndex, type, Dir::Forward);
     lmdb_.Read(PeerConnectedIndex, last, Dir::Forward);
+    lmdb_.Read(PeerScores, score, Dir::Forward);
+    Lock lock(lock_);
+
+    for (const auto& [id, record] : records_) { index(lock, id, record); }
 }
 
-auto Peers::Find(
+auto Peers::bucket(
+    const Lock& lock,
     const Chain chain,
     const Protocol protocol,
-    const std::set<Type> onNetworks,
-    const std::set<Service> withServices) const noexcept -> Address_p
+    const Type network,
+    const std::set<Service>& withServices) const noexcept
+    -> const std::set<Rank>*
 {
-    Lock lock(lock_);
+    if (withServices.empty()) {
+        try {
 
-    try {
-        auto candidates = std::set<std::string>{};
-        const auto& protocolSet = protocols_.at(protocol);
-        const auto& chainSet = chains_.at(chain);
+            return &ranked_.at({chain, protocol, network, Service::None});
+        } catch (...) {
 
-        if (protocolSet.empty()) { return {}; }
-        if (chainSet.empty()) { return {}; }
-
-        for (const auto& network : onNetworks) {
-            try {
-                for (const auto& id : networks_.at(network)) {
-                    if ((1 == chainSet.count(id)) &&
-                        (1 == protocolSet.count(id))) {
-                        candidates.emplace(id);
-                    }
-                }
-            } catch (...) {
-            }
+            return nullptr;
         }
+    }
 
-        if (candidates.empty()) {
-            LogTrace(OT_METHOD)(__FUNCTION__)(
-                ": No peers available for specified chain/protocol")
-                .Flush();
-
-            return {};
-        }
+    const std::set<Rank>* output{nullptr};
 
-        auto haveServices = std::set<std::string>{};
-
-        if (withServices.empty()) {
-            haveServices = candidates;
-        } else {
-            for (const auto& id : candidates) {
-                bool haveAllServices{true};
-
-                for (const auto& service : withServices) {
-                    try {
-                        if (0 == services_.at(service).count(id)) {
-                            haveAllServices = false;
-                            break;
-                        }
-                    } catch (...) {
-                        haveAllServices = false;
-                        break;
-                    }
-                }
+    // Scan the rarest service since every candidate must be present in it
+    for (const auto& service : withServices) {
+        try {
+            const auto& set = ranked_.at({chain, protocol, network, service});
 
-                if (haveAllServices) { haveServices.emplace(id); }
+            if ((nullptr == output) || (set.size() < output->size())) {
+                output = &set;
             }
+        } catch (...) {
+
+            return nullptr;
         }
+    }
 
-        if (haveServices.empty()) {
-            LogTrace(OT_METHOD)(__FUNCTION__)(
-                ": No peers available with specified services")
-                .Flush();
+    return output;
+}
 
-            return {};
-        } else {
-            LogTrace(OT_METHOD)(__FUNCTION__)(": Choosing from ")(
-                haveServices.size())(" candidates")
-                .Flush();
-        }
+auto Peers::Find(
+    const Chain chain,
+    const Protocol protocol,
+    const std::set<Type> onNetworks,
+    const std::set<Service> withServices,
+    const std::set<OTIdentifier>& exclude) const noexcept -> Address_p
+{
+    auto excluded = std::set<std::string>{};
+    std::transform(
+        exclude.begin(),
+        exclude.end(),
+        std::inserter(excluded, excluded.end()),
+        [](const auto& id) { return id->str(); });
+    const auto now = Clock::now();
+    Lock lock(lock_);
+    const Rank* best{nullptr};
+    auto usable = [&](const std::string& id) {
+        if (0 < excluded.count(id)) { return false; }
 
-        auto weighted = std::vector<std::string>{};
-        const auto now = Clock::now();
+        const auto& record = records_.at(id);
 
-        for (const auto& id : haveServices) {
-            auto weight = std::size_t{1};
+        if (now < record.banned_until_) { return false; }
 
-            try {
-                const auto& last = connected_.at(id);
-                const auto since =
-                    std::chrono::duration_cast<std::chrono::hours>(now - last);
+        return std::includes(
+            record.services_.begin(),
+            record.services_.end(),
+            withServices.begin(),
+            withServices.end());
+    };
 
-                if (since.count() <= 1) {
-                    weight = 10;
-                } else if (since.count() <= 24) {
-                    weight = 5;
+    try {
+        for (const auto& network : onNetworks) {
+            const auto* candidates =
+                bucket(lock, chain, protocol, network, withServices);
+
+            if (nullptr == candidates) { continue; }
+
+            for (const auto& candidate : *candidates) {
+                if ((nullptr != best) && (false == (candidate < *best))) {
+                    break;
                 }
-            } catch (...) {
-            }
 
-            weighted.insert(weighted.end(), weight, id);
+                if (usable(std::get<2>(candidate))) {
+                    best = &candidate;
+                    break;
+                }
+            }
         }
 
-        std::vector<std::string> output;
-        const std::size_t count{1};
-        std::sample(
-            weighted.begin(),
-            weighted.end(),
-            std::back_inserter(output),
-            count,
-            std::mt19937{std::random_device{}()});
+        if (nullptr == best) {
+            LogTrace(OT_METHOD)(__FUNCTION__)(
+                ": No peers available with specified parameters")
+                .Flush();
 
-        OT_ASSERT(count == output.size());
+            return {};
+        }
 
-        LogTrace(OT_METHOD)(__FUNCTION__)(": Loading peer ")(output.front())
+        const auto& id = std::get<2>(*best);
+        LogTrace(OT_METHOD)(__FUNCTION__)(": Loading peer ")(id)(
+            " with score ")(-1 * std::get<0>(*best))
             .Flush();
 
-        return load_address(output.front());
+        return load_address(id);
     } catch (...) {
 
         return {};
     }
 }
 
-bool Peers::Import(std::vector<Address_p> peers) noexcept
+auto Peers::Import(std::vector<Address_p> peers) noexcept -> bool
 {
     auto newPeers = std::vector<Address_p>{};
 
@@ -202,6 +242,22 @@ auto Peers::Insert(Address_p pAddress) noexcept -> bool
     return insert(lock, std::move(peers));
 }
 
+auto Peers::index(
+    const Lock& lock,
+    const std::string& id,
+    const Record& record) noexcept -> void
+{
+    const auto key = rank(id, record);
+    const auto& chain = record.chain_;
+    const auto& protocol = record.protocol_;
+    const auto& network = record.network_;
+    ranked_[{chain, protocol, network, Service::None}].emplace(key);
+
+    for (const auto& service : record.services_) {
+        ranked_[{chain, protocol, network, service}].emplace(key);
+    }
+}
+
 auto Peers::insert(const Lock& lock, std::vector<Address_p> peers) noexcept
     -> bool
 {
@@ -329,19 +385,21 @@ auto Peers::insert(const Lock& lock, std::vector<Address_p> peers) noexcept
 
         // Update in-memory indices to match database
         {
-            chains_[address.Chain()].emplace(id);
-            protocols_[address.Style()].emplace(id);
-            networks_[address.Type()].emplace(id);
-
-            for (const auto& service : address.Services()) {
-                services_[service].emplace(id);
-            }
+            auto it = records_.find(id);
 
-            for (const auto& service : deleteServices) {
-                services_[service].erase(id);
+            if (records_.end() == it) {
+                it = records_.emplace(id, Record{}).first;
+            } else {
+                unindex(lock, id, it->second);
             }
 
-            connected_[id] = address.LastConnected();
+            auto& record = it->second;
+            record.chain_ = address.Chain();
+            record.protocol_ = address.Style();
+            record.network_ = address.Type();
+            record.services_ = address.Services();
+            record.connected_ = address.LastConnected();
+            index(lock, id, record);
         }
     }
 
@@ -375,4 +433,89 @@ auto Peers::load_address(const std::string& id) const noexcept(false)
 
     return opentxs::Factory::BlockchainAddress(api_, serialized);
 }
+
+auto Peers::rank(const std::string& id, const Record& record) noexcept -> Rank
+{
+    const auto& score = record.score_;
+    auto value = std::int64_t{0};
+    value += 100 * static_cast<std::int64_t>(score.handshakes_);
+    value -= 200 * static_cast<std::int64_t>(score.failures_);
+    value -= 1000 * static_cast<std::int64_t>(score.misbehavior_);
+    value += std::min<std::int64_t>(score.bytes_ >> 20, 1000);
+    value -= score.rtt_ / 10;
+    const auto connected = Clock::to_time_t(record.connected_);
+
+    return Rank{-1 * value, -1 * static_cast<std::int64_t>(connected), id};
+}
+
+auto Peers::Score(const Identifier& address, const PeerScore& session) noexcept
+    -> bool
+{
+    const auto id = address.str();
+    Lock lock(lock_);
+    auto it = records_.find(id);
+
+    if (records_.end() == it) {
+        LogTrace(OT_METHOD)(__FUNCTION__)(": Peer ")(id)(" not found").Flush();
+
+        return false;
+    }
+
+    auto& record = it->second;
+    unindex(lock, id, record);
+    auto& score = record.score_;
+    score.handshakes_ += session.handshakes_;
+    score.failures_ += session.failures_;
+    score.misbehavior_ += session.misbehavior_;
+    score.bytes_ += session.bytes_;
+
+    if (0 < session.rtt_) {
+        score.rtt_ = (0 == score.rtt_) ? session.rtt_
+                                       : (3 * score.rtt_ + session.rtt_) / 4;
+    }
+
+    if (0 < session.misbehavior_) {
+        record.banned_until_ =
+            Clock::now() +
+            std::min(max_ban_duration_, ban_duration_ * score.misbehavior_);
+        LogVerbose(OT_METHOD)(__FUNCTION__)(": Banning peer ")(id).Flush();
+    }
+
+    index(lock, id, record);
+    auto serialized = SerializedScore{};
+    serialized.handshakes_ = score.handshakes_;
+    serialized.failures_ = score.failures_;
+    serialized.misbehavior_ = score.misbehavior_;
+    serialized.rtt_ = score.rtt_;
+    serialized.bytes_ = score.bytes_;
+    serialized.banned_until_ = Clock::to_time_t(record.banned_until_);
+    const auto result = lmdb_.Store(
+        Table::PeerScores,
+        id,
+        ReadView{reinterpret_cast<const char*>(&serialized),
+                 sizeof(serialized)});
+
+    if (false == result.first) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to save peer score")
+            .Flush();
+    }
+
+    return result.first;
+}
+
+auto Peers::unindex(
+    const Lock& lock,
+    const std::string& id,
+    const Record& record) noexcept -> void
+{
+    const auto key = rank(id, record);
+    const auto& chain = record.chain_;
+    const auto& protocol = record.protocol_;
+    const auto& network = record.network_;
+    ranked_[{chain, protocol, network, Service::None}].erase(key);
+
+    for (const auto& service : record.services_) {
+        ranked_[{chain, protocol, network, service}].erase(key);
+    }
+}
 }  // namespace opentxs::api::client::blockchain::database::implementation
@@ -16,43 +16,72 @@ namespace opentxs::api::client::blockchain::database::implementation
 class Peers
 {
 public:
-    auto Find(
+    OPENTXS_EXPORT auto Find(
         const Chain chain,
         const Protocol protocol,
         const std::set<Type> onNetworks,
-        const std::set<Service> withServices) const noexcept -> Address_p;
+        const std::set<Service> withServices,
+        const std::set<OTIdentifier>& exclude) const noexcept -> Address_p;
 
-    auto Import(std::vector<Address_p> peers) noexcept -> bool;
-    auto Insert(Address_p address) noexcept -> bool;
+    OPENTXS_EXPORT auto Import(std::vector<Address_p> peers) noexcept -> bool;
+    OPENTXS_EXPORT auto Insert(Address_p address) noexcept -> bool;
+    OPENTXS_EXPORT auto Score(
+        const Identifier& address,
+        const PeerScore& session) noexcept -> bool;
 
     Peers(
         const api::internal::Core& api,
         opentxs::storage::lmdb::LMDB& lmdb) noexcept(false);
 
 private:
-    using ChainIndexMap = std::map<Chain, std::set<std::string>>;
-    using ProtocolIndexMap = std::map<Protocol, std::set<std::string>>;
-    using ServiceIndexMap = std::map<Service, std::set<std::string>>;
-    using TypeIndexMap = std::map<Type, std::set<std::string>>;
-    using ConnectedIndexMap = std::map<std::string, Time>;
+    struct Record {
+        Chain chain_{};
+        Protocol protocol_{};
+        Type network_{};
+        std::set<Service> services_{};
+        PeerScore score_{};
+        Time banned_until_{};
+        Time connected_{};
+    };
+
+    // Sorts best first: highest score, then most recently connected
+    using Rank = std::tuple<std::int64_t, std::int64_t, std::string>;
+    // Service::None indexes every peer regardless of advertised services
+    using Bucket = std::tuple<Chain, Protocol, Type, Service>;
+    using RankIndex = std::map<Bucket, std::set<Rank>>;
+    using RecordMap = std::map<std::string, Record>;
+
+    static const std::chrono::hours ban_duration_;
+    static const std::chrono::hours max_ban_duration_;
 
     const api::internal::Core& api_;
     opentxs::storage::lmdb::LMDB& lmdb_;
     mutable std::mutex lock_;
-    ChainIndexMap chains_;
-    ProtocolIndexMap protocols_;
-    ServiceIndexMap services_;
-    TypeIndexMap networks_;
-    ConnectedIndexMap connected_;
+    RecordMap records_;
+    RankIndex ranked_;
+
+    static auto rank(const std::string& id, const Record& record) noexcept
+        -> Rank;
 
+    auto bucket(
+        const Lock& lock,
+        const Chain chain,
+        const Protocol protocol,
+        const Type network,
+        const std::set<Service>& withServices) const noexcept
+        -> const std::set<Rank>*;
+    auto index(
+        const Lock& lock,
+        const std::string& id,
+        const Record& record) noexcept -> void;
     auto insert(const Lock& lock, std::vector<Address_p> peers) noexcept
         -> bool;
     auto load_address(const std::string& id) const noexcept(false) -> Address_p;
-    template <typename Index, typename Map>
+    template <typename Index, typename Setter>
     auto read_index(
         const ReadView key,
         const ReadView value,
-        Map& map) noexcept(false) -> bool
+        Setter set) noexcept(false) -> bool
     {
         auto input = std::size_t{};
 
@@ -61,9 +90,13 @@ private:
         }
 
         std::memcpy(&input, key.data(), key.size());
-        map[static_cast<Index>(input)].emplace(value);
+        set(records_[std::string{value}], static_cast<Index>(input));
 
         return true;
     }
+    auto unindex(
+        const Lock& lock,
+        const std::string& id,
+        const Record& record) noexcept -> void;
 };
 }  // namespace opentxs::api::client::blockchain::database::implementation
@@ -276,6 +276,15 @@ auto Hash::MurmurHash3_32(
     MurmurHash3_x86_32(data.data(), data.size(), key, &output);
 }
 
+auto Hash::MurmurHash3_128(
+    const std::uint32_t& key,
+    const ReadView data,
+    std::array<std::uint64_t, 2>& output) const noexcept -> void
+{
+    MurmurHash3_x64_128(
+        data.data(), static_cast<int>(data.size()), key, output.data());
+}
+
 auto Hash::PKCS5_PBKDF2_HMAC(
     const Data& input,
     const Data& salt,
@@ -31,6 +31,10 @@ public:
         const std::uint32_t& key,
         const Data& data,
         std::uint32_t& output) const noexcept final;
+    void MurmurHash3_128(
+        const std::uint32_t& key,
+        const ReadView data,
+        std::array<std::uint64_t, 2>& output) const noexcept final;
     bool PKCS5_PBKDF2_HMAC(
         const Data& input,
         const Data& salt,
@@ -0,0 +1,110 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "stdafx.hpp"
+
+#include "Internal.hpp"
+
+#include "internal/api/Api.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "BoxCache.hpp"
+
+namespace opentxs::api::server::implementation
+{
+BoxCache::BoxCache(
+    const std::size_t maxBytes,
+    const std::size_t maxSignatures) noexcept
+    : max_bytes_(maxBytes)
+    , max_signatures_(maxSignatures)
+    , lock_()
+    , order_()
+    , boxes_()
+    , bytes_(0)
+    , signature_order_()
+    , signatures_()
+{
+}
+
+void BoxCache::Erase(const std::string& location) const noexcept
+{
+    Lock lock(lock_);
+    erase(lock, location);
+}
+
+void BoxCache::erase(const Lock&, const std::string& location) const noexcept
+{
+    auto it = boxes_.find(location);
+
+    if (boxes_.end() == it) { return; }
+
+    const auto& [contents, position] = it->second;
+    bytes_ -= contents.size();
+    order_.erase(position);
+    boxes_.erase(it);
+}
+
+bool BoxCache::Load(const std::string& location, std::string& contents) const
+    noexcept
+{
+    Lock lock(lock_);
+    auto it = boxes_.find(location);
+
+    if (boxes_.end() == it) { return false; }
+
+    auto& [cached, position] = it->second;
+    order_.splice(order_.end(), order_, position);
+    contents = cached;
+
+    return true;
+}
+
+void BoxCache::SetVerified(const std::string& digest) const noexcept
+{
+    Lock lock(lock_);
+
+    if (false == signatures_.emplace(digest).second) { return; }
+
+    signature_order_.push_back(digest);
+
+    while (signature_order_.size() > max_signatures_) {
+        signatures_.erase(signature_order_.front());
+        signature_order_.pop_front();
+    }
+}
+
+void BoxCache::Store(const std::string& location, const std::string& contents)
+    const noexcept
+{
+    Lock lock(lock_);
+    erase(lock, location);
+
+    if (contents.size() > max_bytes_) { return; }
+
+    while ((bytes_ + contents.size()) > max_bytes_) {
+        const auto oldest = order_.front();
+        erase(lock, oldest);
+    }
+
+    const auto position = order_.insert(order_.end(), location);
+    boxes_.emplace(location, Entry{contents, position});
+    bytes_ += contents.size();
+}
+
+bool BoxCache::Verified(const std::string& digest) const noexcept
+{
+    Lock lock(lock_);
+
+    return 0 < signatures_.count(digest);
+}
+}  // namespace opentxs::api::server::implementation
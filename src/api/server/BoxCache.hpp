@@ -0,0 +1,76 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Internal.hpp"
+
+#include "internal/api/Api.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace opentxs::api::server::implementation
+{
+/** Bounded cache of box files for a notary
+ *
+ *  Box contents are written through: every save replaces the cached copy
+ *  after the file has been stored, and a failed save drops it. The least
+ *  recently used boxes are evicted once the total size exceeds the limit.
+ *
+ *  Verified signatures are remembered by a digest which covers the signer,
+ *  the signed contents and the signatures, so an entry never outlives the
+ *  data it describes and needs no invalidation.
+ */
+class BoxCache final : public api::internal::BoxCache
+{
+public:
+    OPENTXS_EXPORT void Erase(const std::string& location) const
+        noexcept final;
+    OPENTXS_EXPORT bool Load(
+        const std::string& location,
+        std::string& contents) const noexcept final;
+    OPENTXS_EXPORT void SetVerified(const std::string& digest) const
+        noexcept final;
+    OPENTXS_EXPORT void Store(
+        const std::string& location,
+        const std::string& contents) const noexcept final;
+    OPENTXS_EXPORT bool Verified(const std::string& digest) const
+        noexcept final;
+
+    OPENTXS_EXPORT BoxCache(
+        const std::size_t maxBytes,
+        const std::size_t maxSignatures) noexcept;
+
+    ~BoxCache() final = default;
+
+private:
+    using Order = std::list<std::string>;
+    using Entry = std::pair<std::string, Order::iterator>;
+
+    const std::size_t max_bytes_;
+    const std::size_t max_signatures_;
+    mutable std::mutex lock_;
+    mutable Order order_;
+    mutable std::unordered_map<std::string, Entry> boxes_;
+    mutable std::size_t bytes_;
+    mutable std::deque<std::string> signature_order_;
+    mutable std::unordered_set<std::string> signatures_;
+
+    void erase(const Lock& lock, const std::string& location) const noexcept;
+
+    BoxCache() = delete;
+    BoxCache(const BoxCache&) = delete;
+    BoxCache(BoxCache&&) = delete;
+    BoxCache& operator=(const BoxCache&) = delete;
+    BoxCache& operator=(BoxCache&&) = delete;
+};
+}  // namespace opentxs::api::server::implementation
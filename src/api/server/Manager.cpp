@@ -43,6 +43,7 @@
 #include <string>
 #include <thread>
 
+#include "BoxCache.hpp"
 #include "Manager.hpp"
 
 #if OT_CASH
@@ -104,6 +105,9 @@ api::server::Manager* Factory::ServerManager(
 
 namespace opentxs::api::server::implementation
 {
+const std::size_t Manager::box_cache_bytes_{256 * 1024 * 1024};
+const std::size_t Manager::box_cache_signatures_{65536};
+
 Manager::Manager(
     const api::internal::Context& parent,
     Flag& running,
@@ -125,6 +129,7 @@ Manager::Manager(
           true,
           std::unique_ptr<api::internal::Factory>{
               opentxs::Factory::FactoryAPIServer(*this)})
+    , box_cache_(box_cache_bytes_, box_cache_signatures_)
     , reason_(factory_.PasswordPrompt("Notary operation"))
     , server_p_(new opentxs::server::Server(*this, reason_))
     , server_(*server_p_)
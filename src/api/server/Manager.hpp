@@ -12,6 +12,10 @@ namespace opentxs::api::server::implementation
 class Manager final : internal::Manager, api::implementation::Core
 {
 public:
+    const api::internal::BoxCache* Boxes() const noexcept final
+    {
+        return &box_cache_;
+    }
     void DropIncoming(const int count) const final;
     void DropOutgoing(const int count) const final;
     std::string GetAdminNym() const final;
@@ -56,6 +60,10 @@ private:
     typedef std::map<std::string, std::shared_ptr<blind::Mint>> MintSeries;
 #endif  // OT_CASH
 
+    static const std::size_t box_cache_bytes_;
+    static const std::size_t box_cache_signatures_;
+
+    const BoxCache box_cache_;
     const OTPasswordPrompt reason_;
     std::unique_ptr<opentxs::server::Server> server_p_;
     opentxs::server::Server& server_;
@@ -17,24 +17,373 @@
 
 #include "internal/blockchain/Blockchain.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <future>
+#include <iterator>
+#include <limits>
 #include <map>
+#include <set>
+#include <stdexcept>
+#include <thread>
 
-#define BITMASK(n) ((1 << (n)) - 1)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 namespace opentxs::blockchain::internal
 {
+namespace
+{
+inline auto load_le(const char* in) noexcept -> std::uint64_t
+{
+    auto output = be::little_uint64_buf_t{};
+    std::memcpy(static_cast<void*>(&output), in, sizeof(output));
+
+    return output.value();
+}
+
+inline auto rotl(const std::uint64_t value, const int bits) noexcept
+    -> std::uint64_t
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+struct SipState {
+    static constexpr int c_{2};
+    static constexpr int d_{4};
+
+    std::uint64_t v0_;
+    std::uint64_t v1_;
+    std::uint64_t v2_;
+    std::uint64_t v3_;
+
+    // The final block holds the trailing bytes and the low byte of the length
+    auto last_block(const ReadView item) const noexcept -> std::uint64_t
+    {
+        const auto tail = item.size() % 8;
+        const auto* it =
+            reinterpret_cast<const std::uint8_t*>(item.data()) + item.size();
+        auto output = static_cast<std::uint64_t>(item.size()) << 56;
+
+        for (auto i = tail; i > 0; --i) {
+            output |= static_cast<std::uint64_t>(*(it - i)) << (8 * (tail - i));
+        }
+
+        return output;
+    }
+
+    auto compress(const std::uint64_t block) noexcept -> void
+    {
+        v3_ ^= block;
+
+        for (auto i = 0; i < c_; ++i) { round(); }
+
+        v0_ ^= block;
+    }
+
+    auto finalize() noexcept -> std::uint64_t
+    {
+        v2_ ^= 0xff;
+
+        for (auto i = 0; i < d_; ++i) { round(); }
+
+        return v0_ ^ v1_ ^ v2_ ^ v3_;
+    }
+
+    auto round() noexcept -> void
+    {
+        v0_ += v1_;
+        v1_ = rotl(v1_, 13);
+        v1_ ^= v0_;
+        v0_ = rotl(v0_, 32);
+        v2_ += v3_;
+        v3_ = rotl(v3_, 16);
+        v3_ ^= v2_;
+        v0_ += v3_;
+        v3_ = rotl(v3_, 21);
+        v3_ ^= v0_;
+        v2_ += v1_;
+        v1_ = rotl(v1_, 17);
+        v1_ ^= v2_;
+        v2_ = rotl(v2_, 32);
+    }
+
+    SipState(const std::uint64_t k0, const std::uint64_t k1) noexcept
+        : v0_(k0 ^ 0x736f6d6570736575)
+        , v1_(k1 ^ 0x646f72616e646f6d)
+        , v2_(k0 ^ 0x6c7967656e657261)
+        , v3_(k1 ^ 0x7465646279746573)
+    {
+    }
+    SipState() noexcept
+        : SipState(0, 0)
+    {
+    }
+};
+
+// Returns the number of consecutive 1 bits starting from the most significant
+inline auto leading_ones(const std::uint64_t value) noexcept -> std::size_t
+{
+    const auto inverted = ~value;
+
+    if (0 == inverted) { return 64; }
+
+#if defined(_MSC_VER)
+    unsigned long index{};
+    _BitScanReverse64(&index, inverted);
+
+    return 63 - static_cast<std::size_t>(index);
+#else
+    return static_cast<std::size_t>(__builtin_clzll(inverted));
+#endif
+}
+
+constexpr std::array<std::uint32_t, 64> sha256_k_{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+constexpr std::array<std::uint32_t, 8> sha256_init_{
+    0x6a09e667,
+    0xbb67ae85,
+    0x3c6ef372,
+    0xa54ff53a,
+    0x510e527f,
+    0x9b05688c,
+    0x1f83d9ab,
+    0x5be0cd19};
+// Inputs to the merkle tree which are hashed lanes at a time
+constexpr std::size_t sha256_lanes_{8};
+// Trees with fewer nodes than this on a level are hashed on one thread
+constexpr std::size_t parallel_nodes_{1024};
+
+template <std::size_t Lanes>
+using Sha256State = std::array<std::array<std::uint32_t, Lanes>, 8>;
+template <std::size_t Lanes>
+using Sha256Block = std::array<std::array<std::uint32_t, Lanes>, 16>;
+
+inline auto load_be32(const std::byte* in) noexcept -> std::uint32_t
+{
+    auto output = be::big_uint32_buf_t{};
+    std::memcpy(static_cast<void*>(&output), in, sizeof(output));
+
+    return output.value();
+}
+
+inline auto rotr(const std::uint32_t value, const int bits) noexcept
+    -> std::uint32_t
+{
+    return (value >> bits) | (value << (32 - bits));
+}
+
+inline auto store_be32(const std::uint32_t value, std::byte* out) noexcept
+    -> void
+{
+    const auto buf = be::big_uint32_buf_t{value};
+    std::memcpy(out, static_cast<const void*>(&buf), sizeof(buf));
+}
+
+// Applies one block to every lane. The innermost loops run across lanes so
+// the compiler can keep independent lanes in vector registers.
+template <std::size_t Lanes>
+auto sha256_compress(
+    Sha256State<Lanes>& state,
+    const Sha256Block<Lanes>& block) noexcept -> void
+{
+    auto w = std::array<std::array<std::uint32_t, Lanes>, 64>{};
+    auto v = state;
+
+    for (auto t = std::size_t{0}; t < 16; ++t) { w[t] = block[t]; }
+
+    for (auto t = std::size_t{16}; t < 64; ++t) {
+        for (auto l = std::size_t{0}; l < Lanes; ++l) {
+            const auto a = w[t - 15][l];
+            const auto b = w[t - 2][l];
+            const auto s0 = rotr(a, 7) ^ rotr(a, 18) ^ (a >> 3);
+            const auto s1 = rotr(b, 17) ^ rotr(b, 19) ^ (b >> 10);
+            w[t][l] = w[t - 16][l] + s0 + w[t - 7][l] + s1;
+        }
+    }
+
+    for (auto t = std::size_t{0}; t < 64; ++t) {
+        for (auto l = std::size_t{0}; l < Lanes; ++l) {
+            const auto a = v[0][l];
+            const auto e = v[4][l];
+            const auto s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+            const auto ch = (e & v[5][l]) ^ (~e & v[6][l]);
+            const auto t1 = v[7][l] + s1 + ch + sha256_k_[t] + w[t][l];
+            const auto s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+            const auto maj =
+                (a & v[1][l]) ^ (a & v[2][l]) ^ (v[1][l] & v[2][l]);
+            v[7][l] = v[6][l];
+            v[6][l] = v[5][l];
+            v[5][l] = e;
+            v[4][l] = v[3][l] + t1;
+            v[3][l] = v[2][l];
+            v[2][l] = v[1][l];
+            v[1][l] = a;
+            v[0][l] = t1 + s0 + maj;
+        }
+    }
+
+    for (auto i = std::size_t{0}; i < 8; ++i) {
+        for (auto l = std::size_t{0}; l < Lanes; ++l) {
+            state[i][l] += v[i][l];
+        }
+    }
+}
+
+template <std::size_t Lanes>
+auto sha256_initial() noexcept -> Sha256State<Lanes>
+{
+    auto output = Sha256State<Lanes>{};
+
+    for (auto i = std::size_t{0}; i < 8; ++i) {
+        output[i].fill(sha256_init_[i]);
+    }
+
+    return output;
+}
+
+// Double SHA-256 of Lanes contiguous 64 byte messages. The padding blocks
+// are constant since the message length is fixed.
+template <std::size_t Lanes>
+auto sha256d_64(const std::byte* in, std::byte* out) noexcept -> void
+{
+    auto block = Sha256Block<Lanes>{};
+    auto state = sha256_initial<Lanes>();
+
+    for (auto l = std::size_t{0}; l < Lanes; ++l) {
+        for (auto t = std::size_t{0}; t < 16; ++t) {
+            block[t][l] = load_be32(in + (64 * l) + (4 * t));
+        }
+    }
+
+    sha256_compress<Lanes>(state, block);
+
+    for (auto t = std::size_t{0}; t < 16; ++t) { block[t].fill(0); }
+
+    block[0].fill(0x80000000);
+    block[15].fill(512);
+    sha256_compress<Lanes>(state, block);
+
+    for (auto t = std::size_t{0}; t < 8; ++t) { block[t] = state[t]; }
+
+    block[8].fill(0x80000000);
+
+    for (auto t = std::size_t{9}; t < 15; ++t) { block[t].fill(0); }
+
+    block[15].fill(256);
+    state = sha256_initial<Lanes>();
+    sha256_compress<Lanes>(state, block);
+
+    for (auto l = std::size_t{0}; l < Lanes; ++l) {
+        for (auto t = std::size_t{0}; t < 8; ++t) {
+            store_be32(state[t][l], out + (32 * l) + (4 * t));
+        }
+    }
+}
+
+// Hashes count adjacent pairs of digests from input into output
+auto merkle_level(
+    const std::byte* input,
+    std::byte* output,
+    const std::size_t count) noexcept -> void
+{
+    auto i = std::size_t{0};
+
+    for (; (i + sha256_lanes_) <= count; i += sha256_lanes_) {
+        sha256d_64<sha256_lanes_>(input + (64 * i), output + (32 * i));
+    }
+
+    for (; i < count; ++i) {
+        sha256d_64<1>(input + (64 * i), output + (32 * i));
+    }
+}
+
+class Sha256
+{
+public:
+    auto Finalize() noexcept -> Sha256Digest
+    {
+        const auto bits = length_ * 8;
+        const auto pad = std::byte{0x80};
+        Update(ReadView{reinterpret_cast<const char*>(&pad), 1});
+        const auto zero = std::array<char, 64>{};
+        const auto fill = (buffered_ <= 56) ? (56 - buffered_)
+                                            : (64 + 56 - buffered_);
+        Update(ReadView{zero.data(), fill});
+        auto length = be::big_uint64_buf_t{bits};
+        Update(ReadView{reinterpret_cast<const char*>(&length), 8});
+        auto output = Sha256Digest{};
+
+        for (auto t = std::size_t{0}; t < 8; ++t) {
+            store_be32(state_[t][0], output.data() + (4 * t));
+        }
+
+        return output;
+    }
+    auto Update(const ReadView data) noexcept -> void
+    {
+        const auto* it = reinterpret_cast<const std::byte*>(data.data());
+        auto remaining = data.size();
+        length_ += remaining;
+
+        while (0 < remaining) {
+            const auto copy = std::min(remaining, buffer_.size() - buffered_);
+            std::memcpy(buffer_.data() + buffered_, it, copy);
+            buffered_ += copy;
+            it += copy;
+            remaining -= copy;
+
+            if (buffer_.size() == buffered_) {
+                auto block = Sha256Block<1>{};
+
+                for (auto t = std::size_t{0}; t < 16; ++t) {
+                    block[t][0] = load_be32(buffer_.data() + (4 * t));
+                }
+
+                sha256_compress<1>(state_, block);
+                buffered_ = 0;
+            }
+        }
+    }
+
+    Sha256() noexcept
+        : state_(sha256_initial<1>())
+        , buffer_()
+        , buffered_(0)
+        , length_(0)
+    {
+    }
+
+private:
+    Sha256State<1> state_;
+    std::array<std::byte, 64> buffer_;
+    std::size_t buffered_;
+    std::uint64_t length_;
+};
+}  // namespace
+
 BitReader::BitReader(const Data& input_data)
-    : raw_data_(Data::Factory(input_data))
-    , data_(static_cast<std::uint8_t*>(raw_data_->data()))
-    , len_(raw_data_->size())
+    : data_(static_cast<const std::uint8_t*>(input_data.data()))
+    , len_(input_data.size())
     , accum_(0)
     , n_(0)
 {
 }
 
 BitReader::BitReader(std::uint8_t* data, int len)
-    : raw_data_(Data::Factory(data, len))
-    , data_(data)
+    : data_(data)
     , len_(len)
     , accum_(0)
     , n_(0)
@@ -45,83 +394,79 @@ bool BitReader::eof() { return (len_ == 0 && n_ == 0); }
 
 std::uint64_t BitReader::read(std::size_t nbits)
 {
-    // nbits is the number of bits the programmer is trying to read from our
-    // internal data and, interpreted as big endian, return to the caller in
-    // native format. Let's say he's trying to read 19 bits.
-    OT_ASSERT(nbits < 32);
-
-    std::uint64_t ret{0};
-
-    // The first loop iteration, nbits is therefore 19.
-    while (nbits) {
-
-        // n_ starts out as zero. Therefore this if() will resolve to true.
-        // This is because accum_ contains no data, since all the input data
-        // is in the OTData member raw_data_.
-        if (!n_) {
-            // Let's say the raw data contains 500 bytes. so len_ is 500,
-            // and definitely larger than 4 bytes.
-            if (len_ > 4) {
-                // We grab the next 4 bytes from the raw data into a
-                // uint32_t. The first byte is left-shifted 24 bits. The
-                // second 16 bits, the third 8 bits, and the fourth 0 bits,
-                // which are all OR'd together.
-                accum_ = (static_cast<std::uint32_t>(data_[0]) << 24) |
-                         (static_cast<std::uint32_t>(data_[1]) << 16) |
-                         (static_cast<std::uint32_t>(data_[2]) << 8) |
-                         (static_cast<std::uint32_t>(data_[3]));
-                // The data iterator is incremented by 4 bytes.
-                data_ += 4;
-                // The length we're trying to read is decremented by 4
-                // bytes.
-                len_ -= 4;
-                // The number of bits in accum_ are incremented by 32.
-                n_ += 32;
-            }
-            // If the raw data didn't even contain 4 bytes, then does it at
-            // least contain more than 0?
-            else if (len_ > 0) {
-                // Dereference data, grab one byte to accum_, and increment
-                // the data pointer.
-                accum_ = *data_++;
-                // We read one byte, so decrement len_ which is the number
-                // of bytes needing to be read from raw_data_.
-                --len_;
-                // n_ records that we now have 8 more bits of data in
-                // accum_.
-                n_ += 8;
-            } else {
-                return 0;
-            }
+    OT_ASSERT(nbits <= (ACCUM_BITS - 7));
+
+    if (0 == nbits) { return 0; }
+
+    if (n_ < nbits) { refill(); }
+
+    if (n_ < nbits) {
+        // Not enough data remains to satisfy the request
+        accum_ = 0;
+        n_ = 0;
+
+        return 0;
+    }
+
+    const auto output = accum_ >> (ACCUM_BITS - nbits);
+    accum_ <<= nbits;
+    n_ -= nbits;
+
+    return output;
+}
+
+std::uint64_t BitReader::read_unary()
+{
+    auto output = std::uint64_t{0};
+
+    while (true) {
+        if (0 == n_) {
+            refill();
+
+            if (0 == n_) { return output; }
+        }
+
+        // Bits past n_ may already contain prefetched data so the count must
+        // be clamped to the number of valid bits
+        const auto ones = std::min(leading_ones(accum_), n_);
+
+        if (ones < n_) {
+            const auto used = ones + 1;
+            output += ones;
+            accum_ = (used < ACCUM_BITS) ? (accum_ << used) : 0;
+            n_ -= used;
+
+            return output;
         }
 
-        // n_ is the number of bits in accum_, and nbits is the number of
-        // bits the programmer is trying to read. We choose the smaller. So
-        // if there are 10 bits in accum_, and he's trying to read 19,
-        // 'toread' gets set to 10.
-        std::size_t toread = std::min(n_, nbits);
-        // ret is 0 on the first loop iteration. So this does nothing. But
-        // subsequent iterations will, say, left-shift 10 bits to make room
-        // for the 10 being read from accum_.
-        ret <<= toread;
-        // Ret is OR'd with accum_. accum_ is right-shifted by, say, from
-        // (19 bits available) to (10 bits we're reading), subtracting that
-        // results in 9 bits remaining to slice off accum_ before OR'ing
-        // them into return value.
-        ret |= (accum_ >> (n_ - toread));
-        // We've read, say 10 bits, so n_ is reduced from, say 19 to 9. That
-        // is, 9 bits left in accum_ to be read.
-        n_ -= toread;
-        // nbits (number we're trying to read) is decremented by the number
-        // we've just read so far. Eventually it will read zero and this
-        // loop will end.
-        nbits -= toread;
-        // accum_ has, say, 9 bits left to read. So all the other bits are
-        // bitmasked away.
-        accum_ &= BITMASK(n_);
-    }
-
-    return ret;
+        output += n_;
+        accum_ = 0;
+        n_ = 0;
+    }
+}
+
+void BitReader::refill()
+{
+    if (sizeof(std::uint64_t) <= len_) {
+        // Load the next eight bytes as one big endian word and keep as many
+        // whole bytes as fit behind the bits already in the accumulator. Any
+        // partial byte shifted in past n_ will be loaded again by the next
+        // refill, and or-ing identical bits is harmless.
+        auto word = be::big_uint64_buf_t{};
+        std::memcpy(static_cast<void*>(&word), data_, sizeof(word));
+        accum_ |= word.value() >> n_;
+        const auto bytes = (ACCUM_BITS - n_) / 8;
+        data_ += bytes;
+        len_ -= bytes;
+        n_ += bytes * 8;
+    } else {
+        while ((0 < len_) && (n_ <= (ACCUM_BITS - 8))) {
+            accum_ |= static_cast<std::uint64_t>(*data_++)
+                      << (ACCUM_BITS - 8 - n_);
+            --len_;
+            n_ += 8;
+        }
+    }
 }
 
 // output will contain the result after flush.
@@ -135,18 +480,14 @@ BitWriter::BitWriter(Data& output)
 void BitWriter::flush()
 {
     if (n_ > 0) {
-        // Assert n is smaller than 8 because if it were larger, it should
-        // already have been handled in the write function. Remember, n_ is
-        // the number of bits stored in accum_.
-        OT_ASSERT(n_ < 8);
-
-        auto result{static_cast<std::uint8_t>(accum_ & BITMASK(n_))};
-        result <<= (8 - n_);
+        auto bytes = std::array<std::uint8_t, sizeof(accum_)>{};
+        const auto count = (n_ + 7) / 8;
 
-        output_.Concatenate(&result, sizeof(result));
+        for (auto i = std::size_t{0}; i < count; ++i) {
+            bytes[i] = static_cast<std::uint8_t>(accum_ >> (56 - (8 * i)));
+        }
 
-        // Since we read all the n_ bits out of accum_, we set both back to
-        // 0.
+        output_.Concatenate(bytes.data(), count);
         n_ = 0;
         accum_ = 0;
     }
@@ -154,85 +495,177 @@ void BitWriter::flush()
 
 void BitWriter::write(std::size_t nbits, std::uint64_t value)
 {
-    // Let's say we're writing 19 bits. nbits starts at 19.
-    while (nbits) {
-        // nb is number of bits we'll actually write to accum_ before we're
-        // forced to flush accum_ to the output_ data member. n_ is the
-        // number of bits we have queued in the accum_ member, which will be
-        // concatenated to the output_ member on flush. Let's say there are
-        // 7 bits sitting in accum_ now, and so n_ would contain 7. (the bit
-        // count) and accum_ contains the 7 bits themselves. nb is the
-        // smaller of (64 - 7) and 19. Why? 64 bits minus 7 (57) represents
-        // the number of bits left in accum_ for writing to, before it runs
-        // out of space and would have to be flushed to the output_ variable
-        // OTData. Why do I care if 19 is smaller than 57? Well if I'm
-        // writing 19 bits, and there are 57 still available to write in
-        // before flushing, then I know I'm writing all 19 bits. But what if
-        // there were only 10 bits left in accum_ instead of 57? Then I
-        // could only write 10 of my 19 bits, before flushing to output_ and
-        // finally grabbing the last 9 bits into accum_, with n_ finally set
-        // to 9. Therefore, nb is the number of bits we'll ACTUALLY write
-        // before flushing to do the rest.
-
-        std::uint32_t nb = std::min(ACCUM_BITS - n_, nbits);
-
-        // Next we bitshift accum_ to make room for the new bits being
-        // written into it. Since nb is the number of bits actually being
-        // writte, that is how much we bitshift accum_.
-        accum_ <<= nb;
-
-        // Next we take the value being written, and bitmask it for the
-        // number of bits we're grabbing from it. For example, if we're
-        // writing 19 bits from 'value', then I bitmask that variable to
-        // only select out those 19 bits.
-        value &= BITMASK(nbits);
-
-        // accum_, already bitshifted to make space, has value added to its
-        // empty bits. Why (nbits - nb)? nbits is the number that I WANT to
-        // write, whereas nb is the actual available bits in accum_. If I
-        // want to write 19 (nbits), but nb available is 10, then 19-10 = 9.
-        // That's the number of bits we don't have room for yet. So here
-        // accum_ is OR'd with value right-shifted by 9 bits. We've cut off
-        // the 9 bits we don't have room for yet, leaving the bitmasked 10
-        // bits that we DO have room to write. Those are the bits that get
-        // OR'd into accum_.
-        accum_ |= value >> (nbits - nb);
-
-        // Since we have written 10 bits to accum_, then n_ is increased
-        // by 10.
-        n_ += nb;
-
-        // Since we have written nb bits to accum_, the number of bits we
-        // are TRYING to write (nbits) is decremented by nb. For example, 19
-        // bits (trying to write) is reduced by 10 bits (actually wrote)
-        // leaving 9 bits (remaining still to write).
-        nbits -= nb;
-
-        // BY THIS POINT, what we've done is either write ALL of our new
-        // bits to accum_, OR wrote as many as would fit.
-        while (n_ >= 8) {
-            // Why n_ - 8? n_ contains the number of bits in accum_. We know
-            // that it's at least 8 (or larger). Say there are 19 bits in
-            // accum_. n_ -8 would be 11. So accum_ is right-shifted 11 bits
-            // in order to get the most significant 8 bits first. Those 8
-            // bits are bitmasked and copied into result.
-            std::uint8_t result = (accum_ >> (n_ - 8)) & BITMASK(8);
-
-            // result is then concatenated to output_.
-            output_.Concatenate(&result, sizeof(result));
-            // n_ (the number of bits containing data in accum_) is
-            // decremented by 8, so from 19 to 11.
-            n_ -= 8;
-
-            // Here accum_ is bitmasked by n_, or say 11 bits. That's
-            // because the most significant 8 bits from the original 19 were
-            // already carved off and appended to our output_ data. The
-            // remaining 11 bits (n_ is 11) are the ones left in accum_.
-            accum_ &= BITMASK(n_);
+    OT_ASSERT(nbits <= ACCUM_BITS);
+
+    if (0 == nbits) { return; }
+
+    if (nbits < ACCUM_BITS) { value &= (std::uint64_t{1} << nbits) - 1; }
+
+    // n_ is always less than ACCUM_BITS so there is at least one free bit
+    const auto free = ACCUM_BITS - n_;
+
+    if (nbits < free) {
+        accum_ |= value << (free - nbits);
+        n_ += nbits;
+
+        return;
+    }
+
+    const auto remaining = nbits - free;
+    accum_ |= value >> remaining;
+    const auto word = be::big_uint64_buf_t{accum_};
+    output_.Concatenate(&word, sizeof(word));
+    accum_ = (0 < remaining) ? (value << (ACCUM_BITS - remaining)) : 0;
+    n_ = remaining;
+}
+
+void BitWriter::write_unary(std::uint64_t count)
+{
+    static const auto ones = ~std::uint64_t{0};
+
+    while (ACCUM_BITS <= count) {
+        write(ACCUM_BITS, ones);
+        count -= ACCUM_BITS;
+    }
+
+    // count 1 bits followed by the terminating 0 bit
+    write(count + 1, ((std::uint64_t{1} << count) - 1) << 1);
+}
+
+SipHasher::SipHasher(const ReadView key) noexcept(false)
+    : k0_()
+    , k1_()
+{
+    if (16 != key.size()) {
+        throw std::runtime_error(
+            "Invalid key size: " + std::to_string(key.size()));
+    }
+
+    k0_ = load_le(key.data());
+    k1_ = load_le(key.data() + sizeof(k0_));
+}
+
+std::uint64_t SipHasher::operator()(const ReadView item) const noexcept
+{
+    auto state = SipState{k0_, k1_};
+    const auto blocks = item.size() / 8;
+
+    for (auto i = std::size_t{0}; i < blocks; ++i) {
+        state.compress(load_le(item.data() + (8 * i)));
+    }
+
+    state.compress(state.last_block(item));
+
+    return state.finalize();
+}
+
+void SipHasher::Hash(const Items& items, Hashes& output) const noexcept
+{
+    auto state = std::array<SipState, lanes_>{};
+    auto common = std::numeric_limits<std::size_t>::max();
+
+    for (auto lane = std::size_t{0}; lane < lanes_; ++lane) {
+        state[lane] = SipState{k0_, k1_};
+        common = std::min(common, items[lane].size() / 8);
+    }
+
+    // The blocks which every lane has in common are compressed in lockstep so
+    // the independent lanes can be scheduled in parallel or vectorised
+    for (auto i = std::size_t{0}; i < common; ++i) {
+        auto block = Hashes{};
+
+        for (auto lane = std::size_t{0}; lane < lanes_; ++lane) {
+            block[lane] = load_le(items[lane].data() + (8 * i));
+            state[lane].v3_ ^= block[lane];
         }
+
+        for (auto round = 0; round < SipState::c_; ++round) {
+            for (auto& lane : state) { lane.round(); }
+        }
+
+        for (auto lane = std::size_t{0}; lane < lanes_; ++lane) {
+            state[lane].v0_ ^= block[lane];
+        }
+    }
+
+    for (auto lane = std::size_t{0}; lane < lanes_; ++lane) {
+        const auto& item = items[lane];
+        auto& current = state[lane];
+        const auto blocks = item.size() / 8;
+
+        for (auto i = common; i < blocks; ++i) {
+            current.compress(load_le(item.data() + (8 * i)));
+        }
+
+        current.compress(current.last_block(item));
+        current.v2_ ^= 0xff;
+    }
+
+    for (auto round = 0; round < SipState::d_; ++round) {
+        for (auto& lane : state) { lane.round(); }
+    }
+
+    for (auto lane = std::size_t{0}; lane < lanes_; ++lane) {
+        const auto& current = state[lane];
+        output[lane] = current.v0_ ^ current.v1_ ^ current.v2_ ^ current.v3_;
     }
 }
 
+void SipHasher::HashToRange(
+    const std::vector<OTData>& items,
+    const std::uint64_t range,
+    std::vector<std::uint64_t>& output) const noexcept
+{
+    output.clear();
+    output.reserve(items.size());
+    auto it = items.cbegin();
+    auto lanes = Items{};
+    auto hashes = Hashes{};
+
+    while (lanes_ <= static_cast<std::size_t>(std::distance(it, items.cend()))) {
+        for (auto& lane : lanes) { lane = (*it++)->Bytes(); }
+
+        Hash(lanes, hashes);
+
+        for (const auto& hash : hashes) {
+            output.emplace_back(Reduce(hash, range));
+        }
+    }
+
+    for (; it != items.cend(); ++it) {
+        output.emplace_back(Reduce((*this)((*it)->Bytes()), range));
+    }
+}
+
+std::uint64_t SipHasher::Reduce(
+    const std::uint64_t hash,
+    const std::uint64_t range) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ using uint128 = unsigned __int128;
+
+    return static_cast<std::uint64_t>(
+        (static_cast<uint128>(hash) * static_cast<uint128>(range)) >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return __umulh(hash, range);
+#else
+    // Decompose the 64 bit multiplication into four 32 bit multiplications
+    // and recombine only the upper half of the result
+    static const auto mask = std::uint64_t{0xffffffff};
+    const auto aLow = hash & mask;
+    const auto aHigh = hash >> 32;
+    const auto bLow = range & mask;
+    const auto bHigh = range >> 32;
+    const auto low = aLow * bLow;
+    const auto middleA = aLow * bHigh;
+    const auto middleB = aHigh * bLow;
+    const auto high = aHigh * bHigh;
+    const auto carry = ((low >> 32) + (middleA & mask) + (middleB & mask)) >> 32;
+
+    return high + (middleA >> 32) + (middleB >> 32) + carry;
+#endif
+}
+
 SerializedBloomFilter::SerializedBloomFilter(
     const std::uint32_t tweak,
     const BloomUpdateFlag update,
@@ -349,6 +782,21 @@ auto Deserialize(const api::Core& api, const ReadView in) noexcept
     return output;
 }
 
+auto DoubleSha256(const std::initializer_list<ReadView> segments) noexcept
+    -> Sha256Digest
+{
+    auto first = Sha256{};
+
+    for (const auto& segment : segments) { first.Update(segment); }
+
+    const auto digest = first.Finalize();
+    auto second = Sha256{};
+    second.Update(
+        ReadView{reinterpret_cast<const char*>(digest.data()), digest.size()});
+
+    return second.Finalize();
+}
+
 auto FilterHashToHeader(
     const api::Core& api,
     const ReadView hash,
@@ -391,6 +839,13 @@ auto FilterToHeader(
         api, FilterToHash(api, filter)->Bytes(), previous);
 }
 
+auto GCSTargets(const std::vector<OTData>& elements) noexcept -> GCS::Targets
+{
+    const auto unique = std::set<OTData>{elements.begin(), elements.end()};
+
+    return GCS::Targets{unique.begin(), unique.end()};
+}
+
 auto Grind(const std::function<void()> function) noexcept -> void
 {
     auto threads = std::vector<std::thread>{};
@@ -402,6 +857,69 @@ auto Grind(const std::function<void()> function) noexcept -> void
     for (auto& thread : threads) { thread.join(); }
 }
 
+auto MerkleRoot(std::vector<Sha256Digest> level) noexcept
+    -> std::optional<Sha256Digest>
+{
+    if (level.empty()) { return {}; }
+
+    auto next = std::vector<Sha256Digest>{};
+
+    while (1 < level.size()) {
+        // A duplicated final pair yields the same root as the shorter tree
+        // (CVE-2012-2459), so such trees are rejected as malleated
+        for (auto i = std::size_t{0}; (i + 1) < level.size(); i += 2) {
+            if (level[i] == level[i + 1]) { return {}; }
+        }
+
+        if (1 == (level.size() % 2)) { level.emplace_back(level.back()); }
+
+        const auto count = level.size() / 2;
+        next.resize(count);
+        const auto* input = level.front().data();
+        auto* output = next.front().data();
+        const auto minimum = (parallel_nodes_ <= count) ? parallel_nodes_ / 4
+                                                        : count;
+        Parallel(count, minimum, [&](const auto begin, const auto end) {
+            merkle_level(
+                input + (64 * begin), output + (32 * begin), end - begin);
+        });
+        std::swap(level, next);
+    }
+
+    return level.front();
+}
+
+auto Parallel(
+    const std::size_t count,
+    const std::size_t minimum,
+    const std::function<void(std::size_t, std::size_t)>& job) noexcept -> void
+{
+    const auto threads = std::max<std::size_t>(
+        1,
+        std::min<std::size_t>(
+            std::thread::hardware_concurrency(),
+            count / std::max<std::size_t>(minimum, 1)));
+
+    if (1 == threads) {
+        job(0, count);
+
+        return;
+    }
+
+    const auto chunk = (count + threads - 1) / threads;
+    auto futures = std::vector<std::future<void>>{};
+    futures.reserve(threads - 1);
+
+    for (auto begin = chunk; begin < count; begin += chunk) {
+        futures.emplace_back(std::async(
+            std::launch::async, job, begin, std::min(count, begin + chunk)));
+    }
+
+    job(0, std::min(count, chunk));
+
+    for (auto& future : futures) { future.get(); }
+}
+
 auto Serialize(const Type chain, const filter::Type type) noexcept(false)
     -> std::uint8_t
 {
@@ -486,4 +1004,3 @@ auto DisplayService(const Service service) noexcept -> std::string
     }
 }
 }  // namespace opentxs::blockchain::p2p
-#undef BITMASK
@@ -0,0 +1,260 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "stdafx.hpp"
+
+#include "Internal.hpp"
+
+#include "opentxs/api/crypto/Hash.hpp"
+#include "opentxs/api/crypto/Crypto.hpp"
+#include "opentxs/api/Core.hpp"
+#include "opentxs/blockchain/BloomFilter.hpp"
+#include "opentxs/core/Data.hpp"
+
+#include "internal/api/Api.hpp"
+#include "internal/blockchain/Blockchain.hpp"
+
+#include <boost/endian/buffers.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include "BlockedBloomFilter.hpp"
+
+namespace opentxs
+{
+blockchain::BloomFilter* Factory::BlockedBloomFilter(
+    const api::internal::Core& api,
+    const std::uint32_t tweak,
+    const std::size_t targets,
+    const double fpRate)
+{
+    using ReturnType = blockchain::implementation::BlockedBloomFilter;
+
+    return new ReturnType(api, tweak, targets, fpRate);
+}
+
+blockchain::BloomFilter* Factory::BlockedBloomFilter(
+    const api::internal::Core& api,
+    const Data& serialized)
+{
+    using ReturnType = blockchain::implementation::BlockedBloomFilter;
+    using Block = std::array<be::little_uint64_buf_t, 8>;
+    blockchain::internal::SerializedBloomFilter raw{};
+
+    if (sizeof(raw) > serialized.size()) {
+        LogOutput("opentxs::Factory::")(__FUNCTION__)(": Input too short")
+            .Flush();
+
+        return nullptr;
+    }
+
+    const auto filterSize = serialized.size() - sizeof(raw);
+
+    if ((0 == filterSize) || (0 != (filterSize % sizeof(Block)))) {
+        LogOutput("opentxs::Factory::")(__FUNCTION__)(
+            ": Filter is not a whole number of blocks")
+            .Flush();
+
+        return nullptr;
+    }
+
+    const auto* it = static_cast<const std::byte*>(serialized.data());
+    std::memcpy(
+        reinterpret_cast<std::byte*>(&raw), it + filterSize, sizeof(raw));
+    const auto functionCount = std::size_t{raw.function_count_.value()};
+
+    if ((0 == functionCount) ||
+        (ReturnType::max_hash_function_count_ < functionCount)) {
+        LogOutput("opentxs::Factory::")(__FUNCTION__)(
+            ": Invalid hash function count")
+            .Flush();
+
+        return nullptr;
+    }
+
+    auto filter = ReturnType::Filter(filterSize / sizeof(Block));
+
+    for (auto& block : filter) {
+        auto words = Block{};
+        std::memcpy(static_cast<void*>(words.data()), it, sizeof(words));
+        it += sizeof(words);
+        std::transform(
+            words.begin(),
+            words.end(),
+            block.words_.begin(),
+            [](const auto& word) { return word.value(); });
+    }
+
+    return new ReturnType(api, raw.tweak_.value(), functionCount, filter);
+}
+}  // namespace opentxs
+
+namespace opentxs::blockchain::implementation
+{
+const std::size_t BlockedBloomFilter::max_filter_bytes_ = 36000;
+const std::size_t BlockedBloomFilter::max_hash_function_count_ = 16;
+
+BlockedBloomFilter::BlockedBloomFilter(
+    const api::internal::Core& api,
+    const Tweak tweak,
+    const std::size_t functionCount,
+    const Filter& data) noexcept
+    : blockchain::BloomFilter()
+    , api_(api)
+    , tweak_(tweak)
+    , function_count_(functionCount)
+    , filter_(data)
+{
+}
+
+BlockedBloomFilter::BlockedBloomFilter(
+    const api::internal::Core& api,
+    const Tweak tweak,
+    const std::size_t targets,
+    const FalsePositiveRate rate) noexcept
+    : BlockedBloomFilter(api, tweak, 0, Filter(std::size_t(1)))
+{
+    const auto elements =
+        static_cast<double>(std::max(targets, std::size_t(1)));
+    const auto ideal_bits = static_cast<std::size_t>(
+        ((-1) / (std::pow(std::log(2), 2)) * elements * std::log(rate)));
+    const auto max_blocks = (max_filter_bytes_ * 8) / block_bits_;
+    const auto blocks = std::clamp(
+        (ideal_bits + block_bits_ - 1) / block_bits_,
+        std::size_t(1),
+        max_blocks);
+    filter_.resize(blocks);
+
+    // Optimal number of hash functions for the rounded filter size
+    const auto precalc_hash_function_count = static_cast<std::size_t>(
+        std::lround((blocks * block_bits_) / elements * std::log(2)));
+    function_count_ = std::clamp(
+        precalc_hash_function_count,
+        std::size_t(1),
+        max_hash_function_count_);
+}
+
+BlockedBloomFilter::BlockedBloomFilter(const BlockedBloomFilter& rhs) noexcept
+    : BlockedBloomFilter(
+          rhs.api_,
+          rhs.tweak_,
+          rhs.function_count_,
+          rhs.filter_)
+{
+}
+
+void BlockedBloomFilter::AddElement(const Data& in) noexcept
+{
+    const auto hash = this->hash(in.Bytes());
+    const auto bits = mask(hash);
+    auto& block = filter_.at(index(hash));
+
+    for (std::size_t i{0}; i < block_words_; ++i) {
+        block.words_[i] |= bits.words_[i];
+    }
+}
+
+bool BlockedBloomFilter::contains(
+    const Block& block,
+    const Block& mask) noexcept
+{
+    // Accumulate without branching so the loop compiles to a few vector
+    // instructions
+    auto missing = std::uint64_t{0};
+
+    for (std::size_t i{0}; i < block_words_; ++i) {
+        missing |= mask.words_[i] & ~block.words_[i];
+    }
+
+    return 0 == missing;
+}
+
+BlockedBloomFilter::Hash BlockedBloomFilter::hash(const ReadView element) const
+    noexcept
+{
+    auto output = Hash{};
+    api_.Crypto().Hash().MurmurHash3_128(tweak_, element, output);
+
+    return output;
+}
+
+std::size_t BlockedBloomFilter::index(const Hash& hash) const noexcept
+{
+    return static_cast<std::size_t>(
+        internal::SipHasher::Reduce(hash[0], filter_.size()));
+}
+
+BlockedBloomFilter::Block BlockedBloomFilter::mask(const Hash& hash) const
+    noexcept
+{
+    // Kirsch-Mitzenmacher double hashing. An odd stride visits distinct bit
+    // positions for any function count up to the block size.
+    const auto start = static_cast<std::uint32_t>(hash[1]);
+    const auto stride = static_cast<std::uint32_t>(hash[1] >> 32) | 1u;
+    auto output = Block{};
+
+    for (std::size_t i{0}; i < function_count_; ++i) {
+        const auto bit =
+            (start + static_cast<std::uint32_t>(i) * stride) % block_bits_;
+        output.words_[bit / 64] |= std::uint64_t{1} << (bit % 64);
+    }
+
+    return output;
+}
+
+OTData BlockedBloomFilter::Serialize() const noexcept
+{
+    auto output = Data::Factory();
+
+    for (const auto& block : filter_) {
+        for (const auto& word : block.words_) {
+            const auto buffer = be::little_uint64_buf_t{word};
+            output->Concatenate(&buffer, sizeof(buffer));
+        }
+    }
+
+    blockchain::internal::SerializedBloomFilter raw{
+        tweak_, BloomUpdateFlag::None, function_count_};
+    output->Concatenate(&raw, sizeof(raw));
+
+    return output;
+}
+
+bool BlockedBloomFilter::Test(const Data& in) const noexcept
+{
+    const auto hash = this->hash(in.Bytes());
+
+    return contains(filter_.at(index(hash)), mask(hash));
+}
+
+bool BlockedBloomFilter::Test(const std::vector<OTData>& elements) const
+    noexcept
+{
+    // Hash a batch of elements before touching the filter so the loads for
+    // every block in the batch are in flight at the same time
+    auto blocks = std::array<const Block*, batch_size_>{};
+    auto masks = std::array<Block, batch_size_>{};
+
+    for (std::size_t i{0}; i < elements.size(); i += batch_size_) {
+        const auto count = std::min(batch_size_, elements.size() - i);
+
+        for (std::size_t j{0}; j < count; ++j) {
+            const auto hash = this->hash(elements[i + j]->Bytes());
+            blocks[j] = &filter_[index(hash)];
+            masks[j] = mask(hash);
+        }
+
+        for (std::size_t j{0}; j < count; ++j) {
+            if (contains(*blocks[j], masks[j])) { return true; }
+        }
+    }
+
+    return false;
+}
+}  // namespace opentxs::blockchain::implementation
@@ -0,0 +1,86 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace opentxs::blockchain::implementation
+{
+/** Bloom filter which keeps all the bits for an element in one cache line
+ *
+ *  Every element is hashed once with MurmurHash3_x64_128. The first half of
+ *  the hash selects a 512 bit block and the second half generates the bit
+ *  positions within that block by double hashing, so a test touches exactly
+ *  one cache line regardless of the number of hash functions.
+ *
+ *  The serialized form is not a BIP37 filter and must not be sent to peers
+ *  in a filterload message. Use BloomFilter for that purpose.
+ */
+class BlockedBloomFilter final : virtual public blockchain::BloomFilter
+{
+public:
+    OTData Serialize() const noexcept final;
+    bool Test(const Data& element) const noexcept final;
+    bool Test(const std::vector<OTData>& elements) const noexcept final;
+
+    void AddElement(const Data& element) noexcept final;
+
+    ~BlockedBloomFilter() final = default;
+
+private:
+    friend opentxs::Factory;
+
+    static constexpr std::size_t block_words_{8};
+    static constexpr std::size_t block_bits_{block_words_ * 64};
+    // Number of elements hashed before any of their blocks are tested
+    static constexpr std::size_t batch_size_{16};
+
+    struct alignas(64) Block {
+        std::array<std::uint64_t, block_words_> words_{};
+    };
+
+    using FalsePositiveRate = double;
+    using Filter = std::vector<Block>;
+    using Hash = std::array<std::uint64_t, 2>;
+    using Tweak = std::uint32_t;
+
+    static const std::size_t max_filter_bytes_;
+    static const std::size_t max_hash_function_count_;
+
+    const api::internal::Core& api_;
+    Tweak tweak_{};
+    std::size_t function_count_{};
+    Filter filter_;
+
+    static bool contains(const Block& block, const Block& mask) noexcept;
+
+    BlockedBloomFilter* clone() const noexcept final
+    {
+        return new BlockedBloomFilter(*this);
+    }
+    Hash hash(const ReadView element) const noexcept;
+    std::size_t index(const Hash& hash) const noexcept;
+    Block mask(const Hash& hash) const noexcept;
+
+    BlockedBloomFilter(
+        const api::internal::Core& api,
+        const Tweak tweak,
+        const std::size_t functionCount,
+        const Filter& data) noexcept;
+    BlockedBloomFilter(
+        const api::internal::Core& api,
+        const Tweak tweak,
+        const std::size_t targets,
+        const FalsePositiveRate rate) noexcept;
+    BlockedBloomFilter() = delete;
+    BlockedBloomFilter(const BlockedBloomFilter& rhs) noexcept;
+    BlockedBloomFilter(BlockedBloomFilter&&) = delete;
+    BlockedBloomFilter& operator=(const BlockedBloomFilter&) = delete;
+    BlockedBloomFilter& operator=(BlockedBloomFilter&&) = delete;
+};
+}  // namespace opentxs::blockchain::implementation
@@ -194,4 +194,13 @@ bool BloomFilter::Test(const Data& in) const noexcept
 
     return true;
 }
+
+bool BloomFilter::Test(const std::vector<OTData>& elements) const noexcept
+{
+    for (const auto& element : elements) {
+        if (Test(element)) { return true; }
+    }
+
+    return false;
+}
 }  // namespace opentxs::blockchain::implementation
@@ -18,6 +18,7 @@ class BloomFilter final : virtual public blockchain::BloomFilter
 public:
     OTData Serialize() const noexcept final;
     bool Test(const Data& element) const noexcept final;
+    bool Test(const std::vector<OTData>& elements) const noexcept final;
 
     void AddElement(const Data& element) noexcept final;
 
@@ -61,7 +61,8 @@ ReadView tsv(const Input& in) noexcept
     return {reinterpret_cast<const char*>(&in), sizeof(in)};
 }
 
-const std::size_t Database::db_version_{1};
+// Version 2 adds flat header records
+const std::size_t Database::db_version_{2};
 const opentxs::storage::lmdb::TableNames Database::table_names_{
     {Config, "config"},
     {BlockHeaderMetadata, "block_header_metadata"},
@@ -71,6 +72,7 @@ const opentxs::storage::lmdb::TableNames Database::table_names_{
     {BlockHeaderDisconnected, "disconnected_block_headers"},
     {BlockFilterBest, "filter_tips"},
     {BlockFilterHeaderBest, "filter_header_tips"},
+    {BlockHeaderFlat, "block_headers_flat"},
 };
 
 const std::map<
@@ -125,7 +127,8 @@ Database::Database(
            {BlockHeaderSiblings, 0},
            {BlockHeaderDisconnected, MDB_DUPSORT},
            {BlockFilterBest, MDB_INTEGERKEY},
-           {BlockFilterHeaderBest, MDB_INTEGERKEY}},
+           {BlockFilterHeaderBest, MDB_INTEGERKEY},
+           {BlockHeaderFlat, 0}},
           0)
     , filters_(api, common_, lmdb_, type)
     , headers_(api, network, common_, lmdb_, type)
@@ -408,6 +411,18 @@ auto Database::Headers::ApplyUpdate(
 
             return false;
         }
+
+        const auto flat = block::internal::Flatten(*header);
+
+        if (false ==
+            lmdb_.Store(BlockHeaderFlat, hash->Bytes(), tsv(flat), parentTxn)
+                .first) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Failed to save flat block header")
+                .Flush();
+
+            return false;
+        }
     }
 
     if (update.HaveReorg()) {
@@ -617,12 +632,19 @@ auto Database::Headers::import_genesis(const blockchain::Type type) const
 
             OT_ASSERT(genesis);
 
-            const auto result = lmdb_.Store(
+            auto result = lmdb_.Store(
                 BlockHeaderMetadata,
                 hash.Bytes(),
                 proto::ToString(genesis->Serialize().local()));
 
             OT_ASSERT(result.first);
+
+            result = lmdb_.Store(
+                BlockHeaderFlat,
+                hash.Bytes(),
+                tsv(block::internal::Flatten(*genesis)));
+
+            OT_ASSERT(result.first);
         }
     } catch (...) {
         auto genesis = std::unique_ptr<blockchain::block::Header>{
@@ -642,6 +664,15 @@ auto Database::Headers::import_genesis(const blockchain::Type type) const
                       .first;
 
         OT_ASSERT(success);
+
+        success = lmdb_
+                      .Store(
+                          BlockHeaderFlat,
+                          hash.Bytes(),
+                          tsv(block::internal::Flatten(*genesis)))
+                      .first;
+
+        OT_ASSERT(success);
     }
 
     if (0 > best().first) {
@@ -656,6 +687,70 @@ auto Database::Headers::import_genesis(const blockchain::Type type) const
     }
 }
 
+auto Database::Headers::ImportFlatHeaders() const noexcept -> bool
+{
+    using Record = std::pair<std::string, block::internal::FlatHeader>;
+
+    constexpr auto batch = std::size_t{10000};
+    auto hashes = std::vector<std::string>{};
+    lmdb_.Read(
+        BlockHeaderMetadata,
+        [&](const auto key, const auto) -> bool {
+            hashes.emplace_back(key);
+
+            return true;
+        },
+        opentxs::storage::lmdb::LMDB::Dir::Forward);
+    auto records = std::vector<Record>{};
+    records.reserve(std::min(batch, hashes.size()));
+
+    for (auto i = hashes.cbegin(); i != hashes.cend();) {
+        records.clear();
+
+        // Records must be loaded before the write transaction is opened
+        for (; (i != hashes.cend()) && (batch > records.size()); ++i) {
+            try {
+                const auto header = load_header_proto(
+                    api_.Factory().Data(*i, StringStyle::Raw));
+                records.emplace_back(*i, block::internal::Flatten(*header));
+            } catch (...) {
+                LogOutput(OT_METHOD)(__FUNCTION__)(
+                    ": Failed to load block header")
+                    .Flush();
+            }
+        }
+
+        auto parentTxn = lmdb_.TransactionRW();
+
+        for (const auto& [hash, flat] : records) {
+            if (false ==
+                lmdb_.Store(BlockHeaderFlat, hash, tsv(flat), parentTxn)
+                    .first) {
+                return false;
+            }
+        }
+
+        if (false == parentTxn.Finalize(true)) { return false; }
+    }
+
+    return true;
+}
+
+auto Database::Headers::IsBestBlock(
+    const block::Height position,
+    const ReadView hash) const noexcept -> bool
+{
+    if (0 > position) { return false; }
+
+    auto output{false};
+    lmdb_.Load(
+        BlockHeaderBest,
+        tsv(static_cast<std::size_t>(position)),
+        [&](const auto in) -> void { output = (in == hash); });
+
+    return output;
+}
+
 auto Database::Headers::IsSibling(const block::Hash& hash) const noexcept
     -> bool
 {
@@ -666,6 +761,24 @@ auto Database::Headers::IsSibling(const block::Hash& hash) const noexcept
 
 auto Database::Headers::load_header(const block::Hash& hash) const
     -> std::unique_ptr<block::Header>
+{
+    auto output = std::unique_ptr<block::Header>{};
+    lmdb_.Load(BlockHeaderFlat, hash.Bytes(), [&](const auto in) -> void {
+        const auto view = block::internal::FlatHeaderView::Parse(in);
+
+        if (view && view.BitcoinFormat()) {
+            output.reset(
+                opentxs::Factory::BitcoinBlockHeader(api_, hash, view));
+        }
+    });
+
+    if (output) { return output; }
+
+    return load_header_proto(hash);
+}
+
+auto Database::Headers::load_header_proto(const block::Hash& hash) const
+    -> std::unique_ptr<block::Header>
 {
     auto proto = common_.LoadBlockHeader(hash);
     const auto haveMeta =
@@ -684,6 +797,24 @@ auto Database::Headers::load_header(const block::Hash& hash) const
     return output;
 }
 
+auto Database::Headers::LoadHeaderView(
+    const ReadView hash,
+    const client::internal::HeaderDatabase::HeaderView cb) const noexcept
+    -> bool
+{
+    auto output{false};
+    lmdb_.Load(BlockHeaderFlat, hash, [&](const auto in) -> void {
+        const auto view = block::internal::FlatHeaderView::Parse(in);
+
+        if (view) {
+            cb(view);
+            output = true;
+        }
+    });
+
+    return output;
+}
+
 auto Database::Headers::pop_best(const std::size_t i, MDB_txn* parent) const
     noexcept -> bool
 {
@@ -697,11 +828,15 @@ auto Database::Headers::push_best(
 {
     OT_ASSERT(nullptr != parent);
 
+    const auto key = static_cast<std::size_t>(next.first);
+    // Best chain entries are almost always written above the current tip
     auto output = lmdb_.Store(
-        BlockHeaderBest,
-        tsv(static_cast<std::size_t>(next.first)),
-        next.second->Bytes(),
-        parent);
+        BlockHeaderBest, tsv(key), next.second->Bytes(), parent, MDB_APPEND);
+
+    if ((false == output.first) && (MDB_KEYEXIST == output.second)) {
+        output = lmdb_.Store(
+            BlockHeaderBest, tsv(key), next.second->Bytes(), parent);
+    }
 
     if (output.first && setTip) {
         output = lmdb_.Store(
@@ -766,7 +901,23 @@ auto Database::Headers::TryLoadHeader(const block::Hash& hash) const noexcept
 
 auto Database::init_db() noexcept -> void
 {
-    if (false == lmdb_.Exists(Config, tsv(Key::Version))) {
+    auto version = std::size_t{0};
+    const auto exists =
+        lmdb_.Load(Config, tsv(Key::Version), [&](const auto in) -> void {
+            std::memcpy(
+                &version, in.data(), std::min(in.size(), sizeof(version)));
+        });
+
+    if (exists && (2 > version)) {
+        LogNormal(blockchain::internal::DisplayString(chain_))(
+            " upgrading header database")
+            .Flush();
+        const auto imported = headers_.ImportFlatHeaders();
+
+        OT_ASSERT(imported);
+    }
+
+    if ((false == exists) || (db_version_ > version)) {
         const auto stored =
             lmdb_.Store(Config, tsv(Key::Version), tsv(db_version_));
 
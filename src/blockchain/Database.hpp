@@ -51,9 +51,11 @@ public:
     Address Get(
         const Protocol protocol,
         const std::set<Type> onNetworks,
-        const std::set<Service> withServices) const noexcept final
+        const std::set<Service> withServices,
+        const std::set<OTIdentifier>& exclude) const noexcept final
     {
-        return common_.Find(chain_, protocol, onNetworks, withServices);
+        return common_.Find(
+            chain_, protocol, onNetworks, withServices, exclude);
     }
     bool HasDisconnectedChildren(const block::Hash& hash) const noexcept final
     {
@@ -81,10 +83,21 @@ public:
     {
         return common_.Import(std::move(peers));
     }
+    bool IsBestBlock(const block::Height position, const ReadView hash) const
+        noexcept final
+    {
+        return headers_.IsBestBlock(position, hash);
+    }
     bool IsSibling(const block::Hash& hash) const noexcept final
     {
         return headers_.IsSibling(hash);
     }
+    std::unique_ptr<const blockchain::internal::GCS> LoadFilter(
+        const filter::Type type,
+        const ReadView block) const noexcept final
+    {
+        return filters_.LoadFilter(type, block);
+    }
     Hash LoadFilterHash(const filter::Type type, const ReadView block) const
         noexcept final
     {
@@ -101,10 +114,21 @@ public:
     {
         return headers_.LoadHeader(hash);
     }
+    bool LoadHeaderView(const ReadView hash, const HeaderView cb) const
+        noexcept final
+    {
+        return headers_.LoadHeaderView(hash, cb);
+    }
     std::vector<block::pHash> RecentHashes() const noexcept final
     {
         return headers_.RecentHashes();
     }
+    bool Score(
+        const Identifier& address,
+        const client::internal::PeerScore& session) const noexcept final
+    {
+        return common_.Score(address, session);
+    }
     bool SetFilterHeaderTip(
         const filter::Type type,
         const block::Position position) const noexcept final
@@ -164,6 +188,12 @@ private:
         {
             return common_.HaveFilterHeader(type, block.Bytes());
         }
+        std::unique_ptr<const blockchain::internal::GCS> LoadFilter(
+            const filter::Type type,
+            const ReadView block) const noexcept
+        {
+            return common_.LoadFilter(type, block);
+        }
         Hash LoadFilterHash(const filter::Type type, const ReadView block) const
             noexcept;
         Hash LoadFilterHeader(const filter::Type type, const ReadView block)
@@ -220,12 +250,20 @@ private:
         bool HaveCheckpoint() const noexcept;
         bool HeaderExists(const block::Hash& hash) const noexcept;
         void import_genesis(const blockchain::Type type) const noexcept;
+        // Writes a flat record for every header stored by earlier versions
+        bool ImportFlatHeaders() const noexcept;
+        bool IsBestBlock(const block::Height position, const ReadView hash)
+            const noexcept;
         bool IsSibling(const block::Hash& hash) const noexcept;
         // Throws std::out_of_range if the header does not exist
         std::unique_ptr<block::Header> LoadHeader(const block::Hash& hash) const
         {
             return load_header(hash);
         }
+        bool LoadHeaderView(
+            const ReadView hash,
+            const client::internal::HeaderDatabase::HeaderView cb) const
+            noexcept;
         std::vector<block::pHash> RecentHashes() const noexcept;
         client::Hashes SiblingHashes() const noexcept;
         // Returns null pointer if the header does not exist
@@ -256,6 +294,8 @@ private:
         // Throws std::out_of_range if the header does not exist
         std::unique_ptr<block::Header> load_header(
             const block::Hash& hash) const noexcept(false);
+        std::unique_ptr<block::Header> load_header_proto(
+            const block::Hash& hash) const noexcept(false);
         bool pop_best(const std::size_t i, MDB_txn* parent) const noexcept;
         bool push_best(
             const block::Position next,
@@ -274,6 +314,7 @@ private:
         BlockHeaderDisconnected = 5,
         BlockFilterBest = 6,
         BlockFilterHeaderBest = 7,
+        BlockHeaderFlat = 8,
     };
 
     enum class Key : std::size_t {
@@ -7,10 +7,7 @@
 
 #include "Internal.hpp"
 
-#include "opentxs/api/crypto/Hash.hpp"
-#include "opentxs/api/crypto/Crypto.hpp"
 #include "opentxs/api/Core.hpp"
-#include "opentxs/core/crypto/OTPassword.hpp"
 #include "opentxs/core/Data.hpp"
 #include "opentxs/core/Log.hpp"
 
@@ -18,22 +15,16 @@
 #include "internal/api/Api.hpp"
 #include "internal/blockchain/Blockchain.hpp"
 
-#include <boost/endian/buffers.hpp>
-#include <boost/multiprecision/cpp_int.hpp>
-
+#include <algorithm>
 #include <array>
 #include <cstdint>
-#include <set>
 #include <vector>
 
 #include "GCS.hpp"
 
 //#define OT_METHOD "opentxs::blockchain::implementation::GCS::"
 
-namespace be = boost::endian;
-namespace mp = boost::multiprecision;
-
-#define BITMASK(n) ((1 << (n)) - 1)
+#define BITMASK(n) ((std::uint64_t{1} << (n)) - 1)
 
 namespace opentxs
 {
@@ -117,13 +108,10 @@ GCS::GCS(
     , bits_(bits)
     , false_positive_rate_(fpRate)
     , key_(key)
+    , hasher_(key_->Bytes())
     , filter_elements_(filterElementCount)
     , filter_(filter)
 {
-    if (16 != key_->size()) {
-        throw std::runtime_error(
-            "Invalid key size: " + std::to_string(key_->size()));
-    }
 }
 
 GCS::GCS(
@@ -137,21 +125,24 @@ GCS::GCS(
           fpRate,
           key,
           elements.size(),
-          build_gcs(api, bits, fpRate, key, elements))
+          build_gcs(bits, fpRate, key, elements))
 {
 }
 
 auto GCS::build_gcs(
-    const api::internal::Core& api,
     const std::uint32_t bits,
     const std::uint32_t fpRate,
     const Data& key,
-    const std::vector<OTData>& elements) noexcept -> OTData
+    const std::vector<OTData>& elements) noexcept(false) -> OTData
 {
     auto output = Data::Factory();
-
-    const auto items =
-        hashed_set_construct(api, fpRate, elements.size(), key, elements);
+    auto items = Scratch{};
+    hashed_set_construct(
+        internal::SipHasher{key.Bytes()},
+        fpRate,
+        elements.size(),
+        elements,
+        items);
 
     BitWriter stream(output);
     std::uint64_t last_value{0};
@@ -179,14 +170,10 @@ auto GCS::Encode() const noexcept -> OTData
 
 auto GCS::golomb_decode(BitReader& stream) const noexcept -> std::uint64_t
 {
-    std::uint64_t quotient{0};
-
-    while (stream.read(1) == 1) { quotient++; }
+    const auto quotient = stream.read_unary();
+    const auto remainder = stream.read(bits_);
 
-    auto remainder = stream.read(bits_);
-    std::uint64_t return_value = (quotient << bits_) + remainder;
-
-    return return_value;
+    return (quotient << bits_) + remainder;
 }
 
 auto GCS::golomb_encode(
@@ -196,17 +183,12 @@ auto GCS::golomb_encode(
 {
     // With Golomb-Rice, a value is split into a Quotient and Remainder modulo
     // 2^P, which are encoded separately.
-    std::uint64_t remainder = value & BITMASK(bits);
-    std::uint64_t quotient = (value - (remainder)) >> bits;
+    const std::uint64_t remainder = value & BITMASK(bits);
+    const std::uint64_t quotient = value >> bits;
 
     // The quotient q is encoded as unary, with a string of q 1's followed by
     // one 0.
-    while (quotient > 0) {
-        stream.write(1, 1);
-        quotient--;
-    }
-
-    stream.write(1, 0);
+    stream.write_unary(quotient);
     // The remainder R is represented in big-endian by P bits.
     //
     // http://chinaober.com/github_/bitcoin/bips/commit/fcb7aeb7e28b78ecf6d145163e9559d01628e2d8
@@ -219,11 +201,8 @@ auto GCS::Hash() const noexcept -> OTData
     return internal::FilterToHash(api_, Encode()->Bytes());
 }
 
-auto GCS::hash_to_range(
-    const api::internal::Core& api,
-    const Data& key,
-    const std::uint64_t maxRange,
-    const Data& item) noexcept -> std::uint64_t
+auto GCS::hash_to_range(const Data& item, const std::uint64_t maxRange) const
+    noexcept -> std::uint64_t
 {
     /*
      The items are first passed through the pseudorandom function SipHash, which
@@ -231,11 +210,6 @@ auto GCS::hash_to_range(
      uniformly random 64-bit output. Implementations of this BIP MUST use the
      SipHash parameters c = 2 and d = 4.
      */
-    mp::uint128_t siphash_128 = (siphash(api, key, item));
-    mp::uint128_t maxrange_128 = (maxRange);
-    mp::uint128_t multiplied = siphash_128 * maxrange_128;
-    mp::uint128_t bitshifted = (multiplied >> 64);
-    auto return64 = bitshifted.convert_to<std::uint64_t>();
 
     // let item = (siphash(key, target) * (N * (1 << fp))) >> 64
     // NOTICE The above commented code...we multiply the hash output
@@ -264,13 +238,7 @@ auto GCS::hash_to_range(
      four 32-bit multiplications and recombines into the result.
      */
 
-    return return64;
-}
-
-auto GCS::hash_to_range(const Data& item, const std::uint64_t maxRange) const
-    noexcept -> std::uint64_t
-{
-    return hash_to_range(api_, key_, maxRange, item);
+    return internal::SipHasher::Reduce(hasher_(item.Bytes()), maxRange);
 }
 
 /*
@@ -281,11 +249,11 @@ auto GCS::hash_to_range(const Data& item, const std::uint64_t maxRange) const
  P is the bit length of the remainder code. It's the bits_ member variable.
  */
 auto GCS::hashed_set_construct(
-    const api::internal::Core& api,
+    const internal::SipHasher& hasher,
     const std::uint32_t fpRate,
     const std::size_t elementCount,
-    const Data& key,
-    const std::vector<OTData>& elements) noexcept -> std::set<std::uint64_t>
+    const std::vector<OTData>& elements,
+    Scratch& output) noexcept -> void
 {
     // Original spec says: let F = N * M
     //  matches other items with probability 1/M for some integer parameter M
@@ -293,21 +261,41 @@ auto GCS::hashed_set_construct(
     // P a value which is computed as 1/fp where fp is the desired false
     // positive rate.
     const std::uint64_t maxRange = elementCount * fpRate;
-    std::set<std::uint64_t> set_items;  // hash values sorted ascending
+    hasher.HashToRange(elements, maxRange, output);
+    // hash values sorted ascending
+    std::sort(output.begin(), output.end());
+    output.erase(std::unique(output.begin(), output.end()), output.end());
+}
 
-    for (const auto& item : elements) {
-        const std::uint64_t set_value = hash_to_range(api, key, maxRange, item);
-        set_items.insert(set_value);
-    }
+auto GCS::Match(const Targets& targets, Scratch& scratch) const noexcept
+    -> bool
+{
+    if (0 == targets.size()) { return false; }
+
+    hashed_set_construct(
+        hasher_, false_positive_rate_, filter_elements_, targets, scratch);
 
-    return set_items;
+    return match(scratch);
 }
 
-auto GCS::hashed_set_construct(const std::vector<OTData>& elements) const
-    noexcept -> std::set<std::uint64_t>
+auto GCS::match(const Scratch& hashes) const noexcept -> bool
 {
-    return hashed_set_construct(
-        api_, false_positive_rate_, filter_elements_, key_, elements);
+    auto target = hashes.cbegin();
+    const auto end = hashes.cend();
+    BitReader stream(filter_);
+    std::uint64_t value{0};
+
+    for (std::size_t i{0}; i < filter_elements_; ++i) {
+        value += golomb_decode(stream);
+
+        while (*target < value) {
+            if (++target == end) { return false; }
+        }
+
+        if (*target == value) { return true; }
+    }
+
+    return false;
 }
 
 auto GCS::Serialize() const noexcept -> proto::GCS
@@ -323,34 +311,6 @@ auto GCS::Serialize() const noexcept -> proto::GCS
     return output;
 }
 
-auto GCS::siphash(
-    const api::internal::Core& api,
-    const Data& key,
-    const Data& item) noexcept -> std::uint64_t
-{
-    auto output = std::uint64_t{};
-    auto pPassword = api.Factory().BinarySecret();
-
-    OT_ASSERT(pPassword);
-
-    auto& password = *pPassword;
-    password.setMemory(key);
-
-    OT_ASSERT(16 == password.getMemorySize());
-
-    const auto hashed = api.Crypto().Hash().SipHash(
-        password, item, output, siphash_c_, siphash_d_);
-
-    if (hashed) { return output; }
-
-    return 0;
-}
-
-auto GCS::siphash(const Data& item) const noexcept -> std::uint64_t
-{
-    return siphash(api_, key_, item);
-}
-
 auto GCS::Test(const Data& target) const noexcept -> bool
 {
     const std::uint64_t max_range = filter_elements_ * false_positive_rate_;
@@ -372,34 +332,8 @@ auto GCS::Test(const Data& target) const noexcept -> bool
 
 auto GCS::Test(const std::vector<OTData>& targets) const noexcept -> bool
 {
-    auto target_hashes_set = hashed_set_construct(targets);
-    std::vector<std::uint64_t> target_hashes;
-
-    for (const auto& target_hash : target_hashes_set) {
-        target_hashes.push_back(target_hash);
-    }
+    auto scratch = Scratch{};
 
-    BitReader stream(filter_);
-    std::uint64_t value{0};
-    std::size_t target_idx{0};
-    std::uint64_t target_val = target_hashes[target_idx];
-
-    for (std::size_t i{0}; i < filter_elements_; ++i) {
-        auto delta = golomb_decode(stream);
-        value += delta;
-        if (target_val == value) {
-            return true;
-        } else if (target_val > value) {
-            continue;
-        } else {
-            ++target_idx;
-
-            if (target_idx == targets.size()) { break; }
-
-            target_val = target_hashes[target_idx];
-        }
-    }
-
-    return false;
+    return Match(internal::GCSTargets(targets), scratch);
 }
 }  // namespace opentxs::blockchain::implementation
@@ -12,6 +12,7 @@ class GCS final : virtual public internal::GCS
 public:
     OTData Encode() const noexcept final;
     OTData Hash() const noexcept final;
+    bool Match(const Targets& targets, Scratch& scratch) const noexcept final;
     proto::GCS Serialize() const noexcept final;
     bool Test(const Data& target) const noexcept final;
     bool Test(const std::vector<OTData>& targets) const noexcept final;
@@ -24,49 +25,35 @@ private:
     using BitReader = internal::BitReader;
     using BitWriter = internal::BitWriter;
 
-    static const int siphash_c_{2};
-    static const int siphash_d_{4};
-
     const VersionNumber version_;
     const api::internal::Core& api_;
     const std::uint32_t bits_;
     const std::uint32_t false_positive_rate_;
     const OTData key_;
+    const internal::SipHasher hasher_;
     const std::size_t filter_elements_;
     const OTData filter_;
 
     static OTData build_gcs(
-        const api::internal::Core& api,
         const std::uint32_t bits,
         const std::uint32_t fpRate,
         const Data& key,
-        const std::vector<OTData>& elements) noexcept;
+        const std::vector<OTData>& elements) noexcept(false);
     static void golomb_encode(
         const std::uint32_t bits,
         BitWriter& stream,
         std::uint64_t delta) noexcept;
-    static std::uint64_t hash_to_range(
-        const api::internal::Core& api,
-        const Data& key,
-        const std::uint64_t maxRange,
-        const Data& item) noexcept;
-    static std::set<std::uint64_t> hashed_set_construct(
-        const api::internal::Core& api,
+    static void hashed_set_construct(
+        const internal::SipHasher& hasher,
         const std::uint32_t fpRate,
         const std::size_t elementCount,
-        const Data& key,
-        const std::vector<OTData>& elements) noexcept;
-    static std::uint64_t siphash(
-        const api::internal::Core& api,
-        const Data& key,
-        const Data& item) noexcept;
+        const std::vector<OTData>& elements,
+        Scratch& output) noexcept;
 
     std::uint64_t golomb_decode(BitReader& stream) const noexcept;
-    std::uint64_t siphash(const Data& item) const noexcept;
     std::uint64_t hash_to_range(const Data& item, const std::uint64_t maxRange)
         const noexcept;
-    std::set<std::uint64_t> hashed_set_construct(
-        const std::vector<OTData>& elements) const noexcept;
+    bool match(const Scratch& sortedHashes) const noexcept;
 
     GCS(const api::internal::Core& api,
         const std::uint32_t bits,
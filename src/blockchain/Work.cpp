@@ -24,20 +24,26 @@
 namespace opentxs
 {
 blockchain::Work* Factory::Work(const std::string& hex)
+{
+    const auto bytes = Data::Factory(hex, Data::Mode::Hex);
+
+    return WorkBigEndian(bytes->Bytes());
+}
+
+blockchain::Work* Factory::WorkBigEndian(const ReadView bytes)
 {
     using ReturnType = blockchain::implementation::Work;
     using ValueType = ReturnType::Type;
 
-    const auto bytes = Data::Factory(hex, Data::Mode::Hex);
-
-    if (bytes->empty()) { return new ReturnType(); }
+    if (0 == bytes.size()) { return new ReturnType(); }
 
+    const auto* begin = reinterpret_cast<const std::uint8_t*>(bytes.data());
     ValueType value{};
     mp::cpp_int i;
 
     try {
         // Interpret bytes as big endian
-        mp::import_bits(i, bytes->begin(), bytes->end(), 8, true);
+        mp::import_bits(i, begin, begin + bytes.size(), 8, true);
         value = ValueType{i};
     } catch (...) {
         LogOutput("opentxs::Factory::")(__FUNCTION__)(": Failed to decode work")
@@ -17,6 +17,9 @@
 #include "internal/blockchain/block/Block.hpp"
 #include "internal/blockchain/client/Client.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 #include "Header.hpp"
 
 // #define OT_METHOD "opentxs::blockchain::block::Header::"
@@ -58,6 +61,56 @@ pHash BlankHash() noexcept
 }
 }  // namespace opentxs::blockchain::block
 
+namespace opentxs::blockchain::block::internal
+{
+FlatHeader::FlatHeader() noexcept
+    : raw_()
+    , type_()
+    , height_()
+    , status_()
+    , inherit_status_()
+    , work_()
+    , inherit_work_()
+    , cumulative_work_()
+{
+    static_assert(196 == sizeof(FlatHeader));
+}
+
+auto Flatten(const block::Header& header) noexcept -> FlatHeader
+{
+    auto output = FlatHeader{};
+    auto copy_work = [](const blockchain::Work& in, FlatHeader::Work& out) {
+        const auto bytes = Data::Factory(in.asHex(), Data::Mode::Hex);
+        const auto size = std::min(bytes->size(), out.size());
+        std::memcpy(
+            out.data() + (out.size() - size),
+            static_cast<const std::uint8_t*>(bytes->data()) +
+                (bytes->size() - size),
+            size);
+    };
+
+    try {
+        const auto& bitcoin = dynamic_cast<const bitcoin::Header&>(header);
+        const auto raw = bitcoin.Encode();
+
+        OT_ASSERT(output.raw_.size() == raw->size());
+
+        std::memcpy(output.raw_.data(), raw->data(), raw->size());
+    } catch (...) {
+    }
+
+    output.type_ = static_cast<std::uint32_t>(header.Type());
+    output.height_ = header.Height();
+    output.status_ = static_cast<std::uint32_t>(header.LocalState());
+    output.inherit_status_ = static_cast<std::uint32_t>(header.InheritedState());
+    copy_work(header.Difficulty(), output.work_);
+    copy_work(header.ParentWork(), output.inherit_work_);
+    copy_work(header.Work(), output.cumulative_work_);
+
+    return output;
+}
+}  // namespace opentxs::blockchain::block::internal
+
 namespace opentxs::blockchain::block::implementation
 {
 const Header::GenesisBlockMap Header::genesis_blocks_{
@@ -111,6 +164,30 @@ Header::Header(
 {
 }
 
+Header::Header(
+    const api::internal::Core& api,
+    const blockchain::Type type,
+    const block::Hash& hash,
+    const block::Hash& parentHash,
+    const block::Height height,
+    const Status status,
+    const Status inheritStatus,
+    const blockchain::Work& work,
+    const blockchain::Work& inheritWork) noexcept
+    : Header(
+          api,
+          default_version_,
+          type,
+          hash,
+          parentHash,
+          height,
+          status,
+          inheritStatus,
+          work,
+          inheritWork)
+{
+}
+
 Header::Header(
     const api::internal::Core& api,
     const block::Hash& hash,
@@ -56,6 +56,16 @@ protected:
         const block::Hash& parentHash,
         const block::Height height,
         const blockchain::Work& work) noexcept;
+    Header(
+        const api::internal::Core& api,
+        const blockchain::Type type,
+        const block::Hash& hash,
+        const block::Hash& parentHash,
+        const block::Height height,
+        const Status status,
+        const Status inheritStatus,
+        const blockchain::Work& work,
+        const blockchain::Work& inheritWork) noexcept;
     Header(
         const api::internal::Core& api,
         const block::Hash& hash,
@@ -26,6 +26,7 @@
 #include <boost/endian/buffers.hpp>
 
 #include <array>
+#include <cstring>
 
 #include "Header.hpp"
 
@@ -95,6 +96,32 @@ blockchain::block::bitcoin::internal::Header* Factory::BitcoinBlockHeader(
 
     return new ReturnType(api, hash, parent, height);
 }
+
+blockchain::block::bitcoin::internal::Header* Factory::BitcoinBlockHeader(
+    const api::internal::Core& api,
+    const blockchain::block::Hash& hash,
+    const blockchain::block::internal::FlatHeaderView& record)
+{
+    using ReturnType = blockchain::block::bitcoin::implementation::Header;
+
+    if (false == bool(record)) {
+        LogOutput("opentxs::Factory::")(__FUNCTION__)(": Invalid record")
+            .Flush();
+
+        return nullptr;
+    }
+
+    const auto raw = record.Raw();
+
+    static_assert(
+        OT_BITCOIN_BLOCK_HEADER_SIZE == sizeof(ReturnType::BitcoinFormat));
+    OT_ASSERT(OT_BITCOIN_BLOCK_HEADER_SIZE == raw.size());
+
+    ReturnType::BitcoinFormat serialized{};
+    std::memcpy(&serialized, raw.data(), raw.size());
+
+    return new ReturnType(api, hash, serialized, record);
+}
 }  // namespace opentxs
 
 namespace opentxs::blockchain::block::bitcoin::implementation
@@ -143,7 +170,7 @@ Header::Header(
     , block_version_(0)
     , merkle_root_(hash)
     , timestamp_(make_blank<Time>::value(api))
-    , nbits_(NumericHash::MaxTarget)
+    , nbits_(placeholder_nbits_)
     , nonce_(0)
 {
     const_cast<OTData&>(hash_) = calculate_hash(api, Serialize());
@@ -170,6 +197,34 @@ Header::Header(
 {
 }
 
+Header::Header(
+    const api::internal::Core& api,
+    const block::Hash& hash,
+    const BitcoinFormat& serialized,
+    const block::internal::FlatHeaderView& record) noexcept
+    : bitcoin::Header()
+    , ot_super(
+          api,
+          record.Type(),
+          hash,
+          Data::Factory(
+              serialized.previous_.data(),
+              serialized.previous_.size()),
+          record.Height(),
+          record.LocalState(),
+          record.InheritedState(),
+          load_work(record.Work()),
+          load_work(record.InheritWork()))
+    , subversion_(subversion_default_)
+    , block_version_(serialized.version_.value())
+    , merkle_root_(
+          Data::Factory(serialized.merkle_.data(), serialized.merkle_.size()))
+    , timestamp_(Clock::from_time_t(std::time_t(serialized.time_.value())))
+    , nbits_(serialized.nbits_.value())
+    , nonce_(serialized.nonce_.value())
+{
+}
+
 Header::Header(const Header& rhs) noexcept
     : bitcoin::Header()
     , ot_super(rhs)
@@ -260,6 +315,11 @@ OTWork Header::calculate_work(const std::int32_t nbits)
     return OTWork{Factory::Work(hash)};
 }
 
+OTWork Header::load_work(const ReadView bigEndian)
+{
+    return OTWork{Factory::WorkBigEndian(bigEndian)};
+}
+
 std::unique_ptr<block::Header> Header::clone() const noexcept
 {
     return std::unique_ptr<block::Header>(new Header(*this));
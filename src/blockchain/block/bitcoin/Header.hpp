@@ -52,6 +52,9 @@ private:
     using ot_super = block::implementation::Header;
 
     static const VersionNumber subversion_default_{1};
+    // Target for headers constructed from a hash, parent, and height. It
+    // exceeds every 256 bit value so these placeholders pass Valid().
+    static const std::int32_t placeholder_nbits_{0x2200ffff};
 
     const VersionNumber subversion_;
     const std::int32_t block_version_;
@@ -67,6 +70,7 @@ private:
         const api::internal::Core& api,
         const SerializedType& serialized);
     static OTWork calculate_work(const std::int32_t nbits);
+    static OTWork load_work(const ReadView bigEndian);
 
     Header(
         const api::internal::Core& api,
@@ -86,6 +90,11 @@ private:
     Header(
         const api::internal::Core& api,
         const SerializedType& serialized) noexcept;
+    Header(
+        const api::internal::Core& api,
+        const block::Hash& hash,
+        const BitcoinFormat& serialized,
+        const block::internal::FlatHeaderView& record) noexcept;
     Header() = delete;
     Header(const Header& rhs) noexcept;
     Header(Header&&) = delete;
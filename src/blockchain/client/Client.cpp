@@ -19,23 +19,25 @@
 
 #include <boost/bind.hpp>
 
+#include <algorithm>
+#include <memory>
+
 namespace opentxs::blockchain::client::internal
 {
 IO::IO(const api::Core& api) noexcept
     : api_(api)
-    , lock_()
     , cb_(zmq::ListenCallback::Factory([this](auto& in) { callback(in); }))
     , socket_(
           api.ZeroMQ().RouterSocket(cb_, zmq::socket::Socket::Direction::Bind))
-    , next_buffer_(-1)
-    , buffers_()
+    , buffers_(ReceiveBuffers::Factory())
     , context_()
     , work_(std::make_unique<boost::asio::io_context::work>(context_))
     , thread_pool_()
 {
     OT_ASSERT(work_);
 
-    const auto limit = std::min(2u, std::thread::hardware_concurrency());
+    // Shared by peer sockets and cfilter verification for every chain
+    const auto limit = std::max(2u, std::thread::hardware_concurrency());
 
     for (unsigned int i{0}; i < limit; ++i) {
         thread_pool_.create_thread(
@@ -68,12 +70,6 @@ auto IO::callback(zmq::Message& in) noexcept -> void
     }
 }
 
-auto IO::clear_buffer(const int id) const noexcept -> void
-{
-    Lock lock(lock_);
-    buffers_.erase(id);
-}
-
 auto IO::Connect(
     const Space& id,
     const tcp::endpoint& endpoint,
@@ -97,31 +93,20 @@ auto IO::Connect(
     });
 }
 
-auto IO::get_buffer(const std::size_t bytes) const noexcept
-    -> std::pair<int, WritableView>
-{
-    Lock lock(lock_);
-    auto id = ++next_buffer_;
-    auto& buffer = buffers_[id];
-
-    return {id, writer(buffer)(bytes)};
-}
-
 auto IO::Receive(
     const Space& id,
     const OTZMQWorkType type,
     const std::size_t bytes,
     tcp::socket& socket) const noexcept -> void
 {
-    auto space = get_buffer(bytes);
-    auto asioBuffer =
-        boost::asio::buffer(space.second.data(), space.second.size());
+    auto buffer = buffers_->Get(bytes);
+    auto asioBuffer = boost::asio::buffer(buffer->data_.get(), bytes);
     boost::asio::async_read(
         socket,
         asioBuffer,
-        [this, id, type, space{std::move(space)}](const auto& e, auto size) {
+        [this, id, type, bytes, buffer{std::move(buffer)}](
+            const auto& e, auto size) mutable {
             auto work = api_.ZeroMQ().Message(id);
-            auto& buffer = space.second;
 
             if (e) {
                 LogVerbose("asio receive error: ")(e.message()).Flush();
@@ -131,11 +116,12 @@ auto IO::Receive(
             } else {
                 work->AddFrame(type);
                 work->AddFrame();
-                work->AddFrame(buffer.data(), buffer.size());
+                auto* data = buffer->data_.get();
+                work->AddFrame(
+                    data, bytes, &ReceiveBuffers::Release, buffer.release());
             }
 
             socket_->Send(work);
-            clear_buffer(space.first);
         });
 }
 
@@ -148,4 +134,98 @@ auto IO::Shutdown() noexcept -> void
 }
 
 IO::~IO() { Shutdown(); }
+
+ReceiveBuffers::Buffer::Buffer(
+    const std::size_t sizeClass,
+    const std::size_t bytes) noexcept
+    : pool_()
+    , class_(sizeClass)
+    , data_(new std::byte[bytes])
+{
+}
+
+auto ReceiveBuffers::Deleter::operator()(Buffer* buffer) const noexcept
+    -> void
+{
+    if (nullptr == buffer) { return; }
+
+    // Hold the pool locally since the buffer may be reused by another thread
+    // as soon as it has been pushed onto a free list
+    auto pool = std::move(buffer->pool_);
+
+    if (pool) {
+        pool->put(buffer);
+    } else {
+        delete buffer;
+    }
+}
+
+ReceiveBuffers::ReceiveBuffers() noexcept
+    : free_()
+{
+    for (auto i{min_class_}; i <= max_class_; ++i) {
+        const auto cached = std::min(
+            max_cached_,
+            std::max(std::size_t{1}, cache_limit_ >> i));
+        free_.emplace_back(std::make_unique<Stack>(cached));
+    }
+}
+
+auto ReceiveBuffers::Factory() noexcept -> std::shared_ptr<ReceiveBuffers>
+{
+    return std::shared_ptr<ReceiveBuffers>{new ReceiveBuffers()};
+}
+
+auto ReceiveBuffers::Get(const std::size_t bytes) noexcept -> Pointer
+{
+    const auto sizeClass = size_class(bytes);
+    Buffer* output{nullptr};
+
+    if ((max_class_ < sizeClass) ||
+        (false == free_.at(sizeClass - min_class_)->pop(output))) {
+        const auto size =
+            (max_class_ < sizeClass) ? bytes : (std::size_t{1} << sizeClass);
+        output = new Buffer(sizeClass, size);
+    }
+
+    OT_ASSERT(nullptr != output);
+
+    output->pool_ = shared_from_this();
+
+    return Pointer{output};
+}
+
+auto ReceiveBuffers::put(Buffer* buffer) noexcept -> void
+{
+    const auto sizeClass = buffer->class_;
+
+    if ((max_class_ < sizeClass) ||
+        (false == free_.at(sizeClass - min_class_)->bounded_push(buffer))) {
+        delete buffer;
+    }
+}
+
+auto ReceiveBuffers::Release(void*, void* hint) noexcept -> void
+{
+    Deleter{}(static_cast<Buffer*>(hint));
+}
+
+auto ReceiveBuffers::size_class(const std::size_t bytes) noexcept
+    -> std::size_t
+{
+    auto output{min_class_};
+
+    while ((max_class_ >= output) && ((std::size_t{1} << output) < bytes)) {
+        ++output;
+    }
+
+    return output;
+}
+
+ReceiveBuffers::~ReceiveBuffers()
+{
+    for (auto& stack : free_) {
+        stack->consume_all([](auto* buffer) { delete buffer; });
+    }
+}
 }  // namespace opentxs::blockchain::client::internal
@@ -25,8 +25,19 @@
 #include "core/Executor.hpp"
 #include "internal/api/Api.hpp"
 #include "internal/blockchain/Blockchain.hpp"
+#include "internal/blockchain/client/Client.hpp"
 
+#include <boost/asio.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <thread>
 
 #include "FilterOracle.hpp"
 
@@ -38,13 +49,15 @@ auto Factory::BlockchainFilterOracle(
     const api::internal::Core& api,
     const blockchain::client::internal::Network& network,
     const blockchain::client::internal::FilterDatabase& database,
+    const blockchain::client::internal::IO& io,
     const blockchain::Type type,
     const std::string& shutdown) noexcept
     -> std::unique_ptr<blockchain::client::internal::FilterOracle>
 {
     using ReturnType = blockchain::client::implementation::FilterOracle;
 
-    return std::make_unique<ReturnType>(api, network, database, type, shutdown);
+    return std::make_unique<ReturnType>(
+        api, network, database, io, type, shutdown);
 }
 }  // namespace opentxs
 
@@ -52,20 +65,32 @@ namespace opentxs::blockchain::client::implementation
 {
 const std::chrono::seconds FilterOracle::FilterQueue::timeout_{15};
 const std::chrono::seconds FilterOracle::RequestQueue::limit_{15};
+const std::size_t FilterOracle::max_pending_{4000};
+const std::size_t FilterOracle::lookahead_{4};
+const std::chrono::seconds FilterOracle::shutdown_timeout_{30};
 
 FilterOracle::FilterOracle(
     const api::internal::Core& api,
     const internal::Network& network,
     const internal::FilterDatabase& database,
+    const internal::IO& io,
     const blockchain::Type type,
     const std::string& shutdown) noexcept
     : internal::FilterOracle()
     , Executor(api)
     , network_(network)
     , database_(database)
+    , io_(io)
     , default_type_(blockchain::internal::DefaultFilter(type))
     , header_requests_(api_)
+    , queued_headers_()
     , outstanding_filters_(api_)
+    , pending_(std::make_shared<Pending>())
+    , verified_lock_()
+    , verified_()
+    , decode_()
+    , verify_()
+    , store_()
 {
     init_executor({shutdown, api.Endpoints().BlockchainReorg()});
 }
@@ -78,7 +103,14 @@ FilterOracle::FilterQueue::FilterQueue(const api::Core& api) noexcept
     , last_received_()
     , target_(make_blank<block::Position>::value(api))
 {
-    filters_.reserve(1000);
+    filters_.reserve(max_pending_);
+}
+
+FilterOracle::Pending::Pending() noexcept
+    : lock_()
+    , finished_()
+    , count_(0)
+{
 }
 
 FilterOracle::RequestQueue::RequestQueue(const api::Core& api) noexcept
@@ -86,6 +118,12 @@ FilterOracle::RequestQueue::RequestQueue(const api::Core& api) noexcept
 {
 }
 
+FilterOracle::Throughput::Throughput() noexcept
+    : count_(0)
+    , elapsed_(0)
+{
+}
+
 auto FilterOracle::FilterQueue::AddFilter(
     const block::Height height,
     const block::Hash& hash,
@@ -192,6 +230,40 @@ auto FilterOracle::FilterQueue::Reset() noexcept -> void
     target_ = make_blank<block::Position>::value(api_);
 }
 
+auto FilterOracle::Pending::Add() noexcept -> void
+{
+    Lock lock(lock_);
+    ++count_;
+}
+
+auto FilterOracle::Pending::Count() const noexcept -> std::size_t
+{
+    Lock lock(lock_);
+
+    return count_;
+}
+
+auto FilterOracle::Pending::Remove() noexcept -> void
+{
+    {
+        Lock lock(lock_);
+
+        OT_ASSERT(0 < count_);
+
+        --count_;
+    }
+
+    finished_.notify_all();
+}
+
+auto FilterOracle::Pending::Wait(
+    const std::chrono::milliseconds limit) const noexcept -> bool
+{
+    Lock lock(lock_);
+
+    return finished_.wait_for(lock, limit, [this] { return 0 == count_; });
+}
+
 auto FilterOracle::RequestQueue::Finish(const block::Hash& block) noexcept
     -> void
 {
@@ -227,6 +299,29 @@ auto FilterOracle::RequestQueue::Start(const block::Hash& block) noexcept
     hashes_.emplace(block, Clock::now());
 }
 
+auto FilterOracle::Throughput::Add(
+    const std::size_t filters,
+    const std::chrono::nanoseconds elapsed) noexcept -> void
+{
+    count_ += filters;
+    elapsed_ += static_cast<std::uint64_t>(elapsed.count());
+}
+
+auto FilterOracle::Throughput::Rate() const noexcept -> std::uint64_t
+{
+    const auto elapsed = elapsed_.load();
+
+    if (0 == elapsed) { return 0; }
+
+    return (count_.load() * 1000000000u) / elapsed;
+}
+
+auto FilterOracle::Throughput::Reset() noexcept -> void
+{
+    count_.store(0);
+    elapsed_.store(0);
+}
+
 auto FilterOracle::AddFilter(
     const filter::Type type,
     const block::Hash& block,
@@ -272,6 +367,156 @@ auto FilterOracle::CheckBlocks() const noexcept -> void
     Trigger();
 }
 
+auto FilterOracle::ImportSnapshot(const internal::Snapshot& snapshot) const
+    noexcept -> bool
+{
+    constexpr auto batch = std::size_t{10000};
+    const auto type = snapshot.FilterType();
+    const auto count = snapshot.Count();
+
+    if (default_type_ != type) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(
+            ": Snapshot contains the wrong filter type")
+            .Flush();
+
+        return false;
+    }
+
+    if (0 == count) { return true; }
+
+    const auto [tipHeight, tipHash] = database_.FilterHeaderTip(type);
+
+    if (snapshot.Height(count - 1) <= tipHeight) { return true; }
+
+    if (snapshot.Start() > (tipHeight + 1)) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(
+            ": Snapshot does not connect to the filter header chain")
+            .Flush();
+
+        return false;
+    }
+
+    const auto& headers = network_.HeaderOracle();
+    const auto view = [](const auto& in) -> ReadView {
+        return {reinterpret_cast<const char*>(in.data()), in.size()};
+    };
+    auto previous = database_.LoadFilterHeader(type, tipHash->Bytes());
+    auto i = static_cast<std::size_t>((tipHeight + 1) - snapshot.Start());
+    auto output = std::vector<internal::FilterDatabase::Header>{};
+    output.reserve(std::min(batch, count - i));
+
+    while (i < count) {
+        const auto end = std::min(count, i + batch);
+        const auto previousHeader = api_.Factory().Data(previous->Bytes());
+        auto tip = make_blank<block::Position>::value(api_);
+        output.clear();
+
+        for (; i < end; ++i) {
+            const auto height = snapshot.Height(i);
+            const auto& record = snapshot.Record(i);
+            auto blockHash = headers.BestHash(height);
+
+            // Filter headers are only imported for blocks in the best chain
+            if (blockHash->empty()) { break; }
+
+            if (blockHash->Bytes() !=
+                view(blockchain::internal::DoubleSha256(
+                    {view(record.header_)}))) {
+                LogOutput(OT_METHOD)(__FUNCTION__)(
+                    ": Snapshot block header does not match best chain at "
+                    "height ")(height)
+                    .Flush();
+
+                return false;
+            }
+
+            const auto hash = view(record.filter_hash_);
+            auto header = blockchain::internal::FilterHashToHeader(
+                api_, hash, previous->Bytes());
+
+            if (header->Bytes() != view(record.filter_header_)) {
+                LogOutput(OT_METHOD)(__FUNCTION__)(
+                    ": Invalid filter header at height ")(height)
+                    .Flush();
+
+                return false;
+            }
+
+            previous = header;
+            tip = block::Position{height, blockHash};
+            output.emplace_back(std::move(blockHash), std::move(header), hash);
+        }
+
+        if (output.empty()) { break; }
+
+        if (false ==
+            database_.StoreFilterHeaders(
+                type, previousHeader->Bytes(), std::move(output))) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Failed to store filter headers")
+                .Flush();
+
+            return false;
+        }
+
+        if (false == database_.SetFilterHeaderTip(type, tip)) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Failed to update filter header tip")
+                .Flush();
+
+            return false;
+        }
+
+        LogNormal(blockchain::internal::DisplayString(network_.Chain()))(
+            " imported snapshot filter headers to height ")(tip.first)
+            .Flush();
+
+        if (end != i) { break; }
+    }
+
+    return true;
+}
+
+auto FilterOracle::Match(
+    const filter::Type type,
+    const std::vector<OTData>& elements,
+    const block::Height start,
+    const block::Height stop) const noexcept -> std::vector<block::Position>
+{
+    auto output = std::vector<block::Position>{};
+    const auto targets = blockchain::internal::GCSTargets(elements);
+
+    if (0 == targets.size()) { return output; }
+
+    const auto& headers = network_.HeaderOracle();
+    const auto last = std::min(stop, database_.FilterTip(type).first);
+    auto scratch = blockchain::internal::GCS::Scratch{};
+    scratch.reserve(targets.size());
+
+    for (auto height{std::max(start, block::Height{0})}; height <= last;
+         ++height) {
+        auto hash = headers.BestHash(height);
+
+        if (hash->empty()) { break; }
+
+        const auto pFilter = database_.LoadFilter(type, hash->Bytes());
+
+        if (false == bool(pFilter)) {
+            LogVerbose(OT_METHOD)(__FUNCTION__)(": Filter for block ")(
+                hash->asHex())(" at height ")(height)(" not found")
+                .Flush();
+
+            continue;
+        }
+
+        if (pFilter->Match(targets, scratch)) {
+            output.emplace_back(height, std::move(hash));
+        }
+    }
+
+    return output;
+}
+
 void FilterOracle::check_filters(
     const filter::Type type,
     const block::Height maxRequests,
@@ -286,9 +531,13 @@ void FilterOracle::check_filters(
 
     if (outstanding_filters_.IsRunning()) { return; }
 
+    // Wait for the worker pool to drain before requesting another batch
+    if (0 < pending_->Count()) { return; }
+
     const auto headerTip = database_.FilterHeaderTip(type).first;
     const auto begin{start.first + static_cast<block::Height>(1)};
-    const auto target{begin + maxRequests - static_cast<block::Height>(1)};
+    const auto window = static_cast<block::Height>(lookahead_) * maxRequests;
+    const auto target{begin + window - static_cast<block::Height>(1)};
     const auto stopHeight = std::min(std::min(target, headerTip), best.first);
 
     if (0 > (stopHeight - begin)) { return; }
@@ -298,7 +547,12 @@ void FilterOracle::check_filters(
         " to ")(stopHeight)
         .Flush();
     outstanding_filters_.Queue(begin, stopHash, headers);
-    network_.RequestFilters(type, begin, stopHash);
+
+    for (auto height{begin}; height <= stopHeight; height += maxRequests) {
+        const auto stop = std::min(
+            height + maxRequests - static_cast<block::Height>(1), stopHeight);
+        network_.RequestFilters(type, height, headers.BestHash(stop));
+    }
 }
 
 void FilterOracle::check_headers(
@@ -316,18 +570,27 @@ void FilterOracle::check_headers(
         return;
     }
 
-    const auto begin{start.first + static_cast<block::Height>(1)};
-    const auto target{begin + maxRequests - static_cast<block::Height>(1)};
-    const auto stopHeight = std::min(target, best.first);
-    const auto stopHash = headers.BestHash(stopHeight);
+    for (auto i = std::size_t{0}; i < lookahead_; ++i) {
+        const auto begin{
+            start.first + static_cast<block::Height>(1) +
+            (static_cast<block::Height>(i) * maxRequests)};
 
-    if (header_requests_.IsRunning(stopHash)) { return; }
+        if (begin > best.first) { break; }
 
-    LogVerbose(OT_METHOD)(__FUNCTION__)(": Requesting filter headers from ")(
-        begin)(" to ")(stopHeight)
-        .Flush();
-    header_requests_.Start(stopHash);
-    network_.RequestFilterHeaders(type, begin, stopHash);
+        if (0 < queued_headers_.count(begin)) { continue; }
+
+        const auto target{begin + maxRequests - static_cast<block::Height>(1)};
+        const auto stopHeight = std::min(target, best.first);
+        const auto stopHash = headers.BestHash(stopHeight);
+
+        if (header_requests_.IsRunning(stopHash)) { continue; }
+
+        LogVerbose(OT_METHOD)(__FUNCTION__)(
+            ": Requesting filter headers from ")(begin)(" to ")(stopHeight)
+            .Flush();
+        header_requests_.Start(stopHash);
+        network_.RequestFilterHeaders(type, begin, stopHash);
+    }
 }
 
 auto FilterOracle::pipeline(const zmq::Message& in) noexcept -> void
@@ -351,6 +614,9 @@ auto FilterOracle::pipeline(const zmq::Message& in) noexcept -> void
         case Work::cfheader: {
             process_cfheader(in);
         } break;
+        case Work::verified: {
+            process_verified();
+        } break;
         case Work::reorg: {
             process_reorg(in);
         } break;
@@ -424,6 +690,15 @@ auto FilterOracle::process_cfheader(const zmq::Message& in) noexcept -> void
 
     if (header.Height() <= previousHeight) { return; }
 
+    if (start > (previousHeight + 1)) {
+        // Another peer has not yet delivered the preceding range
+        if ((2 * lookahead_) > queued_headers_.size()) {
+            queued_headers_.emplace(start, in);
+        }
+
+        return;
+    }
+
     const auto previous =
         database_.LoadFilterHeader(type, previousHash->Bytes());
     auto priorFilter = previous->Bytes();
@@ -460,6 +735,16 @@ auto FilterOracle::process_cfheader(const zmq::Message& in) noexcept -> void
             LogNormal(blockchain::internal::DisplayString(network_.Chain()))(
                 " filter header chain updated to height ")(header.Height())
                 .Flush();
+            const auto next = header.Height() + 1;
+            queued_headers_.erase(
+                queued_headers_.begin(), queued_headers_.lower_bound(next));
+            auto it = queued_headers_.find(next);
+
+            if (queued_headers_.end() != it) {
+                const auto queued = it->second;
+                queued_headers_.erase(it);
+                process_cfheader(queued.get());
+            }
         } else {
             LogOutput(OT_METHOD)(__FUNCTION__)(
                 ": Failed updating filter header tip")
@@ -483,68 +768,36 @@ auto FilterOracle::process_cfilter(const zmq::Message& in) noexcept -> void
         OT_FAIL;
     }
 
-    const auto type = body.at(0).as<filter::Type>();
-    const auto block = Data::Factory(body.at(1));
-    const auto serialized = proto::Factory<proto::GCS>(body.at(2));
-    auto gcs = std::unique_ptr<const blockchain::internal::GCS>{
-        Factory::GCS(api_, serialized)};
-
-    if (false == bool(gcs)) {
-        LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid GCS").Flush();
-
-        return;
-    }
-
-    const auto pHeader = network_.HeaderOracle().LoadHeader(block);
-    const auto& header = *pHeader;
-
-    if (false == bool(pHeader)) {
-        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to load block header ")(
-            block->asHex())
+    if (max_pending_ <= pending_->Count()) {
+        LogVerbose(OT_METHOD)(__FUNCTION__)(
+            ": Worker pool saturated, dropping filter")
             .Flush();
 
         return;
     }
 
-    const auto hash = gcs->Hash();
-    const auto expected = database_.LoadFilterHash(type, block->Bytes());
-
-    if (hash != expected) {
-        LogVerbose(OT_METHOD)(__FUNCTION__)(": Filter for block ")(
-            block->asHex())(" at height ")(header.Height())(
-            " does not match header. Received: ")(hash->asHex())(" expected: ")(
-            expected->asHex())
-            .Flush();
-
-        return;
-    }
-
-    outstanding_filters_.AddFilter(
-        header.Height(), header.Hash(), std::move(gcs));
-
-    if (outstanding_filters_.IsFull()) {
-        auto filters = std::vector<internal::FilterDatabase::Filter>{};
-        auto position = outstanding_filters_.Flush(filters);
-
-        if (false == database_.StoreFilters(type, std::move(filters))) {
-            LogOutput(OT_METHOD)(__FUNCTION__)(": Database error").Flush();
-            Trigger();
-
-            return;
+    const auto type = body.at(0).as<filter::Type>();
+    auto block = Data::Factory(body.at(1));
+    auto serialized = Data::Factory(body.at(2));
+    struct Job {
+        Job(const std::shared_ptr<Pending>& pending) noexcept
+            : pending_(pending)
+        {
+            pending_->Add();
         }
 
-        database_.SetFilterTip(type, position);
-        LogNormal(blockchain::internal::DisplayString(network_.Chain()))(
-            " filter chain updated to height ")(header.Height())
-            .Flush();
-    } else {
-        LogVerbose(blockchain::internal::DisplayString(network_.Chain()))(
-            " filter for block ")(header.Hash().asHex())(" at height ")(
-            header.Height())(" cached")
-            .Flush();
-    }
+        ~Job() { pending_->Remove(); }
 
-    Trigger();
+    private:
+        const std::shared_ptr<Pending> pending_;
+    };
+
+    auto job = std::make_shared<Job>(pending_);
+    boost::asio::post(
+        static_cast<boost::asio::io_context&>(io_),
+        [this, type, block, serialized, job]() {
+            verify_cfilter(type, block, serialized);
+        });
 }
 
 auto FilterOracle::process_reorg(const zmq::Message& in) noexcept -> void
@@ -565,6 +818,7 @@ auto FilterOracle::process_reorg(const zmq::Message& in) noexcept -> void
     const auto height = body.at(2).as<block::Height>();
     const auto reorg = block::Position{height, std::move(hash)};
     header_requests_.Reset();
+    queued_headers_.clear();
     outstanding_filters_.Reset();
 
     {
@@ -589,6 +843,45 @@ auto FilterOracle::process_reorg(const zmq::Message& in) noexcept -> void
     request();
 }
 
+auto FilterOracle::process_verified() noexcept -> void
+{
+    auto verified = std::deque<VerifiedFilter>{};
+
+    {
+        Lock lock(verified_lock_);
+        verified.swap(verified_);
+    }
+
+    const auto& headers = network_.HeaderOracle();
+
+    for (auto& [type, block, gcs] : verified) {
+        const auto pHeader = headers.LoadHeader(block);
+
+        if (false == bool(pHeader)) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Failed to load block header ")(block->asHex())
+                .Flush();
+
+            continue;
+        }
+
+        const auto& header = *pHeader;
+        outstanding_filters_.AddFilter(
+            header.Height(), header.Hash(), std::move(gcs));
+
+        if (outstanding_filters_.IsFull()) {
+            store_filters(type, header.Height());
+        } else {
+            LogVerbose(blockchain::internal::DisplayString(network_.Chain()))(
+                " filter for block ")(header.Hash().asHex())(" at height ")(
+                header.Height())(" cached")
+                .Flush();
+        }
+    }
+
+    Trigger();
+}
+
 auto FilterOracle::request() noexcept -> bool
 {
     auto repeat = Cleanup{};
@@ -601,6 +894,16 @@ auto FilterOracle::request() noexcept -> bool
 auto FilterOracle::shutdown(std::promise<void>& promise) noexcept -> void
 {
     if (running_->Off()) {
+        // The thread pool is shared, so wait for the jobs posted by this
+        // oracle instead of stopping it. They return early once running_ is
+        // off.
+        if (false == pending_->Wait(shutdown_timeout_)) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": ")(pending_->Count())(
+                " cfilter jobs still outstanding after ")(
+                shutdown_timeout_.count())(" seconds")
+                .Flush();
+        }
+
         try {
             state_machine_.set_value(false);
         } catch (...) {
@@ -613,6 +916,35 @@ auto FilterOracle::shutdown(std::promise<void>& promise) noexcept -> void
     }
 }
 
+auto FilterOracle::store_filters(
+    const filter::Type type,
+    const block::Height height) noexcept -> void
+{
+    const auto start = std::chrono::steady_clock::now();
+    auto filters = std::vector<internal::FilterDatabase::Filter>{};
+    auto position = outstanding_filters_.Flush(filters);
+    const auto count = filters.size();
+
+    if (false == database_.StoreFilters(type, std::move(filters))) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Database error").Flush();
+
+        return;
+    }
+
+    database_.SetFilterTip(type, position);
+    store_.Add(count, std::chrono::steady_clock::now() - start);
+    const auto chain = blockchain::internal::DisplayString(network_.Chain());
+    LogNormal(chain)(" filter chain updated to height ")(height).Flush();
+    LogVerbose(chain)(" filter pipeline throughput (filters/sec): decode ")(
+        decode_.Rate())(", verify ")(verify_.Rate())(", store ")(
+        store_.Rate())
+        .Flush();
+    // Each report covers the batch since the previous one
+    decode_.Reset();
+    verify_.Reset();
+    store_.Reset();
+}
+
 auto FilterOracle::Start() noexcept -> void
 {
     if (false == running_.get()) { return; }
@@ -620,5 +952,55 @@ auto FilterOracle::Start() noexcept -> void
     Trigger();
 }
 
+auto FilterOracle::verify_cfilter(
+    const filter::Type type,
+    const OTData block,
+    const OTData serialized) const noexcept -> void
+{
+    if (false == running_.get()) { return; }
+
+    auto start = std::chrono::steady_clock::now();
+    auto gcs = std::unique_ptr<const blockchain::internal::GCS>{Factory::GCS(
+        api_, proto::Factory<proto::GCS>(serialized))};
+
+    if (false == bool(gcs)) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid GCS").Flush();
+
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    decode_.Add(1, now - start);
+    start = now;
+    const auto hash = gcs->Hash();
+    const auto expected = database_.LoadFilterHash(type, block->Bytes());
+    verify_.Add(1, std::chrono::steady_clock::now() - start);
+
+    if (hash != expected) {
+        LogVerbose(OT_METHOD)(__FUNCTION__)(": Filter for block ")(
+            block->asHex())(" does not match header. Received: ")(
+            hash->asHex())(" expected: ")(expected->asHex())
+            .Flush();
+
+        return;
+    }
+
+    auto notify{false};
+
+    {
+        Lock lock(verified_lock_);
+        notify = verified_.empty();
+        verified_.emplace_back(VerifiedFilter{type, block, std::move(gcs)});
+    }
+
+    // Only the first result of a burst needs to wake the pipeline since
+    // process_verified drains every result queued at that point
+    if (notify) {
+        auto work = zmq::Message::Factory();
+        work->AddFrame(Work{Work::verified});
+        pipeline_->Push(work);
+    }
+}
+
 FilterOracle::~FilterOracle() { Shutdown().get(); }
 }  // namespace opentxs::blockchain::client::implementation
@@ -23,6 +23,22 @@ public:
         const ReadView previousHeader,
         const std::vector<ReadView> hashes) const noexcept final;
     void CheckBlocks() const noexcept final;
+    block::Position FilterHeaderTip(const filter::Type type) const
+        noexcept final
+    {
+        return database_.FilterHeaderTip(type);
+    }
+    block::Position FilterTip(const filter::Type type) const noexcept final
+    {
+        return database_.FilterTip(type);
+    }
+    bool ImportSnapshot(const internal::Snapshot& snapshot) const
+        noexcept final;
+    std::vector<block::Position> Match(
+        const filter::Type type,
+        const std::vector<OTData>& elements,
+        const block::Height start,
+        const block::Height stop) const noexcept final;
 
     void Start() noexcept;
     std::shared_future<void> Shutdown() noexcept final
@@ -34,6 +50,7 @@ public:
         const api::internal::Core& api,
         const internal::Network& network,
         const internal::FilterDatabase& database,
+        const internal::IO& io,
         const blockchain::Type type,
         const std::string& shutdown) noexcept;
 
@@ -46,6 +63,7 @@ private:
     enum class Work : OTZMQWorkType {
         cfilter = 0,
         cfheader = 1,
+        verified = 2,
         reorg = OT_ZMQ_REORG_SIGNAL,
         statemachine = OT_ZMQ_STATE_MACHINE_SIGNAL,
         shutdown = OT_ZMQ_SHUTDOWN_SIGNAL,
@@ -108,6 +126,23 @@ private:
         block::Position target_;
     };
 
+    // Accumulates the work done by one stage of the cfilter pipeline so the
+    // throughput of each stage can be reported independently
+    struct Throughput {
+        auto Add(
+            const std::size_t filters,
+            const std::chrono::nanoseconds elapsed) noexcept -> void;
+        // Filters per second of busy time spent in this stage
+        auto Rate() const noexcept -> std::uint64_t;
+        auto Reset() noexcept -> void;
+
+        Throughput() noexcept;
+
+    private:
+        std::atomic<std::uint64_t> count_;
+        std::atomic<std::uint64_t> elapsed_;
+    };
+
     struct RequestQueue {
         auto Finish(const block::Hash& block) noexcept -> void;
         auto IsRunning(const block::Hash& block) noexcept -> bool;
@@ -126,11 +161,64 @@ private:
         mutable std::map<block::pHash, Time> hashes_;
     };
 
+    // Number of cfilters posted to the worker pool which have not finished.
+    // Each posted job holds a reference so the count is released even when
+    // the pool destroys the job without running it.
+    struct Pending {
+        auto Add() noexcept -> void;
+        auto Count() const noexcept -> std::size_t;
+        auto Remove() noexcept -> void;
+        // Returns false if jobs are still outstanding when the limit expires
+        auto Wait(const std::chrono::milliseconds limit) const noexcept
+            -> bool;
+
+        Pending() noexcept;
+
+    private:
+        mutable std::mutex lock_;
+        mutable std::condition_variable finished_;
+        std::size_t count_;
+    };
+
+    struct VerifiedFilter {
+        filter::Type type_;
+        OTData block_;
+        std::unique_ptr<const blockchain::internal::GCS> filter_;
+    };
+
+    // Limit on the number of cfilters which have been received but not yet
+    // processed by the worker pool. Messages which arrive while the pool is
+    // saturated are dropped and will be requested again after FilterQueue
+    // times out.
+    static const std::size_t max_pending_;
+    // Number of consecutive ranges of filters or filter headers requested at
+    // the same time so the peer manager can download them in parallel
+    static const std::size_t lookahead_;
+    // Upper bound on how long shutdown waits for posted cfilter jobs
+    static const std::chrono::seconds shutdown_timeout_;
+
     const internal::Network& network_;
     const internal::FilterDatabase& database_;
+    // Decoding and verification run on the thread pool shared by every
+    // blockchain rather than on threads owned by this oracle
+    const internal::IO& io_;
     const filter::Type default_type_;
     RequestQueue header_requests_;
+    // Filter headers received ahead of the current tip, indexed by the height
+    // of the first header in the message
+    std::map<block::Height, OTZMQMessage> queued_headers_;
     FilterQueue outstanding_filters_;
+    const std::shared_ptr<Pending> pending_;
+    mutable std::mutex verified_lock_;
+    mutable std::deque<VerifiedFilter> verified_;
+    mutable Throughput decode_;
+    mutable Throughput verify_;
+    Throughput store_;
+
+    auto verify_cfilter(
+        const filter::Type type,
+        const OTData block,
+        const OTData serialized) const noexcept -> void;
 
     auto check_filters(
         const filter::Type type,
@@ -144,8 +232,12 @@ private:
     auto process_cfheader(const zmq::Message& in) noexcept -> void;
     auto process_cfilter(const zmq::Message& in) noexcept -> void;
     auto process_reorg(const zmq::Message& in) noexcept -> void;
+    auto process_verified() noexcept -> void;
     auto request() noexcept -> bool;
     auto shutdown(std::promise<void>& promise) noexcept -> void;
+    auto store_filters(
+        const filter::Type type,
+        const block::Height height) noexcept -> void;
 
     FilterOracle() = delete;
     FilterOracle(const FilterOracle&) = delete;
@@ -7,6 +7,8 @@
 
 #include "Internal.hpp"
 
+#include "opentxs/api/Core.hpp"
+#include "opentxs/api/Factory.hpp"
 #include "opentxs/blockchain/block/Header.hpp"
 #include "opentxs/blockchain/client/HeaderOracle.hpp"
 #include "opentxs/blockchain/NumericHash.hpp"
@@ -16,11 +18,18 @@
 
 #include "blockchain/client/UpdateTransaction.hpp"
 #include "internal/api/Api.hpp"
+#include "internal/blockchain/block/Block.hpp"
 #include "internal/blockchain/Blockchain.hpp"
+#include "internal/blockchain/client/Client.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cstring>
+#include <future>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <thread>
 #include <tuple>
 
 #include "HeaderOracle.hpp"
@@ -90,6 +99,9 @@ const std::map<blockchain::Type, std::pair<block::Height, std::string>>
           "5ba3af2992073940ed9e5a9d9eef9194bbfba905d92b202eea44fcff00000000"}},
     };
 
+const std::size_t HeaderOracle::snapshot_batch_{10000};
+const std::size_t HeaderOracle::BestChainIndex::segment_size_{4096};
+
 HeaderOracle::HeaderOracle(
     const api::internal::Core& api,
     const internal::Network& network,
@@ -101,7 +113,103 @@ HeaderOracle::HeaderOracle(
     , database_(database)
     , chain_(type)
     , lock_()
+    , best_(load_index())
+{
+}
+
+HeaderOracle::BestChainIndex::BestChainIndex() noexcept
+    : segments_()
+    , tip_(-1)
+{
+}
+
+HeaderOracle::BestChainIndex::BestChainIndex(const BestChainIndex& rhs) noexcept
+    : segments_(rhs.segments_)
+    , tip_(rhs.tip_)
+{
+}
+
+auto HeaderOracle::BestChainIndex::Contains(
+    const block::Height height,
+    const ReadView hash) const noexcept -> bool
+{
+    const auto stored = Get(height);
+
+    return (false == stored.empty()) && (stored == hash);
+}
+
+auto HeaderOracle::BestChainIndex::Get(const block::Height height) const
+    noexcept -> ReadView
+{
+    if ((0 > height) || (height > tip_)) { return {}; }
+
+    const auto position = static_cast<std::size_t>(height);
+    const auto& segment = *segments_.at(position / segment_size_);
+    const auto offset = position % segment_size_;
+
+    if (segment.size() <= offset) { return {}; }
+
+    const auto& hash = segment.at(offset);
+
+    return {hash.data(), hash.size()};
+}
+
+auto HeaderOracle::BestChainIndex::mutable_segment(
+    const std::size_t index) noexcept -> Segment&
+{
+    while (segments_.size() <= index) {
+        auto& segment = segments_.emplace_back(std::make_shared<Segment>());
+        segment->reserve(segment_size_);
+    }
+
+    auto& segment = segments_.at(index);
+
+    // Segments inherited from a published snapshot must be copied before
+    // they are modified
+    if (1 != segment.use_count()) {
+        auto copy = std::make_shared<Segment>();
+        copy->reserve(segment_size_);
+        copy->assign(segment->cbegin(), segment->cend());
+        segment = std::move(copy);
+    }
+
+    return *segment;
+}
+
+auto HeaderOracle::BestChainIndex::Set(
+    const block::Height height,
+    const ReadView hash) noexcept -> void
+{
+    OT_ASSERT(0 <= height);
+    OT_ASSERT(sizeof(Hash) == hash.size());
+
+    const auto position = static_cast<std::size_t>(height);
+    auto& segment = mutable_segment(position / segment_size_);
+    const auto offset = position % segment_size_;
+
+    if (segment.size() <= offset) { segment.resize(offset + 1); }
+
+    std::memcpy(segment.at(offset).data(), hash.data(), hash.size());
+    tip_ = std::max(tip_, height);
+}
+
+auto HeaderOracle::BestChainIndex::Truncate(const block::Height tip) noexcept
+    -> void
 {
+    if (tip >= tip_) { return; }
+
+    if (0 > tip) {
+        segments_.clear();
+        tip_ = -1;
+
+        return;
+    }
+
+    const auto position = static_cast<std::size_t>(tip);
+    const auto index = position / segment_size_;
+    segments_.resize(index + 1);
+    mutable_segment(index).resize((position % segment_size_) + 1);
+    tip_ = tip;
 }
 
 auto HeaderOracle::AddCheckpoint(
@@ -128,7 +236,7 @@ auto HeaderOracle::AddCheckpoint(
 
     if (apply_checkpoint(lock, position, update)) {
 
-        return database_.ApplyUpdate(update);
+        return apply_update(lock, update);
     } else {
 
         return false;
@@ -149,23 +257,90 @@ auto HeaderOracle::AddHeaders(
 {
     if (0 == headers.size()) { return false; }
 
-    Lock lock(lock_);
-    auto update = UpdateTransaction{api_, database_};
-
-    for (auto& header : headers) {
+    for (const auto& header : headers) {
         if (false == bool(header)) {
             LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid header").Flush();
 
             return false;
         }
+    }
+
+    // A batch containing any header with insufficient proof of work is
+    // rejected outright rather than retried one header at a time
+    if (false == verify_work(headers)) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid proof of work").Flush();
+
+        return false;
+    }
+
+    Lock lock(lock_);
+    auto update = UpdateTransaction{api_, database_};
+
+    // The fast path declines batches which are not a contiguous extension of
+    // the current best chain. Those go through the candidate machinery below.
+    if (add_headers_fast(lock, update, headers)) {
+
+        return apply_update(lock, update);
+    }
 
+    for (auto& header : headers) {
         if (false == add_header(lock, update, std::move(header))) {
 
             return false;
         }
     }
 
-    return database_.ApplyUpdate(update);
+    return apply_update(lock, update);
+}
+
+auto HeaderOracle::add_headers_fast(
+    const Lock& lock,
+    UpdateTransaction& update,
+    std::vector<std::unique_ptr<block::Header>>& headers) noexcept -> bool
+{
+    const auto& tip = update.Stage();
+    const block::Hash* pPrevious{&tip.Hash()};
+
+    for (const auto& header : headers) {
+        if (false == bool(header)) { return false; }
+
+        if (header->ParentHash() != *pPrevious) { return false; }
+
+        const auto& hash = header->Hash();
+
+        if (update.EffectiveHeaderExists(hash)) { return false; }
+
+        // Previously received descendants must be connected by the candidate
+        // machinery
+        if (update.EffectiveHasDisconnectedChildren(hash)) { return false; }
+
+        pPrevious = &hash;
+    }
+
+    const auto [checkpointHeight, checkpointHash] = update.Checkpoint();
+    const auto offset = checkpointHeight - (tip.Height() + 1);
+
+    if ((0 <= offset) &&
+        (offset < static_cast<block::Height>(headers.size()))) {
+        const auto& header = *headers.at(static_cast<std::size_t>(offset));
+
+        if (header.Hash() != checkpointHash.get()) { return false; }
+    }
+
+    const block::Header* pParent = &tip;
+
+    for (auto& pHeader : headers) {
+        auto& header = update.Stage(std::move(pHeader));
+        const auto blacklisted =
+            connect_to_parent(lock, update, *pParent, header);
+
+        OT_ASSERT(false == blacklisted);
+
+        update.ExtendBestChain(header.Position());
+        pParent = &header;
+    }
+
+    return true;
 }
 
 auto HeaderOracle::add_header(
@@ -173,6 +348,12 @@ auto HeaderOracle::add_header(
     UpdateTransaction& update,
     std::unique_ptr<block::Header> pHeader) noexcept -> bool
 {
+    if (false == pHeader->Valid()) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid proof of work").Flush();
+
+        return false;
+    }
+
     if (update.EffectiveHeaderExists(pHeader->Hash())) {
         LogVerbose(OT_METHOD)(__FUNCTION__)(": Header already processed")
             .Flush();
@@ -267,29 +448,46 @@ auto HeaderOracle::apply_checkpoint(
     }
 }
 
-auto HeaderOracle::best_chain(const Lock& lock) const noexcept
-    -> block::Position
+auto HeaderOracle::apply_update(
+    const Lock& lock,
+    const UpdateTransaction& update) noexcept -> bool
+{
+    if (false == database_.ApplyUpdate(update)) { return false; }
+
+    auto next = std::make_shared<BestChainIndex>(*best_index());
+
+    if (update.HaveReorg()) { next->Truncate(update.ReorgParent().first); }
+
+    for (const auto& [height, hash] : update.BestChain()) {
+        next->Set(height, hash->Bytes());
+    }
+
+    std::atomic_store(&best_, std::shared_ptr<const BestChainIndex>{next});
+
+    return true;
+}
+
+auto HeaderOracle::best_index() const noexcept
+    -> std::shared_ptr<const BestChainIndex>
 {
-    return database_.CurrentBest()->Position();
+    return std::atomic_load(&best_);
 }
 
 auto HeaderOracle::BestChain() const noexcept -> block::Position
 {
-    Lock lock(lock_);
+    const auto index = best_index();
+    const auto tip = index->Tip();
+    const auto hash = index->Get(tip);
 
-    return best_chain(lock);
+    return {tip, Data::Factory(hash.data(), hash.size())};
 }
 
 auto HeaderOracle::BestHash(const block::Height height) const noexcept
     -> block::pHash
 {
-    Lock lock(lock_);
+    const auto hash = best_index()->Get(height);
 
-    try {
-        return database_.BestBlock(height);
-    } catch (...) {
-        return make_blank<block::pHash>::value(api_);
-    }
+    return Data::Factory(hash.data(), hash.size());
 }
 
 auto HeaderOracle::choose_candidate(
@@ -366,30 +564,50 @@ auto HeaderOracle::choose_candidate(
 auto HeaderOracle::CommonParent(const block::Position& position) const noexcept
     -> std::pair<block::Position, block::Position>
 {
-    Lock lock(lock_);
-    const auto& database = database_;
+    const auto index = best_index();
+    const auto tip = index->Tip();
+    const auto tipHash = index->Get(tip);
     std::pair<block::Position, block::Position> output{
-        {0, GenesisBlockHash(chain_)}, best_chain(lock)};
+        {0, GenesisBlockHash(chain_)},
+        {tip, Data::Factory(tipHash.data(), tipHash.size())}};
     auto& [parent, best] = output;
-    auto test{position};
-    auto pHeader = database.TryLoadHeader(test.second);
+    // Walk the stored records in place so no header objects are constructed
+    auto current = std::array<char, 32>{};
+    auto next = std::array<char, 32>{};
+    auto height = block::Height{-1};
+    const auto load = [&]() -> bool {
+        auto found{false};
+        database_.LoadHeaderView(
+            ReadView{current.data(), current.size()}, [&](const auto& view) {
+                const auto parentHash = view.ParentHash();
+                height = view.Height();
+                found = (next.size() == parentHash.size());
+
+                if (found) {
+                    std::memcpy(next.data(), parentHash.data(), next.size());
+                }
+            });
 
-    if (false == bool(pHeader)) { return output; }
+        return found;
+    };
+    const auto start = position.second->Bytes();
 
-    while (0 < test.first) {
-        if (is_in_best_chain(lock, test.second)) {
-            parent = test;
+    if ((0 >= position.first) || (current.size() != start.size())) {
+        return output;
+    }
 
-            return output;
-        }
+    std::memcpy(current.data(), start.data(), current.size());
 
-        pHeader = database.TryLoadHeader(pHeader->ParentHash());
+    while (load() && (0 < height)) {
+        const auto hash = ReadView{current.data(), current.size()};
+
+        if (index->Contains(height, hash)) {
+            parent = {height, Data::Factory(hash.data(), hash.size())};
 
-        if (pHeader) {
-            test = pHeader->Position();
-        } else {
             return output;
         }
+
+        current = next;
     }
 
     return output;
@@ -462,7 +680,7 @@ auto HeaderOracle::DeleteCheckpoint() noexcept -> bool
 
     if (apply_checkpoint(lock, position, update)) {
 
-        return database_.ApplyUpdate(update);
+        return apply_update(lock, update);
     } else {
 
         return false;
@@ -483,6 +701,89 @@ auto HeaderOracle::GetCheckpoint() const noexcept -> block::Position
     return database_.CurrentCheckpoint();
 }
 
+auto HeaderOracle::ImportSnapshot(const internal::Snapshot& snapshot) noexcept
+    -> bool
+{
+    if (chain_ != snapshot.Chain()) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(
+            ": Snapshot is for a different chain")
+            .Flush();
+
+        return false;
+    }
+
+    const auto count = snapshot.Count();
+
+    if (0 == count) { return true; }
+
+    const auto tip = best_index()->Tip();
+
+    if (snapshot.Height(count - 1) <= tip) { return true; }
+
+    if (snapshot.Start() > (tip + 1)) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(
+            ": Snapshot does not connect to the best chain")
+            .Flush();
+
+        return false;
+    }
+
+    auto i = static_cast<std::size_t>((tip + 1) - snapshot.Start());
+
+    if (false == verify_snapshot(snapshot, i, tip)) { return false; }
+
+    while (i < count) {
+        const auto end = std::min(count, i + snapshot_batch_);
+        auto headers = std::vector<std::unique_ptr<block::Header>>{};
+        headers.reserve(end - i);
+
+        for (; i < end; ++i) {
+            const auto& raw = snapshot.Record(i).header_;
+            auto header = api_.Factory().BlockHeader(
+                chain_,
+                api_.Factory().Data(ReadView{
+                    reinterpret_cast<const char*>(raw.data()), raw.size()}));
+
+            if (false == bool(header)) {
+                LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid header").Flush();
+
+                return false;
+            }
+
+            headers.emplace_back(std::move(header));
+        }
+
+        if (false == verify_work(headers)) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Invalid proof of work in snapshot before height ")(
+                snapshot.Height(end - 1))
+                .Flush();
+
+            return false;
+        }
+
+        Lock lock(lock_);
+        auto update = UpdateTransaction{api_, database_};
+
+        if (false == add_headers_fast(lock, update, headers)) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Snapshot headers failed validation at height ")(
+                snapshot.Height(end - headers.size()))
+                .Flush();
+
+            return false;
+        }
+
+        if (false == apply_update(lock, update)) { return false; }
+
+        LogNormal(blockchain::internal::DisplayString(chain_))(
+            " imported snapshot headers to height ")(snapshot.Height(end - 1))
+            .Flush();
+    }
+
+    return true;
+}
+
 auto HeaderOracle::initialize_candidate(
     const Lock& lock,
     const block::Header& best,
@@ -524,9 +825,7 @@ auto HeaderOracle::initialize_candidate(
 
 auto HeaderOracle::IsInBestChain(const block::Hash& hash) const noexcept -> bool
 {
-    Lock lock(lock_);
-
-    return is_in_best_chain(lock, hash);
+    return is_in_best_chain(*best_index(), hash.Bytes());
 }
 
 auto HeaderOracle::is_disconnected(
@@ -549,22 +848,40 @@ auto HeaderOracle::is_disconnected(
     }
 }
 
-auto HeaderOracle::is_in_best_chain(const Lock& lock, const block::Hash& hash)
-    const noexcept -> bool
+auto HeaderOracle::is_in_best_chain(
+    const BestChainIndex& index,
+    const ReadView hash) const noexcept -> bool
 {
-    const auto pHeader = database_.TryLoadHeader(hash);
+    auto height = block::Height{-1};
+    const auto found = database_.LoadHeaderView(
+        hash, [&](const auto& view) { height = view.Height(); });
 
-    if (false == bool(pHeader)) { return false; }
+    if (false == found) { return false; }
 
-    const auto& header = *pHeader;
+    return index.Contains(height, hash);
+}
 
-    try {
-        return hash == database_.BestBlock(header.Height());
+auto HeaderOracle::load_index() const noexcept
+    -> std::shared_ptr<const BestChainIndex>
+{
+    auto output = std::make_shared<BestChainIndex>();
+    const auto pBest = database_.CurrentBest();
 
-    } catch (...) {
+    OT_ASSERT(pBest);
 
-        return false;
+    for (auto height = block::Height{0}; height <= pBest->Height(); ++height) {
+        try {
+            output->Set(height, database_.BestBlock(height)->Bytes());
+        } catch (...) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Missing best block at height ")(height)
+                .Flush();
+
+            OT_FAIL;
+        }
     }
+
+    return output;
 }
 
 auto HeaderOracle::LoadHeader(const block::Hash& hash) const noexcept
@@ -609,4 +926,139 @@ auto HeaderOracle::Siblings() const noexcept -> std::set<block::pHash>
 
     return database_.SiblingHashes();
 }
+
+auto HeaderOracle::verify_snapshot(
+    const internal::Snapshot& snapshot,
+    const std::size_t first,
+    const block::Height tip) const noexcept -> bool
+{
+    using Checkpoint = std::pair<block::Height, OTData>;
+
+    const auto view = [](const auto& in) -> ReadView {
+        return {reinterpret_cast<const char*>(in.data()), in.size()};
+    };
+    auto checkpoints = std::vector<Checkpoint>{};
+
+    {
+        const auto it = checkpoints_.find(chain_);
+
+        if (checkpoints_.cend() != it) {
+            const auto& [height, hex] = it->second;
+            checkpoints.emplace_back(
+                height, Data::Factory(hex, Data::Mode::Hex));
+        }
+    }
+
+    {
+        auto [height, hash] = GetCheckpoint();
+
+        if (0 < height) { checkpoints.emplace_back(height, std::move(hash)); }
+    }
+
+    auto previous = blockchain::internal::Sha256Digest{};
+
+    {
+        const auto hash = BestHash(tip);
+
+        if (previous.size() != hash->size()) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Missing best chain tip")
+                .Flush();
+
+            return false;
+        }
+
+        std::memcpy(previous.data(), hash->data(), previous.size());
+    }
+
+    const auto count = snapshot.Count();
+    auto height = tip;
+
+    for (auto i{first}; i < count; ++i) {
+        const auto& raw = snapshot.Record(i).header_;
+        const auto* parent = raw.data() + 4;
+        height = snapshot.Height(i);
+
+        if (0 != std::memcmp(parent, previous.data(), previous.size())) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Snapshot does not connect to the best chain at height ")(
+                height)
+                .Flush();
+
+            return false;
+        }
+
+        previous = blockchain::internal::DoubleSha256({view(raw)});
+
+        for (const auto& [checkpointHeight, checkpointHash] : checkpoints) {
+            if ((checkpointHeight == height) &&
+                (checkpointHash->Bytes() != view(previous))) {
+                LogOutput(OT_METHOD)(__FUNCTION__)(
+                    ": Snapshot does not match checkpoint at height ")(height)
+                    .Flush();
+
+                return false;
+            }
+        }
+    }
+
+    // A snapshot which stops short of a checkpoint has not been anchored to
+    // it, no matter how valid its proof of work
+    for (const auto& [checkpointHeight, checkpointHash] : checkpoints) {
+        if ((checkpointHeight > tip) && (checkpointHeight > height)) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Snapshot ends before checkpoint at height ")(
+                checkpointHeight)
+                .Flush();
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+auto HeaderOracle::verify_work(
+    const std::vector<std::unique_ptr<block::Header>>& headers) noexcept -> bool
+{
+    constexpr auto minimum = std::size_t{250};
+    const auto count = headers.size();
+    const auto threads = std::max(
+        std::size_t{1},
+        std::min(
+            static_cast<std::size_t>(std::thread::hardware_concurrency()),
+            count / minimum));
+    const auto check = [&headers](
+                           const std::size_t begin,
+                           const std::size_t end) -> bool {
+        for (auto i{begin}; i < end; ++i) {
+            if (false == headers.at(i)->Valid()) { return false; }
+        }
+
+        return true;
+    };
+
+    if (1 == threads) { return check(0, count); }
+
+    try {
+        const auto step = (count + threads - 1) / threads;
+        auto jobs = std::vector<std::future<bool>>{};
+
+        for (auto begin{std::size_t{0}}; begin < count; begin += step) {
+            jobs.emplace_back(std::async(
+                std::launch::async,
+                check,
+                begin,
+                std::min(begin + step, count)));
+        }
+
+        auto output{true};
+
+        for (auto& job : jobs) { output &= job.get(); }
+
+        return output;
+    } catch (...) {
+
+        return check(0, count);
+    }
+}
 }  // namespace opentxs::blockchain::client::implementation
@@ -31,6 +31,7 @@ public:
     bool AddHeaders(
         std::vector<std::unique_ptr<block::Header>>&) noexcept final;
     bool DeleteCheckpoint() noexcept final;
+    bool ImportSnapshot(const internal::Snapshot& snapshot) noexcept final;
 
     HeaderOracle(
         const api::internal::Core& api,
@@ -50,32 +51,88 @@ private:
 
     using Candidates = std::vector<Candidate>;
 
+    // Best chain hashes indexed by height
+    //
+    // Published snapshots are immutable and are read without locking. The
+    // writer builds the next snapshot from a copy of the current one, which
+    // shares every segment that was not modified by the update.
+    struct BestChainIndex {
+        using Hash = std::array<char, 32>;
+        using Segment = std::vector<Hash>;
+
+        auto Contains(const block::Height height, const ReadView hash) const
+            noexcept -> bool;
+        // Returns an empty view if the height is not in the best chain
+        auto Get(const block::Height height) const noexcept -> ReadView;
+        auto Tip() const noexcept -> block::Height { return tip_; }
+
+        auto Set(const block::Height height, const ReadView hash) noexcept
+            -> void;
+        auto Truncate(const block::Height tip) noexcept -> void;
+
+        BestChainIndex() noexcept;
+        BestChainIndex(const BestChainIndex& rhs) noexcept;
+
+    private:
+        static const std::size_t segment_size_;
+
+        std::vector<std::shared_ptr<Segment>> segments_;
+        block::Height tip_;
+
+        auto mutable_segment(const std::size_t index) noexcept -> Segment&;
+
+        BestChainIndex(BestChainIndex&&) = delete;
+        BestChainIndex& operator=(const BestChainIndex&) = delete;
+        BestChainIndex& operator=(BestChainIndex&&) = delete;
+    };
+
     static const std::
         map<blockchain::Type, std::pair<block::Height, std::string>>
             checkpoints_;
+    static const std::size_t snapshot_batch_;
 
     const api::internal::Core& api_;
     const internal::Network& network_;
     const internal::HeaderDatabase& database_;
     const blockchain::Type chain_;
     mutable std::mutex lock_;
+    std::shared_ptr<const BestChainIndex> best_;
 
     static bool evaluate_candidate(
         const block::Header& current,
         const block::Header& candidate) noexcept;
+    static bool verify_work(
+        const std::vector<std::unique_ptr<block::Header>>& headers) noexcept;
 
-    block::Position best_chain(const Lock& lock) const noexcept;
-    bool is_in_best_chain(const Lock& lock, const block::Hash& hash) const
-        noexcept;
+    std::shared_ptr<const BestChainIndex> best_index() const noexcept;
+    bool is_in_best_chain(const BestChainIndex& index, const ReadView hash)
+        const noexcept;
+    std::shared_ptr<const BestChainIndex> load_index() const noexcept;
+    // Checks that the snapshot records from index first onward form a hash
+    // chain extending the best chain at tip and that they reach and match
+    // every checkpoint above tip
+    bool verify_snapshot(
+        const internal::Snapshot& snapshot,
+        const std::size_t first,
+        const block::Height tip) const noexcept;
 
     bool add_header(
         const Lock& lock,
         UpdateTransaction& update,
         std::unique_ptr<block::Header> header) noexcept;
+    // Returns false without staging any headers if they do not form a valid
+    // contiguous extension of the best chain
+    bool add_headers_fast(
+        const Lock& lock,
+        UpdateTransaction& update,
+        std::vector<std::unique_ptr<block::Header>>& headers) noexcept;
     bool apply_checkpoint(
         const Lock& lock,
         const block::Height height,
         UpdateTransaction& update) noexcept;
+    bool apply_update(
+        const Lock& lock,
+        const UpdateTransaction& update) noexcept;
     std::pair<bool, bool> choose_candidate(
         const block::Header& current,
         const Candidates& candidates,
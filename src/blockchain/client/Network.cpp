@@ -7,14 +7,17 @@
 
 #include "opentxs/api/Core.hpp"
 #include "opentxs/api/Endpoints.hpp"
+#include "opentxs/api/Legacy.hpp"
 #include "opentxs/blockchain/block/Header.hpp"
 #include "opentxs/core/Log.hpp"
+#include "opentxs/core/String.hpp"
 #include "opentxs/network/zeromq/socket/Sender.tpp"
 #include "opentxs/network/zeromq/Frame.hpp"
 #include "opentxs/network/zeromq/FrameIterator.hpp"
 #include "opentxs/network/zeromq/FrameSection.hpp"
 #include "opentxs/network/zeromq/Message.hpp"
 
+#include "api/client/blockchain/database/Database.hpp"
 #include "internal/api/Api.hpp"
 
 #include "Network.hpp"
@@ -23,6 +26,8 @@
 
 namespace opentxs::blockchain::client::implementation
 {
+const std::string Network::snapshot_file_{"snapshot"};
+
 Network::Network(
     const api::internal::Core& api,
     const api::client::internal::Blockchain& blockchain,
@@ -49,6 +54,7 @@ Network::Network(
           api,
           *this,
           *database_p_,
+          blockchain.IO(),
           type,
           shutdown_sender_.endpoint_))
     , wallet_p_()
@@ -107,8 +113,34 @@ auto Network::GetPeerCount() const noexcept -> std::size_t
     return peer_.GetPeerCount();
 }
 
+auto Network::import_snapshot() noexcept -> void
+{
+    const auto folder =
+        String::Factory(parent_.BlockchainDB().AllocateStorageFolder(
+            std::to_string(static_cast<std::uint32_t>(chain_))));
+    auto path = String::Factory();
+
+    if (false == api_.Legacy().AppendFile(
+                     path, folder, String::Factory(snapshot_file_))) {
+        return;
+    }
+
+    const auto snapshot = Factory::BlockchainSnapshot(path->Get());
+
+    if (false == bool(snapshot)) { return; }
+
+    LogNormal(blockchain::internal::DisplayString(chain_))(
+        " importing snapshot from ")(path)
+        .Flush();
+
+    if (header_.ImportSnapshot(*snapshot)) {
+        filters_.ImportSnapshot(*snapshot);
+    }
+}
+
 auto Network::init() noexcept -> void
 {
+    import_snapshot();
     local_chain_height_.store(header_.BestChain().first);
 
     {
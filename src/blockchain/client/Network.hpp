@@ -29,6 +29,10 @@ class Network : virtual public internal::Network, public Executor<Network>
 public:
     bool AddPeer(const p2p::Address& address) const noexcept final;
     Type Chain() const noexcept final { return chain_; }
+    const internal::FilterOracle& FilterOracle() const noexcept final
+    {
+        return filters_;
+    }
     ChainHeight GetConfirmations(const std::string& txid) const noexcept final;
     ChainHeight GetHeight() const noexcept final
     {
@@ -115,11 +119,14 @@ private:
     OTFlag processing_headers_;
     int task_id_;
 
+    static const std::string snapshot_file_;
+
     static auto shutdown_endpoint() noexcept -> std::string;
 
     virtual std::unique_ptr<block::Header> instantiate_header(
         const ReadView payload) const noexcept = 0;
 
+    auto import_snapshot() noexcept -> void;
     auto pipeline(zmq::Message& in) noexcept -> void;
     auto process_cfheader(zmq::Message& in) noexcept -> void;
     auto process_filter(zmq::Message& in) noexcept -> void;
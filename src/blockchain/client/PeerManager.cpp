@@ -22,6 +22,7 @@
 #include "opentxs/network/zeromq/ListenCallback.hpp"
 #include "opentxs/network/zeromq/Message.hpp"
 
+#include "blockchain/client/Scheduler.hpp"
 #include "core/Executor.hpp"
 #include "internal/api/Api.hpp"
 #include "internal/blockchain/client/Client.hpp"
@@ -32,12 +33,16 @@
 #include <atomic>
 #include <deque>
 #include <functional>
+#include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <queue>
 #include <random>
+#include <set>
 #include <thread>
+#include <vector>
 
 #include "PeerManager.hpp"
 
@@ -135,6 +140,7 @@ PeerManager::PeerManager(
           chain,
           seednode,
           io_context_)
+    , scheduler_()
     , heartbeat_task_()
 {
     init_executor({shutdown});
@@ -143,23 +149,15 @@ PeerManager::PeerManager(
 PeerManager::Jobs::Jobs(const api::internal::Core& api) noexcept
     : zmq_(api.ZeroMQ())
     , getheaders_(api.ZeroMQ().PushSocket(zmq::socket::Socket::Direction::Bind))
-    , getcfheaders_(
-          api.ZeroMQ().PushSocket(zmq::socket::Socket::Direction::Bind))
-    , getcfilters_(
-          api.ZeroMQ().PushSocket(zmq::socket::Socket::Direction::Bind))
     , heartbeat_(api.ZeroMQ().PublishSocket())
     , endpoint_map_()
     , socket_map_({
           {Task::Getheaders, &getheaders_.get()},
-          {Task::Getcfheaders, &getcfheaders_.get()},
-          {Task::Getcfilters, &getcfilters_.get()},
           {Task::Heartbeat, &heartbeat_.get()},
       })
 {
     // NOTE endpoint_map_ should never be modified after construction
     listen(Task::Getheaders, getheaders_);
-    listen(Task::Getcfheaders, getcfheaders_);
-    listen(Task::Getcfilters, getcfilters_);
     listen(Task::Heartbeat, heartbeat_);
 }
 
@@ -268,7 +266,12 @@ auto PeerManager::Jobs::Work(const Task task, std::promise<void>* promise) const
 
 auto PeerManager::Peers::add_peer(Endpoint endpoint) noexcept -> void
 {
-    OT_ASSERT(endpoint);
+    if (false == bool(endpoint)) {
+        // Every known peer is either connected or banned
+        Sleep(std::chrono::milliseconds(10));
+
+        return;
+    }
 
     const auto address = OTIdentifier{endpoint->ID()};
     auto& count = active_[address];
@@ -417,11 +420,22 @@ auto PeerManager::Peers::get_dns_peer() const noexcept -> Endpoint
     }
 }
 
+auto PeerManager::Peers::connected() const noexcept -> std::set<OTIdentifier>
+{
+    auto output = std::set<OTIdentifier>{};
+
+    for (const auto& [address, count] : active_) {
+        if (0 < count) { output.emplace(address); }
+    }
+
+    return output;
+}
+
 auto PeerManager::Peers::get_fallback_peer(const p2p::Protocol protocol) const
     noexcept -> Endpoint
 {
     return database_.Get(
-        protocol, {p2p::Network::ipv4, p2p::Network::ipv6}, {});
+        protocol, {p2p::Network::ipv4, p2p::Network::ipv6}, {}, connected());
 }
 
 auto PeerManager::Peers::get_peer() const noexcept -> Endpoint
@@ -459,7 +473,7 @@ auto PeerManager::Peers::get_peer() const noexcept -> Endpoint
 
     pAddress = get_fallback_peer(protocol);
 
-    OT_ASSERT(pAddress);
+    if (false == bool(pAddress)) { return {}; }
 
     LogVerbose(OT_METHOD)(__FUNCTION__)(": Attempting to connect to peer: ")(
         pAddress->Display())
@@ -474,7 +488,8 @@ auto PeerManager::Peers::get_preferred_peer(const p2p::Protocol protocol) const
     return database_.Get(
         protocol,
         {p2p::Network::ipv4, p2p::Network::ipv6},
-        {p2p::Service::CompactFilters});
+        {p2p::Service::CompactFilters},
+        connected());
 }
 
 auto PeerManager::Peers::peer_factory(Endpoint endpoint, const int id) noexcept
@@ -558,6 +573,11 @@ auto PeerManager::Peers::Run(std::promise<bool>& promise) noexcept -> void
     }
 }
 
+auto PeerManager::Peers::SetTarget(const std::size_t target) noexcept -> void
+{
+    minimum_peers_.store(target);
+}
+
 auto PeerManager::Peers::Shutdown() noexcept -> void
 {
     OT_ASSERT(false == running_);
@@ -572,6 +592,27 @@ auto PeerManager::Peers::Shutdown() noexcept -> void
     active_.clear();
 }
 
+auto PeerManager::Peers::Submit(const int id, zmq::Message& work) noexcept
+    -> bool
+{
+    auto it = peers_.find(id);
+
+    if (peers_.end() == it) { return false; }
+
+    it->second->Submit(work);
+
+    return true;
+}
+
+auto PeerManager::AddDownloader(const int peer, const Task type) const noexcept
+    -> void
+{
+    if (false == running_.get()) { return; }
+
+    scheduler_.AddPeer(peer, type);
+    schedule();
+}
+
 auto PeerManager::AddPeer(const p2p::Address& address) const noexcept -> bool
 {
     if (false == running_.get()) { return false; }
@@ -607,6 +648,26 @@ auto PeerManager::Disconnect(const int id) const noexcept -> void
     pipeline_->Push(work);
 }
 
+auto PeerManager::dispatch() noexcept -> void
+{
+    for (const auto& [peer, unit] : scheduler_.Assign()) {
+        auto work = jobs_.Work(unit.type_);
+        work->AddFrame(unit.filter_);
+        work->AddFrame(unit.start_);
+        work->AddFrame(unit.stop_);
+
+        if (false == peers_.Submit(peer, work)) {
+            scheduler_.RemovePeer(peer);
+        }
+    }
+
+    // Connect to additional peers while a large amount of work is pending
+    const auto extra = std::min<std::size_t>(
+        max_peer_target_ - peer_target_,
+        scheduler_.Backlog() / (2 * Scheduler::max_outstanding_));
+    peers_.SetTarget(peer_target_ + extra);
+}
+
 auto PeerManager::init() noexcept -> void
 {
     heartbeat_task_ = api_.Schedule(
@@ -628,7 +689,10 @@ auto PeerManager::pipeline(zmq::Message& message) noexcept -> void
 
             OT_ASSERT(0 < body.size());
 
-            peers_.Disconnect(body.at(0).as<int>());
+            const auto id = body.at(0).as<int>();
+            peers_.Disconnect(id);
+            scheduler_.RemovePeer(id);
+            dispatch();
         } break;
         case Work::AddPeer: {
             const auto body = message.Body();
@@ -648,7 +712,11 @@ auto PeerManager::pipeline(zmq::Message& message) noexcept -> void
 
             peers_.AddPeer(address, promise);
         } break;
+        case Work::Schedule: {
+            dispatch();
+        } break;
         case Work::StateMachine: {
+            dispatch();
             peers_.Run(state_machine_);
         } break;
         case Work::Shutdown: {
@@ -660,6 +728,17 @@ auto PeerManager::pipeline(zmq::Message& message) noexcept -> void
     }
 }
 
+auto PeerManager::Received(
+    const int peer,
+    const Task type,
+    const block::Hash& block,
+    const std::size_t bytes) const noexcept -> void
+{
+    if (false == running_.get()) { return; }
+
+    if (scheduler_.Received(peer, type, block, bytes)) { schedule(); }
+}
+
 auto PeerManager::RequestFilterHeaders(
     const filter::Type type,
     const block::Height start,
@@ -669,11 +748,8 @@ auto PeerManager::RequestFilterHeaders(
 
     if (0 == peers_.Count()) { return; }
 
-    auto work = jobs_.Work(Task::Getcfheaders);
-    work->AddFrame(type);
-    work->AddFrame(start);
-    work->AddFrame(stop);
-    jobs_.Dispatch(work);
+    scheduler_.Queue(Task::Getcfheaders, type, start, stop);
+    schedule();
 }
 
 auto PeerManager::RequestFilters(
@@ -685,11 +761,8 @@ auto PeerManager::RequestFilters(
 
     if (0 == peers_.Count()) { return; }
 
-    auto work = jobs_.Work(Task::Getcfilters);
-    work->AddFrame(type);
-    work->AddFrame(start);
-    work->AddFrame(stop);
-    jobs_.Dispatch(work);
+    scheduler_.Queue(Task::Getcfilters, type, start, stop);
+    schedule();
 }
 
 auto PeerManager::RequestHeaders() const noexcept -> void
@@ -701,6 +774,11 @@ auto PeerManager::RequestHeaders() const noexcept -> void
     jobs_.Dispatch(Task::Getheaders);
 }
 
+auto PeerManager::schedule() const noexcept -> void
+{
+    pipeline_->Push(MakeWork(Work::Schedule));
+}
+
 auto PeerManager::shutdown(std::promise<void>& promise) noexcept -> void
 {
     if (running_->Off()) {
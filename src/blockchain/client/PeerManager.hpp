@@ -17,6 +17,7 @@ public:
     static const std::map<Type, std::vector<std::string>> dns_seeds_;
     static const std::map<Type, p2p::Protocol> protocol_map_;
 
+    void AddDownloader(const int peer, const Task type) const noexcept final;
     bool AddPeer(const p2p::Address& address) const noexcept final;
     const internal::PeerDatabase& Database() const noexcept final
     {
@@ -30,6 +31,11 @@ public:
     }
     std::size_t GetPeerCount() const noexcept final { return peers_.Count(); }
     void Heartbeat() const noexcept { jobs_.Dispatch(Task::Heartbeat); }
+    void Received(
+        const int peer,
+        const Task type,
+        const block::Hash& block,
+        const std::size_t bytes) const noexcept final;
     void RequestFilterHeaders(
         const filter::Type type,
         const block::Height start,
@@ -79,8 +85,6 @@ private:
 
         const zmq::Context& zmq_;
         OTZMQPushSocket getheaders_;
-        OTZMQPushSocket getcfheaders_;
-        OTZMQPushSocket getcfilters_;
         OTZMQPublishSocket heartbeat_;
         const EndpointMap endpoint_map_;
         const SocketMap socket_map_;
@@ -99,7 +103,9 @@ private:
             std::promise<bool>& promise) noexcept -> void;
         auto Disconnect(const int id) noexcept -> void;
         auto Run(std::promise<bool>& promise) noexcept -> void;
+        auto SetTarget(const std::size_t target) noexcept -> void;
         auto Shutdown() noexcept -> void;
+        auto Submit(const int id, zmq::Message& work) noexcept -> bool;
 
         Peers(
             const api::internal::Core& api,
@@ -140,6 +146,7 @@ private:
             const Data& localhost,
             bool& invalidPeer) noexcept -> OTData;
 
+        auto connected() const noexcept -> std::set<OTIdentifier>;
         auto get_default_peer() const noexcept -> Endpoint;
         auto get_dns_peer() const noexcept -> Endpoint;
         auto get_fallback_peer(const p2p::Protocol protocol) const noexcept
@@ -156,18 +163,24 @@ private:
     enum class Work : OTZMQWorkType {
         Disconnect = 0,
         AddPeer = 1,
+        Schedule = 2,
         StateMachine = OT_ZMQ_STATE_MACHINE_SIGNAL,
         Shutdown = OT_ZMQ_SHUTDOWN_SIGNAL,
     };
 
     static const unsigned int peer_target_{2};
+    static const unsigned int max_peer_target_{8};
 
     const internal::PeerDatabase& database_;
     const internal::IO& io_context_;
     mutable Jobs jobs_;
     mutable Peers peers_;
+    mutable Scheduler scheduler_;
     int heartbeat_task_;
 
+    auto schedule() const noexcept -> void;
+
+    auto dispatch() noexcept -> void;
     auto pipeline(zmq::Message& message) noexcept -> void;
     auto shutdown(std::promise<void>& promise) noexcept -> void;
 
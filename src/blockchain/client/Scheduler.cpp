@@ -0,0 +1,362 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "stdafx.hpp"
+
+#include "Internal.hpp"
+
+#include "opentxs/core/Data.hpp"
+#include "opentxs/core/Log.hpp"
+
+#include "internal/blockchain/client/Client.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "Scheduler.hpp"
+
+#define OT_METHOD "opentxs::blockchain::client::implementation::Scheduler::"
+
+namespace opentxs::blockchain::client::implementation
+{
+const std::size_t Scheduler::max_outstanding_{2};
+const unsigned int Scheduler::max_attempts_{5};
+const std::chrono::seconds Scheduler::minimum_timeout_{10};
+const double Scheduler::initial_estimate_{2.0};
+const double Scheduler::weight_{0.3};
+
+Scheduler::Scheduler() noexcept
+    : lock_()
+    , waiting_()
+    , assigned_()
+    , peers_()
+{
+}
+
+auto Scheduler::AddPeer(const int peer, const Task type) noexcept -> void
+{
+    Lock lock(lock_);
+    peers_[peer].tasks_.emplace(type);
+}
+
+auto Scheduler::Assign(const Time now) noexcept -> std::vector<Assignment>
+{
+    auto output = std::vector<Assignment>{};
+    Lock lock(lock_);
+    expire(now);
+    fill(now, output);
+
+    if (waiting_.empty()) { steal(now, output); }
+
+    return output;
+}
+
+auto Scheduler::average(const double previous, const double sample) noexcept
+    -> double
+{
+    if (0 == previous) { return sample; }
+
+    return (weight_ * sample) + ((1.0 - weight_) * previous);
+}
+
+auto Scheduler::Backlog() const noexcept -> std::size_t
+{
+    Lock lock(lock_);
+
+    return waiting_.size() + assigned_.size();
+}
+
+auto Scheduler::choose(const Unit& unit) const noexcept -> int
+{
+    auto output{-1};
+    auto best = std::numeric_limits<double>::max();
+    auto fallback{-1};
+
+    for (const auto& [id, stats] : peers_) {
+        if (0 == stats.tasks_.count(unit.type_)) { continue; }
+
+        if (max_outstanding_ <= stats.outstanding_) { continue; }
+
+        // Prefer a different peer than the one which failed to deliver this
+        // unit, but use it anyway if nobody else is available
+        if (id == unit.previous_) {
+            fallback = id;
+
+            continue;
+        }
+
+        const auto finish = (stats.outstanding_ + 1) * estimate(stats);
+
+        if (finish < best) {
+            best = finish;
+            output = id;
+        }
+    }
+
+    return (-1 == output) ? fallback : output;
+}
+
+auto Scheduler::estimate(const Stats& stats) noexcept -> double
+{
+    // Untested peers get an optimistic estimate so they receive work and
+    // can be measured
+    return (0 == stats.duration_) ? initial_estimate_ : stats.duration_;
+}
+
+auto Scheduler::expire(const Time now) noexcept -> void
+{
+    auto expired = std::vector<Unit>{};
+
+    for (auto it{assigned_.begin()}; it != assigned_.end();) {
+        auto& unit = it->second;
+        auto stats = peers_.find(unit.peer_);
+        const auto limit = std::max(
+            static_cast<double>(minimum_timeout_.count()),
+            4.0 * ((peers_.end() == stats) ? initial_estimate_
+                                           : estimate(stats->second)));
+
+        if (seconds(unit.activity_, now) <= limit) {
+            ++it;
+
+            continue;
+        }
+
+        if (peers_.end() != stats) {
+            auto& peer = stats->second;
+            --peer.outstanding_;
+            ++peer.failed_;
+            peer.duration_ = std::max(
+                2.0 * estimate(peer), seconds(unit.issued_, now));
+        }
+
+        LogVerbose(OT_METHOD)(__FUNCTION__)(": Peer ")(
+            unit.peer_)(" timed out serving ")(unit.stop_->asHex())
+            .Flush();
+
+        if (max_attempts_ > unit.attempts_) {
+            unit.previous_ = unit.peer_;
+            unit.peer_ = -1;
+            expired.emplace_back(std::move(unit));
+        }
+
+        it = assigned_.erase(it);
+    }
+
+    // Retry expired units before anything which has not been started
+    std::sort(
+        expired.begin(), expired.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.start_ > rhs.start_;
+        });
+
+    for (auto& unit : expired) { waiting_.emplace_front(std::move(unit)); }
+}
+
+auto Scheduler::fill(const Time now, std::vector<Assignment>& output) noexcept
+    -> void
+{
+    for (auto it{waiting_.begin()}; it != waiting_.end();) {
+        auto& unit = *it;
+        const auto peer = choose(unit);
+
+        if (-1 == peer) {
+            ++it;
+
+            continue;
+        }
+
+        start(peer, unit, now);
+        output.emplace_back(peer, unit);
+        assigned_.emplace(unit.stop_, std::move(unit));
+        it = waiting_.erase(it);
+    }
+}
+
+auto Scheduler::Queue(
+    const Task type,
+    const filter::Type filter,
+    const block::Height start,
+    const block::Hash& stop) noexcept -> void
+{
+    Lock lock(lock_);
+
+    if (0 < assigned_.count(stop)) { return; }
+
+    for (const auto& unit : waiting_) {
+        if (unit.stop_ == stop) { return; }
+    }
+
+    waiting_.emplace_back(
+        Unit{type, filter, start, stop, -1, -1, Time{}, Time{}, 0, 0});
+}
+
+auto Scheduler::Received(
+    const int peer,
+    const Task type,
+    const block::Hash& block,
+    const std::size_t bytes,
+    const Time now) noexcept -> bool
+{
+    Lock lock(lock_);
+    auto complete = assigned_.find(block);
+
+    // The unit is complete whichever peer delivers it, including a peer it
+    // was taken from after a timeout. Only the current assignee's statistics
+    // are updated.
+    if ((assigned_.end() != complete) && (type == complete->second.type_)) {
+        auto& unit = complete->second;
+        auto stats = peers_.find(unit.peer_);
+
+        if (peers_.end() != stats) {
+            auto& assignee = stats->second;
+            --assignee.outstanding_;
+
+            if (unit.peer_ == peer) {
+                const auto elapsed = seconds(unit.issued_, now);
+                const auto total = unit.bytes_ + bytes;
+
+                if (0 == unit.bytes_) {
+                    assignee.latency_ = average(assignee.latency_, elapsed);
+                }
+
+                assignee.duration_ = average(assignee.duration_, elapsed);
+
+                if (0 < elapsed) {
+                    assignee.bandwidth_ =
+                        average(assignee.bandwidth_, total / elapsed);
+                }
+
+                ++assignee.completed_;
+                LogVerbose(OT_METHOD)(__FUNCTION__)(": Peer ")(
+                    peer)(" latency ")(
+                    static_cast<std::uint64_t>(assignee.latency_ * 1000))(
+                    " ms, bandwidth ")(
+                    static_cast<std::uint64_t>(assignee.bandwidth_))(
+                    " bytes/sec")
+                    .Flush();
+            }
+        }
+
+        assigned_.erase(complete);
+
+        return true;
+    }
+
+    // Peers answer requests in order so the message belongs to the oldest
+    // unit of this type assigned to the peer
+    auto* oldest = static_cast<Unit*>(nullptr);
+
+    for (auto& [stop, unit] : assigned_) {
+        if ((unit.peer_ != peer) || (unit.type_ != type)) { continue; }
+
+        if ((nullptr == oldest) || (unit.issued_ < oldest->issued_)) {
+            oldest = &unit;
+        }
+    }
+
+    if (nullptr != oldest) {
+        if (0 == oldest->bytes_) {
+            auto& stats = peers_[peer];
+            stats.latency_ =
+                average(stats.latency_, seconds(oldest->issued_, now));
+        }
+
+        oldest->bytes_ += bytes;
+        oldest->activity_ = now;
+    }
+
+    return false;
+}
+
+auto Scheduler::RemovePeer(const int peer) noexcept -> void
+{
+    Lock lock(lock_);
+    auto orphaned = std::vector<Unit>{};
+
+    for (auto it{assigned_.begin()}; it != assigned_.end();) {
+        auto& unit = it->second;
+
+        if (peer == unit.peer_) {
+            unit.previous_ = peer;
+            unit.peer_ = -1;
+            orphaned.emplace_back(std::move(unit));
+            it = assigned_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    std::sort(
+        orphaned.begin(),
+        orphaned.end(),
+        [](const auto& lhs, const auto& rhs) {
+            return lhs.start_ > rhs.start_;
+        });
+
+    for (auto& unit : orphaned) { waiting_.emplace_front(std::move(unit)); }
+
+    peers_.erase(peer);
+}
+
+auto Scheduler::seconds(const Time from, const Time to) noexcept -> double
+{
+    return std::chrono::duration<double>(to - from).count();
+}
+
+auto Scheduler::start(const int peer, Unit& unit, const Time now) noexcept
+    -> void
+{
+    unit.peer_ = peer;
+    unit.issued_ = now;
+    unit.activity_ = now;
+    unit.bytes_ = 0;
+    ++unit.attempts_;
+    ++peers_.at(peer).outstanding_;
+}
+
+auto Scheduler::steal(const Time now, std::vector<Assignment>& output) noexcept
+    -> void
+{
+    for (auto& [id, idle] : peers_) {
+        if (0 < idle.outstanding_) { continue; }
+
+        const auto fast = estimate(idle);
+        auto* slowest = static_cast<Unit*>(nullptr);
+
+        // Look for a unit which an idle peer is likely to finish sooner than
+        // the peer currently serving it
+        for (auto& [stop, unit] : assigned_) {
+            if (0 == idle.tasks_.count(unit.type_)) { continue; }
+
+            if (max_attempts_ <= unit.attempts_) { continue; }
+
+            const auto& current = peers_.at(unit.peer_);
+
+            if (estimate(current) < (2.0 * fast)) { continue; }
+
+            if (seconds(unit.issued_, now) < (2.0 * fast)) { continue; }
+
+            if ((nullptr == slowest) || (unit.issued_ < slowest->issued_)) {
+                slowest = &unit;
+            }
+        }
+
+        if (nullptr == slowest) { continue; }
+
+        LogVerbose(OT_METHOD)(__FUNCTION__)(
+            ": Moving slow unit from peer ")(slowest->peer_)(" to peer ")(id)
+            .Flush();
+        --peers_.at(slowest->peer_).outstanding_;
+        slowest->previous_ = slowest->peer_;
+        start(id, *slowest, now);
+        output.emplace_back(id, *slowest);
+    }
+}
+}  // namespace opentxs::blockchain::client::implementation
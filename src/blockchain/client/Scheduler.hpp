@@ -0,0 +1,119 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Internal.hpp"
+
+#include "internal/blockchain/client/Client.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace opentxs::blockchain::client::implementation
+{
+// Splits compact filter downloads across every peer able to serve them
+//
+// Each unit is assigned to the peer expected to finish it first, based on
+// the latency and throughput measured for the units it served before.
+// Units which stall or time out are moved to another peer.
+//
+// Block headers are not scheduled here. A getheaders request is a locator
+// walk from the current tip whose stop hash is unknown until the previous
+// response arrives, so header sync cannot be split into independent units.
+// Those requests stay on the getheaders push socket, which hands each one
+// to a single idle peer.
+class Scheduler
+{
+public:
+    using Task = internal::PeerManager::Task;
+
+    struct Unit {
+        Task type_;
+        filter::Type filter_;
+        block::Height start_;
+        block::pHash stop_;
+        int peer_;
+        int previous_;
+        Time issued_;
+        Time activity_;
+        std::size_t bytes_;
+        unsigned int attempts_;
+    };
+
+    using Assignment = std::pair<int, Unit>;
+
+    OPENTXS_EXPORT static const std::size_t max_outstanding_;
+    OPENTXS_EXPORT static const std::chrono::seconds minimum_timeout_;
+
+    OPENTXS_EXPORT auto Backlog() const noexcept -> std::size_t;
+
+    OPENTXS_EXPORT auto AddPeer(const int peer, const Task type) noexcept
+        -> void;
+    OPENTXS_EXPORT auto Assign(const Time now = Clock::now()) noexcept
+        -> std::vector<Assignment>;
+    OPENTXS_EXPORT auto Queue(
+        const Task type,
+        const filter::Type filter,
+        const block::Height start,
+        const block::Hash& stop) noexcept -> void;
+    // Returns true if the message completed a unit
+    OPENTXS_EXPORT auto Received(
+        const int peer,
+        const Task type,
+        const block::Hash& block,
+        const std::size_t bytes,
+        const Time now = Clock::now()) noexcept -> bool;
+    OPENTXS_EXPORT auto RemovePeer(const int peer) noexcept -> void;
+
+    OPENTXS_EXPORT Scheduler() noexcept;
+
+private:
+    struct Stats {
+        std::set<Task> tasks_{};
+        std::size_t outstanding_{0};
+        std::size_t completed_{0};
+        std::size_t failed_{0};
+        // Moving averages of previously completed units
+        double duration_{0};
+        double latency_{0};
+        double bandwidth_{0};
+    };
+
+    static const unsigned int max_attempts_;
+    static const double initial_estimate_;
+    static const double weight_;
+
+    mutable std::mutex lock_;
+    std::deque<Unit> waiting_;
+    std::map<block::pHash, Unit> assigned_;
+    std::map<int, Stats> peers_;
+
+    static auto average(const double previous, const double sample) noexcept
+        -> double;
+    static auto estimate(const Stats& stats) noexcept -> double;
+    static auto seconds(const Time from, const Time to) noexcept -> double;
+
+    auto choose(const Unit& unit) const noexcept -> int;
+
+    auto expire(const Time now) noexcept -> void;
+    auto fill(const Time now, std::vector<Assignment>& output) noexcept
+        -> void;
+    auto start(const int peer, Unit& unit, const Time now) noexcept -> void;
+    auto steal(const Time now, std::vector<Assignment>& output) noexcept
+        -> void;
+
+    Scheduler(const Scheduler&) = delete;
+    Scheduler(Scheduler&&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+    Scheduler& operator=(Scheduler&&) = delete;
+};
+}  // namespace opentxs::blockchain::client::implementation
@@ -0,0 +1,121 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "stdafx.hpp"
+
+#include "Internal.hpp"
+
+#include "opentxs/core/Log.hpp"
+
+#include "internal/blockchain/client/Client.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "Snapshot.hpp"
+
+#define OT_METHOD "opentxs::Factory::"
+
+namespace opentxs
+{
+auto Factory::BlockchainSnapshot(const std::string& path) noexcept
+    -> std::unique_ptr<blockchain::client::internal::Snapshot>
+{
+    using ReturnType = blockchain::client::implementation::Snapshot;
+    using Header = blockchain::client::internal::SnapshotHeader;
+    using Record = blockchain::client::internal::SnapshotRecord;
+
+#ifdef _WIN32
+    LogOutput(OT_METHOD)(__FUNCTION__)(
+        ": Snapshots are not supported on this platform")
+        .Flush();
+
+    return {};
+#else
+    const auto fd = ::open(path.c_str(), O_RDONLY);
+
+    if (0 > fd) { return {}; }
+
+    struct stat info {
+    };
+
+    if ((0 != ::fstat(fd, &info)) ||
+        (sizeof(Header) > static_cast<std::size_t>(info.st_size))) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid snapshot file ")(path)
+            .Flush();
+        ::close(fd);
+
+        return {};
+    }
+
+    const auto size = static_cast<std::size_t>(info.st_size);
+    auto* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (MAP_FAILED == data) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to map ")(path).Flush();
+        ::close(fd);
+
+        return {};
+    }
+
+    // Records are read once in order during import
+    ::madvise(data, size, MADV_SEQUENTIAL);
+    const auto& header = *reinterpret_cast<const Header*>(data);
+    const auto& magic = blockchain::client::internal::Snapshot::magic_;
+    const auto count = header.count_.value();
+    const auto valid =
+        (0 == std::memcmp(header.magic_.data(), magic.data(), magic.size())) &&
+        (0 < header.start_.value()) &&
+        (count <= ((size - sizeof(Header)) / sizeof(Record))) &&
+        (size == (sizeof(Header) + (count * sizeof(Record))));
+
+    if (false == valid) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid snapshot file ")(path)
+            .Flush();
+        ::munmap(data, size);
+        ::close(fd);
+
+        return {};
+    }
+
+    return std::make_unique<ReturnType>(fd, data, size);
+#endif
+}
+}  // namespace opentxs
+
+namespace opentxs::blockchain::client::implementation
+{
+Snapshot::Snapshot(
+    const int fd,
+    void* data,
+    const std::size_t size) noexcept
+    : fd_(fd)
+    , data_(data)
+    , size_(size)
+    , header_(*reinterpret_cast<const internal::SnapshotHeader*>(data))
+    , records_(reinterpret_cast<const internal::SnapshotRecord*>(
+          reinterpret_cast<const char*>(data) +
+          sizeof(internal::SnapshotHeader)))
+{
+    static_assert(32 == sizeof(internal::SnapshotHeader));
+    static_assert(144 == sizeof(internal::SnapshotRecord));
+}
+
+Snapshot::~Snapshot()
+{
+#ifndef _WIN32
+    ::munmap(data_, size_);
+    ::close(fd_);
+#endif
+}
+}  // namespace opentxs::blockchain::client::implementation
@@ -0,0 +1,56 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+namespace opentxs::blockchain::client::implementation
+{
+class Snapshot final : virtual public internal::Snapshot
+{
+public:
+    blockchain::Type Chain() const noexcept final
+    {
+        return static_cast<blockchain::Type>(header_.chain_.value());
+    }
+    std::size_t Count() const noexcept final
+    {
+        return static_cast<std::size_t>(header_.count_.value());
+    }
+    filter::Type FilterType() const noexcept final
+    {
+        return static_cast<filter::Type>(header_.filter_.value());
+    }
+    block::Height Height(const std::size_t index) const noexcept final
+    {
+        return Start() + static_cast<block::Height>(index);
+    }
+    const internal::SnapshotRecord& Record(const std::size_t index) const
+        noexcept final
+    {
+        return records_[index];
+    }
+    block::Height Start() const noexcept final
+    {
+        return header_.start_.value();
+    }
+
+    Snapshot(const int fd, void* data, const std::size_t size) noexcept;
+
+    ~Snapshot() final;
+
+private:
+    const int fd_;
+    void* const data_;
+    const std::size_t size_;
+    const internal::SnapshotHeader& header_;
+    const internal::SnapshotRecord* const records_;
+
+    Snapshot() = delete;
+    Snapshot(const Snapshot&) = delete;
+    Snapshot(Snapshot&&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+    Snapshot& operator=(Snapshot&&) = delete;
+};
+}  // namespace opentxs::blockchain::client::implementation
@@ -153,6 +153,12 @@ auto UpdateTransaction::EffectiveHeaderExists(const block::Hash& hash) const
     return db_.HeaderExists(hash);
 }
 
+auto UpdateTransaction::ExtendBestChain(const block::Position& position)
+    -> void
+{
+    best_.emplace(position);
+}
+
 auto UpdateTransaction::Header(const block::Hash& hash) noexcept(false)
     -> block::Header&
 {
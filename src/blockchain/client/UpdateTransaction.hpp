@@ -49,6 +49,8 @@ public:
     void ClearCheckpoint();
     void ConnectBlock(ChainSegment&& segment);
     void DisconnectBlock(const block::Header& header);
+    // Appends a new header to the best chain without sibling bookkeeping
+    void ExtendBestChain(const block::Position& position);
     // throws std::out_of_range if header does not exist
     block::Header& Header(const block::Hash& hash) noexcept(false);
     void RemoveSibling(const block::Hash& hash);
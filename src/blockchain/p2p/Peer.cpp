@@ -22,6 +22,8 @@
 #include "internal/api/Api.hpp"
 #include "internal/blockchain/Blockchain.hpp"
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
 
 #include "Peer.hpp"
@@ -73,6 +75,7 @@ Peer::Peer(
     , handshake_(handshake_promise_.get_future())
     , send_promises_()
     , activity_()
+    , session_()
     , state_(State::Handshake)
     , cb_(zmq::ListenCallback::Factory([&](auto& in) { pipeline_d(in); }))
     , dealer_(api.ZeroMQ().DealerSocket(
@@ -113,6 +116,12 @@ Peer::DownloadPeers::DownloadPeers() noexcept
 {
 }
 
+Peer::Session::Session() noexcept
+    : lock_()
+    , score_()
+{
+}
+
 Peer::SendPromises::SendPromises() noexcept
     : lock_()
     , counter_(0)
@@ -206,6 +215,47 @@ auto Peer::DownloadPeers::Bump() noexcept -> void
 
 auto Peer::DownloadPeers::get() const noexcept -> Time { return downloaded_; }
 
+auto Peer::Session::Bytes(const std::size_t bytes) noexcept -> void
+{
+    Lock lock(lock_);
+    score_.bytes_ += bytes;
+}
+
+auto Peer::Session::Failure() noexcept -> void
+{
+    Lock lock(lock_);
+    ++score_.failures_;
+}
+
+auto Peer::Session::Handshake() noexcept -> void
+{
+    Lock lock(lock_);
+    ++score_.handshakes_;
+}
+
+auto Peer::Session::Misbehavior() noexcept -> void
+{
+    Lock lock(lock_);
+    ++score_.misbehavior_;
+}
+
+auto Peer::Session::Reset() noexcept -> client::internal::PeerScore
+{
+    Lock lock(lock_);
+    auto output = score_;
+    score_ = {};
+
+    return output;
+}
+
+auto Peer::Session::RTT(const std::chrono::milliseconds rtt) noexcept -> void
+{
+    Lock lock(lock_);
+    const auto value = static_cast<std::uint32_t>(std::max<std::int64_t>(
+        1, std::min<std::int64_t>(rtt.count(), 60000)));
+    score_.rtt_ = (0 == score_.rtt_) ? value : (score_.rtt_ + value) / 2;
+}
+
 auto Peer::SendPromises::Break() -> void
 {
     Lock lock(lock_);
@@ -293,6 +343,7 @@ auto Peer::check_handshake() noexcept -> void
         try {
             state_.store(State::Run);
             handshake_promise_.set_value();
+            session_.Handshake();
             update_address_activity();
             LogNormal("Connected to ")(blockchain::internal::DisplayString(
                 address_.Chain()))(" peer at ")(address_.Display())
@@ -523,9 +574,11 @@ auto Peer::pipeline_d(zmq::Message& message) noexcept -> void
 
             OT_ASSERT(0 < body.size());
 
+            const auto& payload = body.at(0);
+            session_.Bytes(header_bytes_ + payload.size());
             auto message = MakeWork(Task::ReceiveMessage);
             message->AddFrame(header_);
-            message->AddFrame(body.at(0));
+            message->AddFrame(payload);
             pipeline_->Push(message);
             run();
         } break;
@@ -535,6 +588,14 @@ auto Peer::pipeline_d(zmq::Message& message) noexcept -> void
     }
 }
 
+auto Peer::misbehaving() noexcept -> void
+{
+    LogVerbose(OT_METHOD)(__FUNCTION__)(": Peer ")(address_.Display())(
+        " sent invalid data")
+        .Flush();
+    session_.Misbehavior();
+}
+
 auto Peer::process_state_machine() noexcept -> void
 {
     switch (state_.load()) {
@@ -547,6 +608,14 @@ auto Peer::process_state_machine() noexcept -> void
     }
 }
 
+auto Peer::received(
+    const Task type,
+    const block::Hash& block,
+    const std::size_t bytes) const noexcept -> void
+{
+    manager_.Received(id_, type, block, bytes);
+}
+
 auto Peer::run() noexcept -> void
 {
     if (running_.get()) {
@@ -615,7 +684,13 @@ auto Peer::shutdown(std::promise<void>& promise) noexcept -> void
         } catch (...) {
         }
 
-        if (State::Handshake != state) { update_address_activity(); }
+        if (State::Handshake == state) {
+            session_.Failure();
+        } else {
+            update_address_activity();
+        }
+
+        manager_.Database().Score(address_.ID(), session_.Reset());
 
         LogVerbose("Disconnected from ")(address_.Display()).Flush();
 
@@ -656,11 +731,9 @@ void Peer::subscribe_work() noexcept
             case Task::Getheaders: {
                 pipeline_->Start(manager_.Endpoint(Task::Getheaders));
             } break;
-            case Task::Getcfheaders: {
-                pipeline_->Start(manager_.Endpoint(Task::Getcfheaders));
-            } break;
+            case Task::Getcfheaders:
             case Task::Getcfilters: {
-                pipeline_->Start(manager_.Endpoint(Task::Getcfilters));
+                manager_.AddDownloader(id_, task);
             } break;
             default: {
                 OT_FAIL;
@@ -759,5 +832,10 @@ auto Peer::update_address_services(
     manager_.Database().AddOrUpdate(address_.UpdateServices(services));
 }
 
+auto Peer::update_rtt(const std::chrono::milliseconds rtt) noexcept -> void
+{
+    session_.RTT(rtt);
+}
+
 Peer::~Peer() { Shutdown().get(); }
 }  // namespace opentxs::blockchain::p2p::implementation
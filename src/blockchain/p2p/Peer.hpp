@@ -42,6 +42,7 @@ public:
     ConnectionStatus Connected() const noexcept final { return connected_; }
     Handshake HandshakeComplete() const noexcept final { return handshake_; }
     std::shared_future<void> Shutdown() noexcept final;
+    void Submit(zmq::Message& work) noexcept final { pipeline_->Push(work); }
 
     ~Peer() override;
 
@@ -109,6 +110,12 @@ protected:
     void check_handshake() noexcept;
     void disconnect() noexcept;
     auto local_endpoint() noexcept -> tcp::socket::endpoint_type;
+    // Penalize the peer and ban its address for a while after disconnecting
+    void misbehaving() noexcept;
+    void received(
+        const Task type,
+        const block::Hash& block,
+        const std::size_t bytes) const noexcept;
     // NOTE call init in every final child class constructor
     void init() noexcept;
     virtual void ping() noexcept = 0;
@@ -119,6 +126,7 @@ protected:
     bool state_machine() noexcept;
     void update_address_services(
         const std::set<p2p::Service>& services) noexcept;
+    void update_rtt(const std::chrono::milliseconds rtt) noexcept;
 
     Peer(
         const api::internal::Core& api,
@@ -152,6 +160,21 @@ private:
         Time activity_;
     };
 
+    struct Session {
+        void Bytes(const std::size_t bytes) noexcept;
+        void Failure() noexcept;
+        void Handshake() noexcept;
+        void Misbehavior() noexcept;
+        client::internal::PeerScore Reset() noexcept;
+        void RTT(const std::chrono::milliseconds rtt) noexcept;
+
+        Session() noexcept;
+
+    private:
+        mutable std::mutex lock_;
+        client::internal::PeerScore score_;
+    };
+
     struct SendPromises {
         void Break();
         std::pair<std::future<bool>, int> NewPromise();
@@ -179,6 +202,7 @@ private:
     Handshake handshake_;
     SendPromises send_promises_;
     Activity activity_;
+    Session session_;
     mutable std::atomic<State> state_;
     OTZMQListenCallback cb_;
     OTZMQDealerSocket dealer_;
@@ -148,6 +148,7 @@ Peer::Peer(
     , local_services_(get_local_services(protocol_, chain_, localServices))
     , relay_(relay)
     , get_headers_()
+    , ping_sent_()
 {
     init();
 }
@@ -208,6 +209,7 @@ auto Peer::ping() noexcept -> void
     }
 
     const auto& ping = *pPing;
+    ping_sent_ = Clock::now();
     send(ping.Encode());
 }
 
@@ -350,6 +352,7 @@ auto Peer::process_cfheaders(
 
     const auto& message = *pMessage;
     const auto type = message.Type();
+    received(Task::Getcfheaders, message.Stop(), payload.size());
     using Task = client::internal::Network::Task;
     auto work = network_.Work(Task::SubmitFilterHeader);
     work->AddFrame(type);
@@ -382,6 +385,7 @@ auto Peer::process_cfilter(
 
     const auto& message = *pMessage;
     const auto type = message.Type();
+    received(Task::Getcfilters, message.Hash(), payload.size());
     using Task = client::internal::Network::Task;
     auto work = network_.Work(Task::SubmitFilter);
     work->AddFrame(type);
@@ -817,6 +821,7 @@ auto Peer::process_message(const zmq::Message& message) noexcept -> void
     if (header.Network() != chain_) {
         LogOutput(OT_METHOD)(__FUNCTION__)(": Wrong network on message")
             .Flush();
+        misbehaving();
         disconnect();
 
         return;
@@ -828,6 +833,7 @@ auto Peer::process_message(const zmq::Message& message) noexcept -> void
         LogNormal("Invalid checksum on ")(blockchain::internal::DisplayString(
             chain_))(" ")(CommandName(command))(" message")
             .Flush();
+        misbehaving();
         disconnect();
 
         return;
@@ -921,7 +927,11 @@ auto Peer::process_pong(
 
     const auto& message = *pMessage;
 
-    if (message.Nonce() == nonce_) { disconnect(); }
+    if ((message.Nonce() == nonce_) && (Time{} != ping_sent_)) {
+        update_rtt(std::chrono::duration_cast<std::chrono::milliseconds>(
+            Clock::now() - ping_sent_));
+        ping_sent_ = {};
+    }
 }
 
 auto Peer::process_reject(
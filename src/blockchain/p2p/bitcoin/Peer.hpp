@@ -66,6 +66,7 @@ private:
     const std::set<p2p::Service> local_services_;
     std::atomic<bool> relay_;
     Request get_headers_;
+    Time ping_sent_;
 
     static std::set<p2p::Service> get_local_services(
         const ProtocolVersion version,
@@ -17,6 +17,7 @@
 #include <memory>
 #include <vector>
 
+#include "BlockView.hpp"
 #include "Transaction.hpp"
 
 #include "Block.hpp"
@@ -42,7 +43,8 @@ Block::Block(
     const Time timestamp,
     const std::uint32_t difficulty_target,
     const std::uint32_t nonce,
-    const std::vector<std::shared_ptr<Transaction>>& transactions) noexcept
+    const std::vector<std::shared_ptr<Transaction>>& transactions,
+    const bool complete) noexcept
     : api_(api)
     , network_(network)
     , block_version_(block_version)
@@ -52,11 +54,20 @@ Block::Block(
     , difficulty_target_(difficulty_target)
     , nonce_(nonce)
     , transactions_(transactions)
+    , complete_(complete)
 {
 }
 
 OTData Block::Encode() const noexcept
 {
+    if (false == complete_) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(
+            ": Block does not contain every transaction")
+            .Flush();
+
+        return Data::Factory();
+    }
+
     try {
         VersionField versionField(static_cast<std::int32_t>(block_version_));
         auto output = Data::Factory(&versionField, sizeof(versionField));
@@ -109,6 +120,16 @@ bitcoin::Block* bitcoin::Block::Factory(
     const blockchain::Type network,
     const void* payload,
     const std::size_t size)
+{
+    return Factory(api, network, payload, size, BlockView::Relevant{});
+}
+
+bitcoin::Block* bitcoin::Block::Factory(
+    const api::internal::Core& api,
+    const blockchain::Type network,
+    const void* payload,
+    const std::size_t size,
+    const BlockView::Relevant& relevant)
 {
     using ReturnType = bitcoin::Block;
     auto* it{static_cast<const std::byte*>(payload)};
@@ -132,7 +153,8 @@ bitcoin::Block* bitcoin::Block::Factory(
         timestamp,
         difficulty_target,
         nonce,
-        transactions);
+        transactions,
+        relevant);
 
     if (false == decoded) { return nullptr; }
 
@@ -146,7 +168,8 @@ bitcoin::Block* bitcoin::Block::Factory(
             timestamp,
             difficulty_target,
             nonce,
-            transactions);
+            transactions,
+            false == bool(relevant));
     } catch (...) {
         opentxs::LogOutput(OT_METHOD)(__FUNCTION__)(": Checksum failure")
             .Flush();
@@ -167,11 +190,9 @@ bool bitcoin::Block::DecodeFromPayload(
     Time& timestamp,
     std::uint32_t& difficulty_target,
     std::uint32_t& nonce,
-    std::vector<std::shared_ptr<Transaction>>& transactions) noexcept
+    std::vector<std::shared_ptr<Transaction>>& transactions,
+    const BlockView::Relevant& relevant) noexcept
 {
-    bitcoin::VersionField versionField{};
-    expectedSize += sizeof(versionField);
-
     if (expectedSize > size) {
         opentxs::LogOutput(OT_METHOD)(__FUNCTION__)(": Size below minimum.")
             .Flush();
@@ -179,138 +200,39 @@ bool bitcoin::Block::DecodeFromPayload(
         return false;
     }
 
-    OTPassword::safe_memcpy(
-        &versionField, sizeof(versionField), it, sizeof(versionField));
-    it += sizeof(versionField);
-    block_version = versionField.value();
-    HashField raw_previous_block_hash{};
-    expectedSize += sizeof(raw_previous_block_hash);
-
-    if (expectedSize > size) {
-        opentxs::LogOutput(OT_METHOD)(__FUNCTION__)(": Size below minimum.")
-            .Flush();
-
-        return false;
-    }
+    const auto bytes = ReadView{reinterpret_cast<const char*>(it),
+                                size - expectedSize};
+    auto view = BlockView{};
 
-    OTPassword::safe_memcpy(
-        &raw_previous_block_hash,
-        sizeof(raw_previous_block_hash),
-        it,
-        sizeof(raw_previous_block_hash));
-    it += sizeof(raw_previous_block_hash);
-    previous_block_hash.Assign(
-        &raw_previous_block_hash, sizeof(raw_previous_block_hash));
-    HashField raw_merkle_root_hash{};
-    expectedSize += sizeof(raw_merkle_root_hash);
+    if (false == view.Parse(bytes)) { return false; }
 
-    if (expectedSize > size) {
-        opentxs::LogOutput(OT_METHOD)(__FUNCTION__)(": Size below minimum.")
+    if (false == view.VerifyMerkleRoot()) {
+        opentxs::LogOutput(OT_METHOD)(__FUNCTION__)(": Merkle root mismatch")
             .Flush();
 
         return false;
     }
 
-    OTPassword::safe_memcpy(
-        &raw_merkle_root_hash,
-        sizeof(raw_merkle_root_hash),
-        it,
-        sizeof(raw_merkle_root_hash));
-    it += sizeof(raw_merkle_root_hash);
-    merkle_root_hash.Assign(&merkle_root_hash, sizeof(merkle_root_hash));
-    TimestampField32 raw_timestamp{};
-    expectedSize += sizeof(raw_timestamp);
-
-    if (expectedSize > size) {
-        opentxs::LogOutput(OT_METHOD)(__FUNCTION__)(": Size below minimum.")
-            .Flush();
-
-        return false;
+    block_version = view.Version();
+    const auto previous = view.PreviousBlockHash();
+    previous_block_hash.Assign(previous.data(), previous.size());
+    const auto merkle = view.MerkleRoot();
+    merkle_root_hash.Assign(merkle.data(), merkle.size());
+    timestamp = view.Timestamp();
+    difficulty_target = view.nBits();
+    nonce = view.Nonce();
+    const auto& parsed = view.Transactions();
+
+    if (false == bool(relevant)) {
+        transactions.reserve(transactions.size() + parsed.size());
     }
 
-    OTPassword::safe_memcpy(
-        &raw_timestamp, sizeof(raw_timestamp), it, sizeof(raw_timestamp));
-    it += sizeof(raw_timestamp);
-    timestamp = Clock::from_time_t(raw_timestamp.value());
-    DifficultyTargetField raw_difficulty_target{};
-    expectedSize += sizeof(raw_difficulty_target);
+    for (const auto& tx : parsed) {
+        if (relevant && (false == relevant(view, tx))) { continue; }
 
-    if (expectedSize > size) {
-        opentxs::LogOutput(OT_METHOD)(__FUNCTION__)(": Size below minimum.")
-            .Flush();
-
-        return false;
-    }
-
-    OTPassword::safe_memcpy(
-        &raw_difficulty_target,
-        sizeof(raw_difficulty_target),
-        it,
-        sizeof(raw_difficulty_target));
-    it += sizeof(raw_difficulty_target);
-    difficulty_target = raw_difficulty_target.value();
-    NonceField raw_nonce{};
-    expectedSize += sizeof(raw_nonce);
-
-    if (expectedSize > size) {
-        opentxs::LogOutput(OT_METHOD)(__FUNCTION__)(": Size below minimum.")
-            .Flush();
-
-        return false;
-    }
-
-    OTPassword::safe_memcpy(
-        &raw_nonce, sizeof(raw_nonce), it, sizeof(raw_nonce));
-    it += sizeof(raw_nonce);
-    nonce = raw_nonce.value();
-    expectedSize += sizeof(std::byte);
+        auto pTx = view.Materialize(api, network, tx);
 
-    if (expectedSize > size) {
-        opentxs::LogOutput(OT_METHOD)(__FUNCTION__)(
-            ": Size below minimum for Tx count field")
-            .Flush();
-
-        return false;
-    }
-
-    auto txCount = std::size_t{0};
-    const bool decodedTxCount =
-        blockchain::bitcoin::DecodeCompactSizeFromPayload(
-            it, expectedSize, size, txCount);
-
-    if (!decodedTxCount) {
-        opentxs::LogOutput(OT_METHOD)(__FUNCTION__)(
-            ": CompactSize incomplete for Tx count field")
-            .Flush();
-
-        return false;
-    }
-
-    // -----------------------------------------------
-    // Read all the transactions.
-    // Note: All the expectedSize checks are done inside
-    // DecodeFromPayload. That's why I'm not checking that
-    // here for each of these.
-    //
-    for (std::size_t ii = 0; ii < txCount; ii++) {
-        bitcoin::TxDataFormatVersion data_format_version{};
-        bool witness_flag_present{false};
-        bitcoin::Inputs inputs;
-        bitcoin::Outputs outputs;
-        bitcoin::Witnesses witnesses;
-        bitcoin::TxLockTime lock_time{};
-
-        const bool decoded = Transaction::DecodeFromPayload(
-            it,
-            expectedSize,
-            size,
-            data_format_version,
-            witness_flag_present,
-            inputs,
-            outputs,
-            witnesses,
-            lock_time);
-        if (!decoded) {
+        if (false == bool(pTx)) {
             opentxs::LogOutput(OT_METHOD)(__FUNCTION__)(
                 ": Failed trying to parse a Tx")
                 .Flush();
@@ -318,19 +240,12 @@ bool bitcoin::Block::DecodeFromPayload(
             return false;
         }
 
-        std::shared_ptr<bitcoin::Transaction> pTx(bitcoin::Transaction::Factory(
-            api,
-            network,
-            data_format_version,
-            witness_flag_present,
-            inputs,
-            outputs,
-            witnesses,
-            lock_time));
-
-        transactions.push_back(pTx);
+        transactions.emplace_back(std::move(pTx));
     }
 
+    it += bytes.size();
+    expectedSize += bytes.size();
+
     return true;
 }
 
@@ -28,6 +28,8 @@ public:
         return transactions_;
     }
 
+    /// Returns an empty Data for a block constructed from a subset of its
+    /// transactions
     OTData Encode() const noexcept;
 
     static Block* Factory(
@@ -35,6 +37,15 @@ public:
         const opentxs::blockchain::Type network,
         const void* payload,
         const std::size_t size);
+    /// Materializes only the transactions selected by relevant
+    ///
+    /// The whole block is still validated against its merkle root.
+    static Block* Factory(
+        const opentxs::api::internal::Core& api,
+        const opentxs::blockchain::Type network,
+        const void* payload,
+        const std::size_t size,
+        const BlockView::Relevant& relevant);
 
     static Block* Factory(
         const opentxs::api::internal::Core& api,
@@ -59,7 +70,8 @@ public:
         Time& timestamp,
         std::uint32_t& difficulty_target,
         std::uint32_t& nonce,
-        std::vector<std::shared_ptr<Transaction>>& transactions) noexcept;
+        std::vector<std::shared_ptr<Transaction>>& transactions,
+        const BlockView::Relevant& relevant = {}) noexcept;
 
 protected:
     const api::internal::Core& api_;
@@ -73,6 +85,7 @@ private:
     const std::uint32_t difficulty_target_;
     const std::uint32_t nonce_;
     const std::vector<std::shared_ptr<bitcoin::Transaction>> transactions_;
+    const bool complete_;
 
     Block(
         const api::internal::Core& api,
@@ -83,7 +96,8 @@ private:
         const Time timestamp,
         const std::uint32_t difficulty_target,
         const std::uint32_t nonce,
-        const std::vector<std::shared_ptr<Transaction>>& transactions) noexcept;
+        const std::vector<std::shared_ptr<Transaction>>& transactions,
+        const bool complete = true) noexcept;
     Block() = delete;
     Block(const Block&) = delete;
     Block(Block&&) = delete;
@@ -0,0 +1,434 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "stdafx.hpp"
+
+#include "Internal.hpp"
+
+#include "opentxs/core/Log.hpp"
+
+#include <boost/endian/buffers.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Transaction.hpp"
+
+#include "BlockView.hpp"
+
+#define OT_METHOD "opentxs::blockchain::transaction::bitcoin::BlockView::"
+
+namespace be = boost::endian;
+
+namespace
+{
+// Bounds checked cursor over a serialized block. Throws on truncation.
+class Reader
+{
+public:
+    auto Consumed() const noexcept -> std::size_t
+    {
+        return static_cast<std::size_t>(it_ - begin_);
+    }
+    auto Position() const noexcept -> const char* { return it_; }
+    auto Remaining() const noexcept -> std::size_t
+    {
+        return static_cast<std::size_t>(end_ - it_);
+    }
+    auto Since(const char* start) const noexcept -> opentxs::ReadView
+    {
+        return opentxs::ReadView{start, static_cast<std::size_t>(it_ - start)};
+    }
+
+    auto CompactSize() noexcept(false) -> std::uint64_t
+    {
+        const auto first = static_cast<std::uint8_t>(*Skip(1).data());
+
+        switch (first) {
+            case 0xfd: {
+                return Read<be::little_uint16_buf_t>();
+            }
+            case 0xfe: {
+                return Read<be::little_uint32_buf_t>();
+            }
+            case 0xff: {
+                return Read<be::little_uint64_buf_t>();
+            }
+            default: {
+                return first;
+            }
+        }
+    }
+    // Reject counts which can not possibly fit in the remaining bytes
+    auto Count(const std::size_t minimumSize) noexcept(false) -> std::size_t
+    {
+        const auto count = CompactSize();
+
+        if ((Remaining() / minimumSize) < count) {
+            throw std::out_of_range("Count exceeds remaining bytes");
+        }
+
+        return static_cast<std::size_t>(count);
+    }
+    auto Script() noexcept(false) -> opentxs::ReadView
+    {
+        return Skip(static_cast<std::size_t>(Count(1)));
+    }
+    template <typename Field>
+    auto Read() noexcept(false)
+    {
+        auto field = Field{};
+        const auto bytes = Skip(sizeof(field));
+        std::memcpy(static_cast<void*>(&field), bytes.data(), bytes.size());
+
+        return field.value();
+    }
+    auto Skip(const std::size_t bytes) noexcept(false) -> opentxs::ReadView
+    {
+        if (Remaining() < bytes) { throw std::out_of_range("Truncated"); }
+
+        const auto output = opentxs::ReadView{it_, bytes};
+        it_ += bytes;
+
+        return output;
+    }
+
+    Reader(const opentxs::ReadView bytes) noexcept
+        : begin_(bytes.data())
+        , it_(begin_)
+        , end_(begin_ + bytes.size())
+    {
+    }
+
+private:
+    const char* begin_;
+    const char* it_;
+    const char* end_;
+};
+
+// Transactions per thread when computing txids for a large block
+constexpr std::size_t parallel_transactions_{256};
+// Smallest possible serializations, used to bound counts before reserving
+constexpr std::size_t minimum_input_{32 + 4 + 1 + 4};
+constexpr std::size_t minimum_output_{8 + 1};
+constexpr std::size_t minimum_transaction_{4 + 1 + 1 + 4};
+}  // namespace
+
+namespace opentxs::blockchain::transaction::bitcoin
+{
+const std::size_t BlockView::header_bytes_{80};
+
+BlockView::BlockView() noexcept
+    : header_()
+    , transactions_()
+    , inputs_()
+    , outputs_()
+    , witnesses_()
+{
+}
+
+auto BlockView::clear() noexcept -> void
+{
+    header_ = {};
+    transactions_.clear();
+    inputs_.clear();
+    outputs_.clear();
+    witnesses_.clear();
+}
+
+auto BlockView::Match(const std::vector<OTData>& elements) noexcept
+    -> Relevant
+{
+    auto targets = std::vector<std::string>{};
+    targets.reserve(elements.size());
+
+    for (const auto& element : elements) {
+        targets.emplace_back(
+            static_cast<const char*>(element->data()), element->size());
+    }
+
+    std::sort(targets.begin(), targets.end());
+    targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+
+    return [targets = std::move(targets)](
+               const BlockView& view, const Tx& tx) -> bool {
+        const auto found = [&](const ReadView item) {
+            return std::binary_search(
+                targets.begin(), targets.end(), item, std::less<>{});
+        };
+        const auto& inputs = view.Inputs();
+        const auto& outputs = view.Outputs();
+
+        for (auto i{tx.first_input_}; i < tx.first_input_ + tx.input_count_;
+             ++i) {
+            if (found(inputs[i].outpoint_)) { return true; }
+        }
+
+        for (auto i{tx.first_output_};
+             i < tx.first_output_ + tx.output_count_;
+             ++i) {
+            if (found(outputs[i].script_)) { return true; }
+        }
+
+        return false;
+    };
+}
+
+auto BlockView::Materialize(
+    const api::internal::Core& api,
+    const blockchain::Type network,
+    const Tx& tx) const noexcept -> std::shared_ptr<Transaction>
+{
+    const auto data = [](const ReadView bytes) {
+        return Data::Factory(bytes.data(), bytes.size());
+    };
+
+    try {
+        auto inputs = Inputs{};
+        auto outputs = Outputs{};
+        auto witnesses = Witnesses{};
+        inputs.reserve(tx.input_count_);
+        outputs.reserve(tx.output_count_);
+
+        for (auto i{tx.first_input_}; i < tx.first_input_ + tx.input_count_;
+             ++i) {
+            const auto& input = inputs_.at(i);
+            auto index = be::little_uint32_buf_t{};
+            std::memcpy(
+                static_cast<void*>(&index),
+                input.outpoint_.data() + 32,
+                sizeof(index));
+            inputs.emplace_back(
+                Outpoint{data(input.outpoint_.substr(0, 32)), index.value()},
+                data(input.script_),
+                input.sequence_);
+
+            if (tx.segwit_) {
+                auto components = std::vector<OTData>{};
+                components.reserve(input.witness_count_);
+
+                for (auto j{input.first_witness_};
+                     j < input.first_witness_ + input.witness_count_;
+                     ++j) {
+                    components.emplace_back(data(witnesses_.at(j)));
+                }
+
+                witnesses.emplace_back(components);
+            }
+        }
+
+        for (auto i{tx.first_output_};
+             i < tx.first_output_ + tx.output_count_;
+             ++i) {
+            const auto& output = outputs_.at(i);
+            outputs.emplace_back(output.value_, data(output.script_));
+        }
+
+        return std::shared_ptr<Transaction>{Transaction::Factory(
+            api,
+            network,
+            tx.version_,
+            tx.segwit_,
+            inputs,
+            outputs,
+            witnesses,
+            tx.lock_time_)};
+    } catch (const std::exception& e) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
+
+        return {};
+    }
+}
+
+auto BlockView::Materialize(
+    const api::internal::Core& api,
+    const blockchain::Type network,
+    const Relevant& relevant) const noexcept
+    -> std::vector<std::shared_ptr<Transaction>>
+{
+    auto output = std::vector<std::shared_ptr<Transaction>>{};
+
+    for (const auto& tx : transactions_) {
+        if (relevant(*this, tx)) {
+            auto pTx = Materialize(api, network, tx);
+
+            if (pTx) { output.emplace_back(std::move(pTx)); }
+        }
+    }
+
+    return output;
+}
+
+auto BlockView::MerkleRoot() const noexcept -> ReadView
+{
+    return header_.empty() ? ReadView{} : header_.substr(36, 32);
+}
+
+auto BlockView::nBits() const noexcept -> std::uint32_t
+{
+    if (header_.empty()) { return {}; }
+
+    auto field = be::little_uint32_buf_t{};
+    std::memcpy(static_cast<void*>(&field), header_.data() + 72, 4);
+
+    return field.value();
+}
+
+auto BlockView::Nonce() const noexcept -> std::uint32_t
+{
+    if (header_.empty()) { return {}; }
+
+    auto field = be::little_uint32_buf_t{};
+    std::memcpy(static_cast<void*>(&field), header_.data() + 76, 4);
+
+    return field.value();
+}
+
+auto BlockView::Parse(const ReadView block) noexcept -> bool
+{
+    clear();
+    auto reader = Reader{block};
+
+    try {
+        header_ = reader.Skip(header_bytes_);
+        const auto txCount = reader.Count(minimum_transaction_);
+        transactions_.reserve(txCount);
+
+        for (std::size_t i{0}; i < txCount; ++i) {
+            auto& tx = transactions_.emplace_back();
+            const auto* start = reader.Position();
+            tx.version_field_ = reader.Skip(4);
+            auto version = be::little_int32_buf_t{};
+            std::memcpy(static_cast<void*>(&version), start, 4);
+            tx.version_ = version.value();
+            const auto* marker = reader.Position();
+            tx.segwit_ = (2 <= reader.Remaining()) && (0x0 == marker[0]) &&
+                         (0x1 == marker[1]);
+
+            if (tx.segwit_) { reader.Skip(2); }
+
+            const auto* body = reader.Position();
+            tx.first_input_ = inputs_.size();
+            tx.input_count_ = reader.Count(minimum_input_);
+
+            for (std::size_t j{0}; j < tx.input_count_; ++j) {
+                auto& input = inputs_.emplace_back();
+                input.outpoint_ = reader.Skip(36);
+                input.script_ = reader.Script();
+                input.sequence_ = reader.Read<be::little_uint32_buf_t>();
+            }
+
+            tx.first_output_ = outputs_.size();
+            tx.output_count_ = reader.Count(minimum_output_);
+
+            for (std::size_t j{0}; j < tx.output_count_; ++j) {
+                auto& output = outputs_.emplace_back();
+                output.value_ = reader.Read<be::little_int64_buf_t>();
+                output.script_ = reader.Script();
+            }
+
+            tx.body_ = reader.Since(body);
+
+            if (tx.segwit_) {
+                for (std::size_t j{0}; j < tx.input_count_; ++j) {
+                    auto& input = inputs_.at(tx.first_input_ + j);
+                    input.first_witness_ = witnesses_.size();
+                    input.witness_count_ = reader.Count(1);
+
+                    for (std::size_t k{0}; k < input.witness_count_; ++k) {
+                        witnesses_.emplace_back(reader.Script());
+                    }
+                }
+            }
+
+            const auto* lockTime = reader.Position();
+            tx.lock_time_ = reader.Read<be::little_uint32_buf_t>();
+            tx.lock_time_field_ = ReadView{lockTime, 4};
+            tx.raw_ = reader.Since(start);
+        }
+
+        if (0 != reader.Remaining()) {
+            throw std::out_of_range("Unexpected trailing bytes");
+        }
+
+        return true;
+    } catch (const std::exception& e) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid block at byte ")(
+            reader.Consumed())(": ")(e.what())
+            .Flush();
+        clear();
+
+        return false;
+    }
+}
+
+auto BlockView::PreviousBlockHash() const noexcept -> ReadView
+{
+    return header_.empty() ? ReadView{} : header_.substr(4, 32);
+}
+
+auto BlockView::Timestamp() const noexcept -> Time
+{
+    if (header_.empty()) { return {}; }
+
+    auto field = be::little_uint32_buf_t{};
+    std::memcpy(static_cast<void*>(&field), header_.data() + 68, 4);
+
+    return Clock::from_time_t(field.value());
+}
+
+auto BlockView::Txid(const Tx& tx) const noexcept -> Digest
+{
+    return blockchain::internal::DoubleSha256(
+        {tx.version_field_, tx.body_, tx.lock_time_field_});
+}
+
+auto BlockView::VerifyMerkleRoot() const noexcept -> bool
+{
+    if (transactions_.empty()) { return false; }
+
+    auto txids = std::vector<Digest>(transactions_.size());
+    blockchain::internal::Parallel(
+        transactions_.size(),
+        parallel_transactions_,
+        [&](const auto begin, const auto end) {
+            for (auto i = begin; i < end; ++i) {
+                txids[i] = Txid(transactions_[i]);
+            }
+        });
+    const auto root = blockchain::internal::MerkleRoot(std::move(txids));
+
+    if (false == root.has_value()) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Malleated merkle tree").Flush();
+
+        return false;
+    }
+
+    const auto& computed = root.value();
+    const auto expected = MerkleRoot();
+
+    if (expected.size() != computed.size()) { return false; }
+
+    return 0 == std::memcmp(expected.data(), computed.data(), expected.size());
+}
+
+auto BlockView::Version() const noexcept -> block::Version
+{
+    if (header_.empty()) { return {}; }
+
+    auto field = be::little_int32_buf_t{};
+    std::memcpy(static_cast<void*>(&field), header_.data(), 4);
+
+    return field.value();
+}
+
+auto BlockView::Wtxid(const Tx& tx) const noexcept -> Digest
+{
+    return blockchain::internal::DoubleSha256({tx.raw_});
+}
+}  // namespace opentxs::blockchain::transaction::bitcoin
@@ -0,0 +1,134 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Internal.hpp"
+
+#include "opentxs/Bytes.hpp"
+#include "opentxs/core/Data.hpp"
+
+#include "internal/blockchain/Blockchain.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace opentxs::blockchain::transaction::bitcoin
+{
+class Transaction;
+
+/** Non-owning, single pass parse of a serialized block
+ *
+ *  Every ReadView returned by this class points into the buffer passed to
+ *  Parse, which must outlive any use of the view. The index vectors are
+ *  reused between calls so a long lived BlockView parses successive blocks
+ *  without allocating once its capacity has grown to fit them.
+ */
+class BlockView
+{
+public:
+    struct TxIn {
+        /// Previous transaction hash followed by the output index
+        ReadView outpoint_{};
+        ReadView script_{};
+        std::uint32_t sequence_{};
+        std::size_t first_witness_{};
+        std::size_t witness_count_{};
+    };
+
+    struct TxOut {
+        std::int64_t value_{};
+        ReadView script_{};
+    };
+
+    struct Tx {
+        /// Complete serialization including witness data, if any
+        ReadView raw_{};
+        /// Concatenating these three fields yields the txid preimage
+        ReadView version_field_{};
+        ReadView body_{};
+        ReadView lock_time_field_{};
+        std::int32_t version_{};
+        bool segwit_{};
+        std::uint32_t lock_time_{};
+        std::size_t first_input_{};
+        std::size_t input_count_{};
+        std::size_t first_output_{};
+        std::size_t output_count_{};
+    };
+
+    using Digest = blockchain::internal::Sha256Digest;
+    using Relevant = std::function<bool(const BlockView&, const Tx&)>;
+
+    OPENTXS_EXPORT static const std::size_t header_bytes_;
+
+    /// Selects transactions which create an output script or spend an
+    /// outpoint contained in elements
+    ///
+    /// Pass the same elements given to FilterOracle::Match so that a block
+    /// whose filter matched materializes only the transactions responsible.
+    OPENTXS_EXPORT static Relevant Match(
+        const std::vector<OTData>& elements) noexcept;
+
+    ReadView Header() const noexcept { return header_; }
+    const std::vector<TxIn>& Inputs() const noexcept { return inputs_; }
+    OPENTXS_EXPORT ReadView MerkleRoot() const noexcept;
+    OPENTXS_EXPORT std::uint32_t nBits() const noexcept;
+    OPENTXS_EXPORT std::uint32_t Nonce() const noexcept;
+    const std::vector<TxOut>& Outputs() const noexcept { return outputs_; }
+    OPENTXS_EXPORT ReadView PreviousBlockHash() const noexcept;
+    OPENTXS_EXPORT Time Timestamp() const noexcept;
+    const std::vector<Tx>& Transactions() const noexcept
+    {
+        return transactions_;
+    }
+    /// Hash of the serialization without witness data
+    OPENTXS_EXPORT Digest Txid(const Tx& tx) const noexcept;
+    /// Returns false if the transactions do not match the header merkle root
+    OPENTXS_EXPORT bool VerifyMerkleRoot() const noexcept;
+    OPENTXS_EXPORT block::Version Version() const noexcept;
+    const std::vector<ReadView>& Witnesses() const noexcept
+    {
+        return witnesses_;
+    }
+    /// Hash of the complete serialization including witness data
+    OPENTXS_EXPORT Digest Wtxid(const Tx& tx) const noexcept;
+
+    /// Construct an owning transaction object for a single parsed transaction
+    ///
+    /// The object is assembled from the fields located by Parse, so the
+    /// transaction bytes are not decoded a second time.
+    OPENTXS_EXPORT std::shared_ptr<Transaction> Materialize(
+        const api::internal::Core& api,
+        const blockchain::Type network,
+        const Tx& tx) const noexcept;
+    /// Construct owning objects only for transactions matching the predicate
+    OPENTXS_EXPORT std::vector<std::shared_ptr<Transaction>> Materialize(
+        const api::internal::Core& api,
+        const blockchain::Type network,
+        const Relevant& relevant) const noexcept;
+    /// Returns false and leaves the view empty if the block is malformed
+    OPENTXS_EXPORT bool Parse(const ReadView block) noexcept;
+
+    OPENTXS_EXPORT BlockView() noexcept;
+
+private:
+    ReadView header_;
+    std::vector<Tx> transactions_;
+    std::vector<TxIn> inputs_;
+    std::vector<TxOut> outputs_;
+    std::vector<ReadView> witnesses_;
+
+    void clear() noexcept;
+
+    BlockView(const BlockView&) = delete;
+    BlockView(BlockView&&) = delete;
+    BlockView& operator=(const BlockView&) = delete;
+    BlockView& operator=(BlockView&&) = delete;
+};
+}  // namespace opentxs::blockchain::transaction::bitcoin
@@ -68,11 +68,8 @@ OTData Transaction::Encode() const noexcept
 
         for (const auto& current : outputs_) { output += current.Encode(); }
         // ------------------------------------------------
+        // One witness per input with no count prefix, as in BIP144
         if (witness_flag_present_) {
-            const auto witnessCount =
-                blockchain::bitcoin::CompactSize(witnesses_.size()).Encode();
-            output->Concatenate(witnessCount.data(), witnessCount.size());
-
             for (const auto& current : witnesses_) {
                 output += current.Encode();
             }
@@ -187,7 +184,9 @@ bool bitcoin::Transaction::DecodeFromPayload(
     bitcoin::WitnessFlagArray witness_flag_array{raw_witness_flag[0].value(),
                                                  raw_witness_flag[1].value()};
 
-    witness_flag_present = (witness_flag_array[1] & 1);
+    // A legacy transaction starts with a non-zero input count
+    witness_flag_present =
+        (0 == witness_flag_array[0]) && (witness_flag_array[1] & 1);
 
     if (witness_flag_present) {
         it += sizeof(raw_witness_flag);
@@ -47,7 +47,7 @@ public:
         return data_format_version_;
     }
 
-    OTData Encode() const noexcept;
+    OPENTXS_EXPORT OTData Encode() const noexcept;
 
     static Transaction* Factory(
         const opentxs::api::internal::Core& api,
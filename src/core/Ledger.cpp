@@ -33,6 +33,7 @@
 
 #include "internal/api/Api.hpp"
 
+#include <cstddef>
 #include <cstdlib>
 #include <sys/types.h>
 #include <cstdint>
@@ -160,7 +161,43 @@ bool Ledger::VerifyAccount(const identity::Nym& theNym)
             return false;
     }
 
-    return OTTransactionType::VerifyAccount(theNym);
+    const auto* cache = api_.Boxes();
+
+    if (nullptr == cache) { return OTTransactionType::VerifyAccount(theNym); }
+
+    // A notary verifies its own signature on the same boxes many times. The
+    // digest covers the signer, the signed contents and every signature, so
+    // a match means this exact combination has already been verified.
+    auto preimage = std::string{};
+    const auto append = [&preimage](const char* data, const std::size_t size) {
+        preimage.append(std::to_string(size));
+        preimage.push_back(':');
+        preimage.append(data, size);
+    };
+    const auto nymID = theNym.ID().str();
+    append(nymID.data(), nymID.size());
+    append(m_xmlUnsigned->Get(), m_xmlUnsigned->GetLength());
+
+    for (const auto& sig : m_listSignatures) {
+        append(sig->Get(), sig->GetLength());
+    }
+
+    auto digest = Identifier::Factory();
+
+    if (false == digest->CalculateDigest({preimage.data(), preimage.size()})) {
+
+        return OTTransactionType::VerifyAccount(theNym);
+    }
+
+    const auto key = digest->str();
+
+    if (cache->Verified(key)) { return VerifyContractID(); }
+
+    const auto verified = OTTransactionType::VerifyAccount(theNym);
+
+    if (verified) { cache->SetVerified(key); }
+
+    return verified;
 }
 
 // This makes sure that ALL transactions inside the ledger are saved as box
@@ -476,9 +513,15 @@ bool Ledger::LoadGeneric(ledgerType theType, const String& pString)
     }
 
     auto strRawFile = String::Factory();
+    const auto* cache = api_.Boxes();
+    const auto location = path1 + PathSeparator() + path2 + PathSeparator() +
+                          path3;
+    std::string strCached{};
 
     if (pString.Exists()) {  // Loading FROM A STRING.
         strRawFile->Set(pString.Get());
+    } else if ((nullptr != cache) && cache->Load(location, strCached)) {
+        strRawFile->Set(strCached.c_str());
     } else {  // Loading FROM A FILE.
         if (!OTDB::Exists(api_, api_.DataFolder(), path1, path2, path3, "")) {
             LogDebug(OT_METHOD)(__FUNCTION__)(
@@ -505,6 +548,8 @@ bool Ledger::LoadGeneric(ledgerType theType, const String& pString)
         }
 
         strRawFile->Set(strFileContents.c_str());
+
+        if (nullptr != cache) { cache->Store(location, strFileContents); }
     }
 
     // NOTE: No need to deal with OT ARMORED INBOX file format here, since
@@ -579,6 +624,19 @@ bool Ledger::SaveGeneric(ledgerType theType)
         path2,
         path3,
         "");  // <=== SAVING TO DATA STORE.
+    const auto* cache = api_.Boxes();
+
+    if (nullptr != cache) {
+        const auto location = path1 + PathSeparator() + path2 +
+                              PathSeparator() + path3;
+
+        if (bSaved) {
+            cache->Store(location, strFinal->Get());
+        } else {
+            cache->Erase(location);
+        }
+    }
+
     if (!bSaved) {
         LogOutput(OT_METHOD)(__FUNCTION__)(": Error writing ")(pszType)(
             " to file: ")(path1)(PathSeparator())(m_strFilename)
@@ -17,8 +17,25 @@
 
 #include "internal/api/Api.hpp"
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
 #include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <sstream>
+#include <string>
 #include <typeinfo>
 
 #define OT_METHOD "opentxs::Storage"
@@ -852,6 +869,34 @@ bool EraseValueByKey(
         api, dataFolder, strFolder, oneStr, twoStr, threeStr);
 }
 
+void Stage()
+{
+    Storage* pStorage = details::s_pStorage;
+
+    if (nullptr == pStorage) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(
+            ": No Default Storage object allocated.")
+            .Flush();
+        return;
+    }
+
+    pStorage->Stage();
+}
+
+bool Sync()
+{
+    Storage* pStorage = details::s_pStorage;
+
+    if (nullptr == pStorage) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(
+            ": No Default Storage object allocated.")
+            .Flush();
+        return false;
+    }
+
+    return pStorage->Sync();
+}
+
 // Used internally. Creates the right subclass for any stored object type,
 // based on which packer is needed.
 
@@ -2580,6 +2625,136 @@ bool Storage::EraseValueByKey(
 
 // STORAGE FS  (OTDB::StorageFS is the filesystem version of OTDB::Storage.)
 
+namespace
+{
+// Generation of the most recent write made by this thread
+thread_local std::uint64_t thread_written{0};
+// Set between Stage and the next Sync on the same thread
+thread_local bool thread_staged{false};
+
+std::string parent_directory(const std::string& path)
+{
+    const auto position = path.find_last_of("/\\");
+
+    if (std::string::npos == position) { return "."; }
+
+    if (0 == position) { return "/"; }
+
+    return path.substr(0, position);
+}
+
+#ifndef _WIN32
+bool sync_file(const int fd)
+{
+#if defined(__APPLE__)
+    return 0 == ::fcntl(fd, F_FULLFSYNC);
+#elif defined(__linux__)
+    return 0 == ::fdatasync(fd);
+#else
+    return 0 == ::fsync(fd);
+#endif
+}
+
+// Makes the contents of each file durable
+bool sync_files(const std::set<std::string>& files)
+{
+    bool bSuccess{true};
+
+    for (const auto& file : files) {
+        const auto fd = ::open(file.c_str(), O_RDONLY);
+
+        if ((-1 == fd) || (false == sync_file(fd))) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Error syncing ")(file)
+                .Flush();
+            bSuccess = false;
+        }
+
+        if (-1 != fd) { ::close(fd); }
+    }
+
+    return bSuccess;
+}
+
+// Makes the directory entries created, renamed or removed in each directory
+// durable
+bool sync_directories(const std::set<std::string>& directories)
+{
+    bool bSuccess{true};
+
+    for (const auto& directory : directories) {
+        const auto fd = ::open(directory.c_str(), O_RDONLY);
+
+        if (-1 == fd) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Error opening ")(directory)
+                .Flush();
+            bSuccess = false;
+
+            continue;
+        }
+
+        if (0 != ::fsync(fd)) { bSuccess = false; }
+
+        ::close(fd);
+    }
+
+    return bSuccess;
+}
+#endif
+
+bool write_file(
+    const std::string& path,
+    const std::function<bool(std::ofstream&)>& write)
+{
+    std::ofstream ofs(path.c_str(), std::ios::out | std::ios::binary);
+
+    if (ofs.fail()) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Error opening file: ")(path)(".")
+            .Flush();
+
+        return false;
+    }
+
+    ofs.clear();
+    bool bSuccess = write(ofs);
+    ofs.close();
+    bSuccess &= (false == ofs.fail());
+
+    if (false == bSuccess) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Error writing file: ")(path)(".")
+            .Flush();
+        std::remove(path.c_str());
+    }
+
+    return bSuccess;
+}
+}  // namespace
+
+// Writes waiting for the next barrier, and the generations of the newest
+// write and the newest write known to be on disk.
+//
+// A staged file is written under a temporary name and only renamed over its
+// target by the barrier, after its contents are on disk, so a crash leaves
+// either the previous or the new contents. Until then reads are redirected
+// to the temporary file. Writes from threads which do not stage are renamed
+// immediately and their contents are synced by the next barrier.
+struct StorageFS::SyncState {
+    std::mutex lock_{};
+    std::condition_variable synced_{};
+    // Target path to the temporary file holding its newest contents
+    std::map<std::string, std::string> staged_{};
+    // Staged files taken by the barrier which is running now
+    std::map<std::string, std::string> flushing_{};
+    // Files renamed into place whose contents have not been synced
+    std::set<std::string> written_files_{};
+    std::set<std::string> dirty_{};
+    std::uint64_t temp_{0};
+    std::uint64_t written_{0};
+    std::uint64_t durable_{0};
+    bool syncing_{false};
+    // Whether the missing durability on this platform has been reported
+    std::atomic<bool> warned_{false};
+};
+
 /*
  - Based on the input, constructs the full path and returns it in strOutput.
  - This function will try to create all the folders leading up to the
@@ -2741,8 +2916,15 @@ ot_exit_block:
 
     {
         auto lFileLength = std::size_t{0};
-        const bool bFileExists = api.Legacy().FileExists(
-            String::Factory(strPath.c_str()), lFileLength);
+        const auto source = current(strPath);
+        bool bFileExists = api.Legacy().FileExists(
+            String::Factory(source.c_str()), lFileLength);
+
+        // A barrier may have moved the staged file into place since
+        if (!bFileExists && (source != strPath)) {
+            bFileExists = api.Legacy().FileExists(
+                String::Factory(strPath.c_str()), lFileLength);
+        }
 
         if (bFileExists)
             return lFileLength;
@@ -2779,18 +2961,11 @@ bool StorageFS::onStorePackedBuffer(
     // here..
 
     // SAVE to the file here
-    std::ofstream ofs(strOutput.c_str(), std::ios::out | std::ios::binary);
-
-    if (ofs.fail()) {
-        LogOutput(OT_METHOD)(__FUNCTION__)(": Error opening file: ")(strOutput)(
-            ".")
-            .Flush();
-        return false;
-    }
-
-    ofs.clear();
-    bool bSuccess = theBuffer.WriteToOStream(ofs);
-    ofs.close();
+    const auto temp = temp_path(strOutput);
+    const auto written = write_file(temp, [&](std::ofstream& ofs) {
+        return theBuffer.WriteToOStream(ofs);
+    });
+    const bool bSuccess = written && commit(strOutput, temp);
 
     // TODO: Remove the .lock file.
 
@@ -2824,7 +2999,14 @@ bool StorageFS::onQueryPackedBuffer(
 
     // READ from the file here
 
-    std::ifstream fin(strOutput.c_str(), std::ios::in | std::ios::binary);
+    std::ifstream fin(
+        current(strOutput).c_str(), std::ios::in | std::ios::binary);
+
+    // A barrier may have moved the staged file into place since
+    if (!fin.is_open()) {
+        fin.clear();
+        fin.open(strOutput.c_str(), std::ios::in | std::ios::binary);
+    }
 
     if (!fin.is_open()) {
         LogOutput(OT_METHOD)(__FUNCTION__)(": Error opening file: ")(strOutput)(
@@ -2874,19 +3056,13 @@ bool StorageFS::onStorePlainString(
     // In a key/value database, szFilename is the "key" and strFinal.Get() is
     // the "value".
     //
-    std::ofstream ofs(strOutput.c_str(), std::ios::out | std::ios::binary);
+    const auto temp = temp_path(strOutput);
+    const auto written = write_file(temp, [&](std::ofstream& ofs) {
+        ofs << theBuffer;
 
-    if (ofs.fail()) {
-        LogOutput(OT_METHOD)(__FUNCTION__)(": Error opening file: ")(strOutput)(
-            ".")
-            .Flush();
-        return false;
-    }
-
-    ofs.clear();
-    ofs << theBuffer;
-    bool bSuccess = ofs.good();
-    ofs.close();
+        return ofs.good();
+    });
+    const bool bSuccess = written && commit(strOutput, temp);
 
     // TODO: Remove the .lock file.
 
@@ -2920,7 +3096,14 @@ bool StorageFS::onQueryPlainString(
 
     // Open the file here
 
-    std::ifstream fin(strOutput.c_str(), std::ios::in | std::ios::binary);
+    std::ifstream fin(
+        current(strOutput).c_str(), std::ios::in | std::ios::binary);
+
+    // A barrier may have moved the staged file into place since
+    if (!fin.is_open()) {
+        fin.clear();
+        fin.open(strOutput.c_str(), std::ios::in | std::ios::binary);
+    }
 
     if (!fin.is_open()) {
         LogOutput(OT_METHOD)(__FUNCTION__)(": Error opening file: ")(strOutput)(
@@ -2981,6 +3164,8 @@ bool StorageFS::onEraseValueByKey(
     // TODO: If not, next I should actually create a .lock file for myself right
     // here..
 
+    discard(strOutput);
+
     // SAVE to the file here. (a blank string.)
     //
     // Here's where the serialization code would be changed to CouchDB or
@@ -3018,6 +3203,8 @@ bool StorageFS::onEraseValueByKey(
             .Flush();
     }
 
+    mark_dirty(strOutput);
+
     // TODO: Remove the .lock file.
 
     return bSuccess;
@@ -3027,10 +3214,15 @@ bool StorageFS::onEraseValueByKey(
 //
 StorageFS::StorageFS()
     : Storage()
+    , sync_(std::make_unique<SyncState>())
 {
 }
 
-StorageFS::~StorageFS() {}
+StorageFS::~StorageFS()
+{
+    // Nothing staged may be left behind under a temporary name
+    flush(std::numeric_limits<std::uint64_t>::max());
+}
 
 // See if the file is there.
 
@@ -3050,6 +3242,206 @@ bool StorageFS::Exists(
             api, strOutput, dataFolder, strFolder, oneStr, twoStr, threeStr));
 }
 
+bool StorageFS::commit(const std::string& path, const std::string& temp)
+{
+    auto& sync = *sync_;
+    std::unique_lock<std::mutex> lock(sync.lock_);
+#ifndef _WIN32
+    if (thread_staged) {
+        auto& staged = sync.staged_[path];
+
+        // A newer write supersedes one no barrier has taken yet
+        if (false == staged.empty()) { std::remove(staged.c_str()); }
+
+        staged = temp;
+    } else {
+        // An older staged copy must not be renamed over this write
+        sync.synced_.wait(
+            lock, [&] { return 0 == sync.flushing_.count(path); });
+        auto staged = sync.staged_.find(path);
+
+        if (sync.staged_.end() != staged) {
+            std::remove(staged->second.c_str());
+            sync.staged_.erase(staged);
+        }
+
+        if (0 != std::rename(temp.c_str(), path.c_str())) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Error replacing file: ")(
+                path)(".")
+                .Flush();
+            std::remove(temp.c_str());
+
+            return false;
+        }
+
+        sync.written_files_.emplace(path);
+    }
+#endif
+
+    sync.dirty_.emplace(parent_directory(path));
+    thread_written = ++sync.written_;
+
+    return true;
+}
+
+std::string StorageFS::current(const std::string& path) const
+{
+    auto& sync = *sync_;
+    std::lock_guard<std::mutex> lock(sync.lock_);
+
+    for (const auto* map : {&sync.staged_, &sync.flushing_}) {
+        const auto it = map->find(path);
+
+        if (map->end() != it) { return it->second; }
+    }
+
+    return path;
+}
+
+void StorageFS::discard(const std::string& path)
+{
+    auto& sync = *sync_;
+    std::unique_lock<std::mutex> lock(sync.lock_);
+    // A running barrier would otherwise rename the file back into place
+    sync.synced_.wait(lock, [&] { return 0 == sync.flushing_.count(path); });
+    auto staged = sync.staged_.find(path);
+
+    if (sync.staged_.end() != staged) {
+        std::remove(staged->second.c_str());
+        sync.staged_.erase(staged);
+    }
+
+    sync.written_files_.erase(path);
+}
+
+// Group commit. The first thread to arrive makes every write so far durable,
+// including those from other threads, while later arrivals wait for it. It
+// syncs each file once however often it was written since the previous
+// barrier, moves the staged files into place and then syncs the directories
+// they are in. A thread whose writes are covered by a completed barrier
+// returns without touching the disk.
+//
+bool StorageFS::flush(const std::uint64_t target)
+{
+    auto& sync = *sync_;
+    std::unique_lock<std::mutex> lock(sync.lock_);
+
+    while (sync.durable_ < std::min(target, sync.written_)) {
+        if (sync.syncing_) {
+            sync.synced_.wait(lock);
+
+            continue;
+        }
+
+        sync.syncing_ = true;
+        auto staged = std::map<std::string, std::string>{};
+        auto files = std::set<std::string>{};
+        auto directories = std::set<std::string>{};
+        staged.swap(sync.staged_);
+        files.swap(sync.written_files_);
+        directories.swap(sync.dirty_);
+        sync.flushing_ = staged;
+        const auto generation = sync.written_;
+        lock.unlock();
+#ifdef _WIN32
+        const auto committed{true};
+
+        if (false == sync.warned_.exchange(true)) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Stored files are not synced to disk on this platform. A "
+                "crash may lose or corrupt recently stored data.")
+                .Flush();
+        }
+#else
+        auto synced = files;
+
+        for (const auto& [path, temp] : staged) { synced.emplace(temp); }
+
+        bool committed = sync_files(synced);
+
+        for (auto it = staged.begin(); committed && (staged.end() != it);) {
+            const auto& [path, temp] = *it;
+
+            if (0 != std::rename(temp.c_str(), path.c_str())) {
+                LogOutput(OT_METHOD)(__FUNCTION__)(": Error replacing file: ")(
+                    path)(".")
+                    .Flush();
+                committed = false;
+
+                break;
+            }
+
+            it = staged.erase(it);
+        }
+
+        committed &= sync_directories(directories);
+#endif
+        lock.lock();
+        sync.flushing_.clear();
+        sync.syncing_ = false;
+
+        if (committed) {
+            sync.durable_ = generation;
+        } else {
+            // Newer writes to the same files take precedence
+            sync.staged_.insert(staged.begin(), staged.end());
+            sync.written_files_.insert(files.begin(), files.end());
+            sync.dirty_.insert(directories.begin(), directories.end());
+        }
+
+        sync.synced_.notify_all();
+
+        if (false == committed) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Failed to sync stored files.")
+                .Flush();
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Records the directory of a file which was erased, so the removal reaches
+// the disk before the next barrier completes.
+//
+void StorageFS::mark_dirty(const std::string& path)
+{
+    auto& sync = *sync_;
+    std::lock_guard<std::mutex> lock(sync.lock_);
+    sync.dirty_.emplace(parent_directory(path));
+    thread_written = ++sync.written_;
+}
+
+void StorageFS::Stage()
+{
+#ifndef _WIN32
+    thread_staged = true;
+#endif
+}
+
+bool StorageFS::Sync()
+{
+    thread_staged = false;
+
+    return flush(thread_written);
+}
+
+// Every write gets its own temporary file, so a staged copy is never
+// overwritten while a barrier is syncing or renaming it
+std::string StorageFS::temp_path(const std::string& path)
+{
+#ifdef _WIN32
+    return path;
+#else
+    auto& sync = *sync_;
+    std::lock_guard<std::mutex> lock(sync.lock_);
+
+    return path + "." + std::to_string(++sync.temp_) + ".tmp";
+#endif
+}
+
 // Returns path size, plus path in strOutput.
 //
 std::int64_t StorageFS::FormPathString(
@@ -27,6 +27,8 @@
 #include "internal/api/Api.hpp"
 
 #include <irrxml/irrXML.hpp>
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <cstdint>
 #include <map>
@@ -34,6 +36,7 @@
 #include <ostream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #define OT_METHOD "opentxs::OTCron"
 
@@ -55,14 +58,40 @@ std::int32_t OTCron::__cron_max_items_per_nym{10};
 
 Time OTCron::last_executed_{};
 
+namespace
+{
+// Each active cron item is saved to cron/items/TRANSACTION_NUM.crn, so that
+// changing one item never rewrites the others.
+const char* szItemFolder = "items";
+
+std::string item_digest(const String& contents)
+{
+    auto digest = Identifier::Factory();
+
+    if (false == digest->CalculateDigest(contents.Bytes())) { return {}; }
+
+    return digest->str();
+}
+
+std::string item_filename(const std::int64_t lTransactionNum)
+{
+    return std::to_string(lTransactionNum) + ".crn";
+}
+}  // namespace
+
 OTCron::OTCron(const api::internal::Core& server)
     : Contract(server)
     , m_mapMarkets()
     , m_mapCronItems()
     , m_multimapCronItems()
+    , m_queueDueItems()
+    , m_tNextDueDate(Time::max())
+    , m_mapItemState()
+    , m_setDirtyItems()
     , m_NOTARY_ID(api_.Factory().ServerID())
     , m_listTransactionNumbers()
     , m_bIsActivated(false)
+    , m_bListsChanged(false)
     , m_pServerNym(nullptr)  // just here for convenience, not responsible to
                              // cleanup this pointer.
 {
@@ -84,6 +113,10 @@ bool OTCron::LoadCron()
 
     if (bSuccess) bSuccess = VerifySignature(*(GetServerNym()));
 
+    // Items which were still stored inside an older cron file remain marked,
+    // and the cron file must then be rewritten to refer to their new files.
+    if (bSuccess) { m_bListsChanged = (false == m_setDirtyItems.empty()); }
+
     return bSuccess;
 }
 
@@ -95,6 +128,27 @@ bool OTCron::SaveCron()
 
     OT_ASSERT(nullptr != GetServerNym());
 
+    // The cron file only refers to the items, so each one must be on disk
+    // before a file which mentions it.
+    for (const auto& lTransactionNum : m_setDirtyItems) {
+        auto it = m_mapCronItems.find(lTransactionNum);
+
+        // The item was removed after it was marked
+        if (m_mapCronItems.end() == it) { continue; }
+
+        auto pItem = it->second;
+        OT_ASSERT(false != bool(pItem));
+
+        // save_item skips items whose contents have not changed
+        if (false == save_item(*pItem)) { return false; }
+    }
+
+    m_setDirtyItems.clear();
+
+    if (false == OTDB::Sync()) { return false; }
+
+    if (false == m_bListsChanged) { return true; }
+
     ReleaseSignatures();
 
     // Sign it, save it internally to string, and then save that out to the
@@ -105,8 +159,13 @@ bool OTCron::SaveCron()
             szFoldername)(PathSeparator())(szFilename)(".")
             .Flush();
         return false;
-    } else
-        return true;
+    }
+
+    m_bListsChanged = false;
+
+    // Callers erase items which the new cron file no longer mentions, so it
+    // must be durable first
+    return OTDB::Sync();
 }
 
 // Loops through ALL markets, and calls pMarket->GetNym_OfferList(NYM_ID,
@@ -333,6 +392,12 @@ std::int32_t OTCron::GetTransactionCount() const
 void OTCron::AddTransactionNumber(const std::int64_t& lTransactionNum)
 {
     m_listTransactionNumbers.push_back(lTransactionNum);
+    m_bListsChanged = true;
+}
+
+void OTCron::MarkDirty(const std::int64_t lTransactionNum)
+{
+    m_setDirtyItems.insert(lTransactionNum);
 }
 
 // Once this starts returning 0, OTCron can no longer process trades and
@@ -344,6 +409,7 @@ std::int64_t OTCron::GetNextTransactionNumber()
     std::int64_t lTransactionNum = m_listTransactionNumbers.front();
 
     m_listTransactionNumbers.pop_front();
+    m_bListsChanged = true;
 
     return lTransactionNum;
 }
@@ -398,10 +464,19 @@ std::int32_t OTCron::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
         const auto tDateAdded =
             (!str_date_added->Exists() ? Time{}
                                        : parseTimestamp(str_date_added->Get()));
+        const auto str_trans_num =
+            String::Factory(xml->getAttributeValue("transactionNum"));
 
         auto strData = String::Factory();
+        std::shared_ptr<OTCronItem> item{nullptr};
 
-        if (!Contract::LoadEncodedTextField(xml, strData) ||
+        if (str_trans_num->Exists()) {
+            // The item is stored in its own file
+            item = load_item(String::StringToLong(str_trans_num->Get()));
+
+            if (false == bool(item)) { return (-1); }
+        } else if (
+            !Contract::LoadEncodedTextField(xml, strData) ||
             !strData->Exists()) {
             LogOutput(OT_METHOD)(__FUNCTION__)(
                 ": Error in OTCron::ProcessXMLNode: cronItem field without "
@@ -409,6 +484,8 @@ std::int32_t OTCron::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
                 .Flush();
             return (-1);  // error condition
         } else {
+            // Older cron files contain the items themselves. They are moved
+            // to their own files the next time cron is saved.
             auto pItem{api_.Factory().CronItem(strData)};
 
             if (false == bool(pItem)) {
@@ -418,49 +495,55 @@ std::int32_t OTCron::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
                 return (-1);
             }
 
-            // Why not do this here (when loading from storage), as well as when
-            // first adding the item to cron,
-            // and thus save myself the trouble of verifying the signature EVERY
-            // ITERATION of ProcessCron().
-            //
-            std::shared_ptr<OTCronItem> item{pItem.release()};
-            if (!item->VerifySignature(*m_pServerNym)) {
-                LogOutput(OT_METHOD)(__FUNCTION__)(
-                    ": ERROR SECURITY: Server "
-                    "signature failed to "
-                    "verify on a cron item while loading: ")(
-                    item->GetTransactionNum())(".")
-                    .Flush();
-                return (-1);
-            } else if (AddCronItem(
-                           item,
-                           false,          // bSaveReceipt=false. The receipt is
-                                           // only saved once: When item FIRST
-                                           // added to cron...
-                           tDateAdded)) {  // ...But here, the item was
-                                           // ALREADY in cron, and is
-                                           // merely being loaded from
-                                           // disk.
-                // Thus, it would be wrong to try to create the "original
-                // record" as if it were brand
-                // new and still had the user's signature on it. (Once added to
-                // Cron, the signatures are
-                // released and the SERVER signs it from there. That's why the
-                // user's version is saved
-                // as a receipt in the first place -- so we have a record of the
-                // user's authorization.)
-                LogVerbose(OT_METHOD)(__FUNCTION__)(
-                    ": Successfully loaded cron item and added to list. ")
-                    .Flush();
-            } else {
-                LogOutput(OT_METHOD)(__FUNCTION__)(
-                    ": Though loaded / verified "
-                    "successfully, "
-                    "unable to add cron item (from cron file) to cron "
-                    " list.")
-                    .Flush();
-                return (-1);
+            item.reset(pItem.release());
+        }
+
+        // Why not do this here (when loading from storage), as well as when
+        // first adding the item to cron,
+        // and thus save myself the trouble of verifying the signature EVERY
+        // ITERATION of ProcessCron().
+        //
+        if (!item->VerifySignature(*m_pServerNym)) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": ERROR SECURITY: Server "
+                "signature failed to "
+                "verify on a cron item while loading: ")(
+                item->GetTransactionNum())(".")
+                .Flush();
+            return (-1);
+        } else if (AddCronItem(
+                       item,
+                       false,          // bSaveReceipt=false. The receipt is
+                                       // only saved once: When item FIRST
+                                       // added to cron...
+                       tDateAdded)) {  // ...But here, the item was
+                                       // ALREADY in cron, and is
+                                       // merely being loaded from
+                                       // disk.
+            // Thus, it would be wrong to try to create the "original
+            // record" as if it were brand
+            // new and still had the user's signature on it. (Once added to
+            // Cron, the signatures are
+            // released and the SERVER signs it from there. That's why the
+            // user's version is saved
+            // as a receipt in the first place -- so we have a record of the
+            // user's authorization.)
+            LogVerbose(OT_METHOD)(__FUNCTION__)(
+                ": Successfully loaded cron item and added to list. ")
+                .Flush();
+
+            // Its own file already matches what was loaded
+            if (str_trans_num->Exists()) {
+                m_setDirtyItems.erase(item->GetTransactionNum());
             }
+        } else {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Though loaded / verified "
+                "successfully, "
+                "unable to add cron item (from cron file) to cron "
+                " list.")
+                .Flush();
+            return (-1);
         }
 
         nReturnVal = 1;
@@ -552,18 +635,16 @@ void OTCron::UpdateContents(const PasswordPrompt& reason)
         tag.add_tag(tagMarket);
     }
 
-    // Save the Cron Items
+    // Save references to the Cron Items (each item is saved in its own file.)
     for (auto& it : m_multimapCronItems) {
         auto pItem = it.second;
         OT_ASSERT(false != bool(pItem));
 
         const auto tDateAdded{it.first};
-        auto strItem = String::Factory(*pItem);  // Extract the cron item
-                                                 // contract into string form.
-        auto ascItem =
-            Armored::Factory(strItem);  // Base64-encode that for storage.
 
-        TagPtr tagCronItem(new Tag("cronItem", ascItem->Get()));
+        TagPtr tagCronItem(new Tag("cronItem"));
+        tagCronItem->add_attribute(
+            "transactionNum", std::to_string(pItem->GetTransactionNum()));
         tagCronItem->add_attribute("dateAdded", formatTimestamp(tDateAdded));
         tag.add_tag(tagCronItem);
     }
@@ -582,11 +663,22 @@ void OTCron::UpdateContents(const PasswordPrompt& reason)
     m_xmlUnsigned->Concatenate("%s", str_result.c_str());
 }
 
+// Time until the next round should run: no sooner than the configured
+// interval after the previous round, and not before some item is due.
 std::chrono::milliseconds OTCron::computeTimeout()
 {
-    return GetCronMsBetweenProcess() -
-           std::chrono::duration_cast<std::chrono::milliseconds>(
-               Clock::now() - last_executed_);
+    const auto now = Clock::now();
+    const auto round = GetCronMsBetweenProcess() -
+                       std::chrono::duration_cast<std::chrono::milliseconds>(
+                           now - last_executed_);
+    const auto next = m_tNextDueDate.load();
+
+    if (next <= now) { return round; }
+
+    const auto wait =
+        std::chrono::duration_cast<std::chrono::milliseconds>(next - now);
+
+    return std::max(round, wait);
 }
 
 // Make sure to call this regularly so the CronItems get a chance to process and
@@ -619,13 +711,20 @@ void OTCron::ProcessCronItems()
             .Flush();
         return;
     }
-    bool bNeedToSave = false;
+    const auto now = Clock::now();
+    // Items which stay on cron are rescheduled after the round, so none of
+    // them can come up twice in the same round.
+    std::vector<std::shared_ptr<OTCronItem>> processed{};
+    std::vector<std::int64_t> removed{};
+
+    // Take the items which are due, earliest first, and tell each one to
+    // ProcessCron(). If the item returns true, that means leave it on the
+    // list. Otherwise, if it returns false, that means "it's done: remove it."
+    while (false == m_queueDueItems.empty()) {
+        const auto [tDueDate, lTransactionNum] = m_queueDueItems.top();
+
+        if (tDueDate >= now) { break; }
 
-    // loop through the cron items and tell each one to ProcessCron().
-    // If the item returns true, that means leave it on the list. Otherwise,
-    // if it returns false, that means "it's done: remove it."
-    for (auto it = m_multimapCronItems.begin();
-         it != m_multimapCronItems.end();) {
         if (GetTransactionCount() <= nTwentyPercent) {
             LogOutput(OT_METHOD)(__FUNCTION__)(
                 ": WARNING: Cron has fewer than 20 percent of its normal "
@@ -642,14 +741,23 @@ void OTCron::ProcessCronItems()
                 .Flush();
             break;
         }
-        auto pItem = it->second;
+
+        m_queueDueItems.pop();
+        auto it_map = m_mapCronItems.find(lTransactionNum);
+
+        // The item was removed after it was scheduled
+        if (m_mapCronItems.end() == it_map) { continue; }
+
+        auto pItem = it_map->second;
         OT_ASSERT(false != bool(pItem));
         LogVerbose(OT_METHOD)(__FUNCTION__)(": Processing item number: ")(
             pItem->GetTransactionNum())
             .Flush();
 
         if (pItem->ProcessCron(reason)) {
-            it++;
+            // Only items whose contents changed are written
+            MarkDirty(lTransactionNum);
+            processed.push_back(pItem);
             continue;
         }
         pItem->HookRemovalFromCron(
@@ -657,14 +765,28 @@ void OTCron::ProcessCronItems()
         LogNormal(OT_METHOD)(__FUNCTION__)(": Removing cron item: ")(
             pItem->GetTransactionNum())(".")
             .Flush();
-        it = m_multimapCronItems.erase(it);
-        auto it_map = FindItemOnMap(pItem->GetTransactionNum());
-        OT_ASSERT(m_mapCronItems.end() != it_map);
+        auto it_multimap = FindItemOnMultimap(lTransactionNum);
+        OT_ASSERT(m_multimapCronItems.end() != it_multimap);
+        m_multimapCronItems.erase(it_multimap);
         m_mapCronItems.erase(it_map);
+        m_mapItemState.erase(lTransactionNum);
+        removed.push_back(lTransactionNum);
+        m_bListsChanged = true;
+    }
 
-        bNeedToSave = true;
+    for (const auto& pItem : processed) { schedule(*pItem); }
+
+    update_next_due();
+
+    if (m_setDirtyItems.empty() && (false == m_bListsChanged)) { return; }
+
+    // The item files are only deleted once the cron file no longer refers to
+    // them
+    if (SaveCron()) {
+        for (const auto& lTransactionNum : removed) {
+            erase_item(lTransactionNum);
+        }
     }
-    if (bNeedToSave) SaveCron();
 }
 
 // OTCron IS responsible for cleaning up theItem, and takes ownership.
@@ -723,6 +845,9 @@ bool OTCron::AddCronItem(
         m_multimapCronItems.insert(
             m_multimapCronItems.upper_bound(tDateAdded),
             std::pair<Time, std::shared_ptr<OTCronItem>>(tDateAdded, theItem));
+        m_mapItemState[theItem->GetTransactionNum()].first = tDateAdded;
+        MarkDirty(theItem->GetTransactionNum());
+        m_bListsChanged = true;
 
         theItem->SetCronPointer(*this);
         theItem->setServerNym(m_pServerNym);
@@ -737,6 +862,9 @@ bool OTCron::AddCronItem(
         // But if actually being activated for the first time, then this is
         // true.
 
+        schedule(*theItem);
+        update_next_due();
+
         // When an item is added to Cron for the first time, a copy of it is
         // saved to the
         // cron folder, and it has the user's original signature on it. (If it's
@@ -821,9 +949,16 @@ bool OTCron::RemoveCronItem(
 
         m_mapCronItems.erase(it_map);            // Remove from MAP.
         m_multimapCronItems.erase(it_multimap);  // Remove from MULTIMAP.
+        m_mapItemState.erase(lTransactionNum);
+        m_bListsChanged = true;
+        // Its entry on the due queue is discarded when it comes up.
 
         // An item has been removed from Cron. SAVE.
-        return SaveCron();
+        if (false == SaveCron()) { return false; }
+
+        erase_item(lTransactionNum);
+
+        return true;
     }
 
     return false;
@@ -868,6 +1003,20 @@ mapOfCronItems::iterator OTCron::FindItemOnMap(std::int64_t lTransactionNum)
 multimapOfCronItems::iterator OTCron::FindItemOnMultimap(
     std::int64_t lTransactionNum)
 {
+    const auto state = m_mapItemState.find(lTransactionNum);
+
+    // Only the items added at the same time need to be compared
+    if (m_mapItemState.end() != state) {
+        const auto range = m_multimapCronItems.equal_range(state->second.first);
+
+        for (auto itt = range.first; itt != range.second; ++itt) {
+            auto pItem = itt->second;
+            OT_ASSERT(false != bool(pItem));
+
+            if (pItem->GetTransactionNum() == lTransactionNum) { return itt; }
+        }
+    }
+
     auto itt = m_multimapCronItems.begin();
 
     while (m_multimapCronItems.end() != itt) {
@@ -995,6 +1144,7 @@ bool OTCron::AddMarket(
         }
 
         m_mapMarkets[std_MARKET_ID] = theMarket;
+        m_bListsChanged = true;
 
         bool bSuccess = true;
 
@@ -1108,6 +1258,107 @@ std::shared_ptr<OTMarket> OTCron::GetMarket(const Identifier& MARKET_ID)
     return nullptr;
 }
 
+bool OTCron::erase_item(const std::int64_t lTransactionNum)
+{
+    const auto filename = item_filename(lTransactionNum);
+
+    if (false == OTDB::EraseValueByKey(
+                     api_,
+                     api_.DataFolder(),
+                     api_.Legacy().Cron(),
+                     szItemFolder,
+                     filename,
+                     "")) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to erase cron item ")(
+            lTransactionNum)(".")
+            .Flush();
+
+        return false;
+    }
+
+    return true;
+}
+
+std::shared_ptr<OTCronItem> OTCron::load_item(
+    const std::int64_t lTransactionNum)
+{
+    const auto filename = item_filename(lTransactionNum);
+    const auto strItem = String::Factory(OTDB::QueryPlainString(
+        api_,
+        api_.DataFolder(),
+        api_.Legacy().Cron(),
+        szItemFolder,
+        filename,
+        ""));
+
+    if (false == strItem->Exists()) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Unable to read cron item ")(
+            lTransactionNum)(".")
+            .Flush();
+
+        return nullptr;
+    }
+
+    auto pItem{api_.Factory().CronItem(strItem)};
+
+    if ((false == bool(pItem)) ||
+        (pItem->GetTransactionNum() != lTransactionNum)) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid cron item ")(
+            lTransactionNum)(".")
+            .Flush();
+
+        return nullptr;
+    }
+
+    std::shared_ptr<OTCronItem> output{pItem.release()};
+    m_mapItemState[lTransactionNum].second =
+        item_digest(String::Factory(*output));
+
+    return output;
+}
+
+bool OTCron::save_item(const OTCronItem& item)
+{
+    const auto lTransactionNum = item.GetTransactionNum();
+    const auto strItem = String::Factory(item);
+    const auto digest = item_digest(strItem);
+    auto& state = m_mapItemState[lTransactionNum];
+
+    if ((false == digest.empty()) && (digest == state.second)) { return true; }
+
+    const auto filename = item_filename(lTransactionNum);
+
+    if (false == OTDB::StorePlainString(
+                     api_,
+                     strItem->Get(),
+                     api_.DataFolder(),
+                     api_.Legacy().Cron(),
+                     szItemFolder,
+                     filename,
+                     "")) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to save cron item ")(
+            lTransactionNum)(".")
+            .Flush();
+
+        return false;
+    }
+
+    state.second = digest;
+
+    return true;
+}
+
+void OTCron::schedule(const OTCronItem& item)
+{
+    m_queueDueItems.emplace(item.GetNextDueDate(), item.GetTransactionNum());
+}
+
+void OTCron::update_next_due()
+{
+    m_tNextDueDate.store(
+        m_queueDueItems.empty() ? Time::max() : m_queueDueItems.top().first);
+}
+
 void OTCron::InitCron() { m_strContractType = String::Factory("CRON"); }
 
 void OTCron::Release() { Contract::Release(); }
@@ -746,6 +746,15 @@ bool OTCronItem::CanRemoveItemFromCron(const ClientContext& context)
     // above. Only if that fails, do you need to dig deeper...
 }
 
+// Every subclass returns early from ProcessCron until the process interval has
+// passed since the previous call, so there is nothing to do before then.
+Time OTCronItem::GetNextDueDate() const
+{
+    if (Time{} == m_LAST_PROCESS_DATE) { return Time{}; }
+
+    return m_LAST_PROCESS_DATE + m_PROCESS_INTERVAL;
+}
+
 // OTCron calls this regularly, which is my chance to expire, etc.
 // Child classes will override this, AND call it (to verify valid date
 // range.)
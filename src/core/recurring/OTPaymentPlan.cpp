@@ -31,6 +31,8 @@
 #include "internal/api/Api.hpp"
 
 #include <irrxml/irrXML.hpp>
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
 #include <sys/types.h>
@@ -1118,11 +1120,8 @@ bool OTPaymentPlan::ProcessPayment(
             SignContract(*pServerNym, reason);
             SaveContract();
 
-            // No need to save Cron here, since both caller functions call
-            // SaveCron() EVERY time anyway,
-            // success or failure, rain or shine.
-            // m_pCron->SaveCron(); // Cron is where I am serialized, so if
-            // Cron's not saved, I'm not saved.
+            // No need to save Cron here, since ProcessCronItems() saves
+            // this plan once the round is finished.
 
             //
             // EVERYTHING BELOW is just about notifying the users, by dropping
@@ -1273,42 +1272,8 @@ void OTPaymentPlan::ProcessInitialPayment(
     // saved inside the ProcessPayment() call as part of constructing the
     // receipt.
 
-    // Since this' data file is actually a blob as part of Cron,
-    // then we need to save Cron as well. Only then are these changes truly
-    // saved.
-    // I'm actually lucky to even be able to save cron here, since I know for a
-    // fact
-    // that I have to save no matter what. In cases where I don't know for sure,
-    // the
-    // save call has to go a level deeper, since only there would the code know
-    // whether
-    // or not something has actually changed.
-    // HMM Todo: Look into adding a "DIRTY" field to OT objects.
-    // Double-hmm, todo: I could make a series of macros for serializable member
-    // variables,
-    // that would deal with all the xml read/write very compactly, and
-    // automatically track
-    // whether the variable was dirty. Then anywhere in the code I can just ask
-    // an object
-    // if it is dirty, or instruct it to update itself if it is.  Anyway, let's
-    // save Cron...
-
-    GetCron()->SaveCron();
-
-    // Todo: put the actual Cron items in separate files, so I don't have to
-    // update
-    // the entire cron file every time an item changes. That way the main cron
-    // file
-    // can just keep a record of the active items, and will change only when an
-    // item
-    // is added or removed.
-    //
-    // Until then, the entire Cron file will have to save EVERY time this call
-    // happens.
-    //
-    // (I'll add something to Cron so it can't save more than once per second or
-    // something.)
-    // (DONE: Payment Plans process hourly and Trades process every 10 seconds.)
+    // This is only called from ProcessCron(), so ProcessCronItems() saves the
+    // plan and Cron once the round is finished.
 }
 
 /*
@@ -1371,12 +1336,82 @@ void OTPaymentPlan::ProcessPaymentPlan(
     // saved inside the ProcessPayment() call as part of constructing the
     // receipt.
 
-    // Either way, Cron should save, since it just updated.
-    // (The above function call WILL change this payment plan
-    // and re-sign it and save it, no matter what. So I just
-    // call this here to keep it simple:
+    // ProcessCronItems() writes the plan after ProcessCron() returns.
+}
+
+// A plan with weekly or monthly payments only needs attention when a payment,
+// a retry or one of its end dates comes up, rather than at every interval.
+// Anything which is already overdue keeps the default interval, so that a
+// round which could not finish (for example because Cron ran out of
+// transaction numbers) is retried as before.
+Time OTPaymentPlan::GetNextDueDate() const
+{
+    const auto due = ot_super::GetNextDueDate();
+    const auto last = GetLastProcessDate();
+
+    if ((Time{} == last) || IsFlaggedForRemoval()) { return due; }
+
+    if ((GetMaximumNoPayments() > 0) &&
+        (GetNoPaymentsDone() >= GetMaximumNoPayments())) {
+        return due;
+    }
+
+    if (HasInitialPayment() && IsInitialPaymentDone() && !HasPaymentPlan()) {
+        return due;
+    }
+
+    // Never sleep longer than a day, in case of a state not covered below
+    auto next = last + std::chrono::hours{24};
+    bool overdue{false};
+    const auto pending = [&](const Time& time) -> void {
+        if (time <= last) {
+            overdue = true;
+        } else {
+            next = std::min(next, time);
+        }
+    };
+
+    if (GetValidFrom() > last) { next = std::min(next, GetValidFrom()); }
+
+    if (GetValidTo() > Time{}) { pending(GetValidTo()); }
+
+    if (HasInitialPayment() && !IsInitialPaymentDone()) {
+        auto initial = GetInitialPaymentDate();
+
+        if (Time{} != GetLastFailedInitialPaymentDate()) {
+            initial = std::max(
+                initial,
+                GetLastFailedInitialPaymentDate() + std::chrono::hours{24});
+        }
+
+        pending(initial);
+    }
+
+    if (HasPaymentPlan() &&
+        (GetTimeBetweenPayments() > std::chrono::seconds{0})) {
+        const auto start = GetPaymentPlanStartDate();
+        const auto between = GetTimeBetweenPayments();
+        // The payment after the ones already made, subject to the same
+        // conditions ProcessCron checks
+        auto payment = std::max(
+            start + between * GetNoPaymentsDone(),
+            GetDateOfLastPayment() + between);
+
+        if (Time{} != GetDateOfLastFailedPayment()) {
+            payment = std::max(
+                payment, GetDateOfLastFailedPayment() + std::chrono::hours{24});
+        }
+
+        pending(std::max(payment, start));
+
+        if (GetPaymentPlanLength() > std::chrono::seconds{0}) {
+            pending(start + GetPaymentPlanLength());
+        }
+    }
+
+    if (overdue) { return due; }
 
-    GetCron()->SaveCron();
+    return std::max(due, next);
 }
 
 // OTCron calls this regularly, which is my chance to expire, etc.
@@ -2986,17 +2986,11 @@ bool OTSmartContract::StashFunds(
     }  // By the time we enter this block, accounts and nyms are already loaded.
        // As we begin, inboxes are instantiated.
 
-    // Either way, Cron should save, since it just updated.
-    // The above function call WILL change this smart contract
-    // and re-sign it and save it, no matter what. So I just
-    // call this here to keep it simple:
-
-    pCron->SaveCron();  // TODO No need to call this here if I can make sure
-                        // it's being called higher up somewhere
-    // (Imagine a script that has 10 account moves in it -- maybe don't need to
-    // save cron until
-    // after all 10 are done. Or maybe DO need to do in between. Todo research
-    // this. Optimization.)
+    // Either way, the above function call WILL change this smart contract and
+    // re-sign it. Whoever ran the clause saves Cron once it has finished, so a
+    // script with several account moves in it is only written once.
+    pCron->MarkDirty(GetTransactionNum());
+
     return bSuccess;
 }
 
@@ -6231,12 +6225,9 @@ bool OTSmartContract::MoveFunds(
 
     // Todo: possibly notify ALL parties here (in Nymbox.)
 
-    // Either way, Cron should save, since it just updated.
-    // The above function WILL change this smart contract.
-    // and re-sign it and save it, no matter what. So I just
-    // call this here to keep it simple:
-
-    GetCron()->SaveCron();
+    // Either way, the above function WILL change this smart contract. It is
+    // written when Cron is next saved, after the clause has finished.
+    GetCron()->MarkDirty(GetTransactionNum());
 
     return bSuccess;
 }
@@ -1940,10 +1940,10 @@ void OTMarket::ProcessTrade(
                 // updated.
                 SaveMarket(reason);
 
-                // The Trade has changed, and it is stored as a
-                // CronItem. So I save Cron as well, for the same reason
-                // I saved the Market.
-                pCron->SaveCron();
+                // Both Trades have changed, and they are stored as
+                // CronItems. Cron writes them at the end of this round.
+                pCron->MarkDirty(theTrade.GetTransactionNum());
+                pCron->MarkDirty(pOtherTrade->GetTransactionNum());
             }
 
             //
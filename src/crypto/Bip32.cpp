@@ -13,6 +13,7 @@
 #include "opentxs/core/crypto/OTPassword.hpp"
 #include "opentxs/core/Data.hpp"
 #include "opentxs/crypto/key/Asymmetric.hpp"
+#include "opentxs/crypto/key/HD.hpp"
 #include "opentxs/crypto/library/EcdsaProvider.hpp"
 #include "opentxs/crypto/Bip32.hpp"
 #include "opentxs/crypto/Bip39.hpp"
@@ -216,6 +217,223 @@ auto Bip32::DeriveKey(
 
     return output;
 }
+
+auto Bip32::DerivePublic(
+    const EcdsaCurve& curve,
+    const Key& parent,
+    const Path& path) const -> Key
+{
+    const auto& [notUsed, parentCode, parentKey, parentPath, grandparent] =
+        parent;
+    auto output = Key{OTPassword{}, OTPassword{}, Data::Factory(), {}, 0};
+
+    if (EcdsaCurve::secp256k1 != curve) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(
+            ": Public derivation is only defined for secp256k1")
+            .Flush();
+
+        return output;
+    }
+
+    if ((32 != parentCode.getMemorySize()) || (33 != parentKey->size())) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid parent node").Flush();
+
+        return output;
+    }
+
+    auto code = OTPassword{parentCode};
+    auto key = space(33);
+    auto next = space(33);
+    auto data = space(33 + 4);
+    auto hashSpace = OTPassword{OTPassword::Mode::Mem, {}};
+    auto hash = hashSpace.WriteInto()(64);
+    auto fingerprint = grandparent;
+    std::memcpy(key.data(), parentKey->Bytes().data(), key.size());
+
+    if (false == hash.valid(64)) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(
+            ": Failed to allocate temporary hash space")
+            .Flush();
+
+        return output;
+    }
+
+    try {
+        const auto& ecdsa = provider(curve);
+
+        for (const auto& child : path) {
+            if (IsHard(child)) {
+                LogOutput(OT_METHOD)(__FUNCTION__)(
+                    ": Hardened children require the private key")
+                    .Flush();
+
+                return output;
+            }
+
+            fingerprint =
+                key::HD::CalculateFingerprint(crypto_.Hash(), reader(key));
+            const auto i = be::big_uint32_buf_t{child};
+            std::memcpy(data.data(), key.data(), key.size());
+            std::memcpy(std::next(data.data(), key.size()), &i, sizeof(i));
+            const auto hashed = crypto_.Hash().HMAC(
+                proto::HASHTYPE_SHA512,
+                code.Bytes(),
+                reader(data),
+                [&hash](const auto) {
+                    return WritableView{hash.data(), 64};
+                });
+
+            if (false == hashed) {
+                LogOutput(OT_METHOD)(__FUNCTION__)(
+                    ": Failed to calculate hash")
+                    .Flush();
+
+                return output;
+            }
+
+            if (false ==
+                ecdsa.PubkeyAdd(
+                    reader(key), {hash.as<char>(), 32}, writer(next))) {
+                LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid child (")(child)(
+                    ")")
+                    .Flush();
+
+                return output;
+            }
+
+            key.swap(next);
+            code.setMemory(std::next(hash.as<std::byte>(), 32), 32);
+        }
+    } catch (const std::exception& e) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
+
+        return output;
+    }
+
+    auto& [privateKey, chainCode, publicKey, pathOut, parentOut] = output;
+    chainCode.setMemory(code.getMemory(), code.getMemorySize());
+    publicKey->Assign(reader(key));
+    pathOut = parentPath;
+    pathOut.insert(pathOut.end(), path.begin(), path.end());
+    parentOut = fingerprint;
+
+    return output;
+}
+
+auto Bip32::DerivePublic(
+    const EcdsaCurve& curve,
+    const Key& parent,
+    const Bip32Index first,
+    const std::size_t count,
+    const AllocateOutput keys) const -> bool
+{
+    static constexpr auto keySize = std::size_t{33};
+    const auto& [notUsed, code, key, path, grandparent] = parent;
+
+    if (EcdsaCurve::secp256k1 != curve) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(
+            ": Public derivation is only defined for secp256k1")
+            .Flush();
+
+        return false;
+    }
+
+    if ((32 != code.getMemorySize()) || (keySize != key->size())) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid parent node").Flush();
+
+        return false;
+    }
+
+    if (false == bool(keys)) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid output allocator")
+            .Flush();
+
+        return false;
+    }
+
+    static const auto hard = Bip32Index{HDIndex{Bip32Child::HARDENED}};
+
+    if (IsHard(first) || ((hard - first) < count)) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(
+            ": Hardened children require the private key")
+            .Flush();
+
+        return false;
+    }
+
+    auto out = keys(count * keySize);
+
+    if (false == out.valid(count * keySize)) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(
+            ": Failed to allocate space for public keys")
+            .Flush();
+
+        return false;
+    }
+
+    auto hashSpace = OTPassword{OTPassword::Mode::Mem, {}};
+    auto hash = hashSpace.WriteInto()(64);
+
+    if (false == hash.valid(64)) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(
+            ": Failed to allocate temporary hash space")
+            .Flush();
+
+        return false;
+    }
+
+    // Only the trailing index changes between children
+    auto data = space(keySize + 4);
+    std::memcpy(data.data(), key->Bytes().data(), keySize);
+    auto* index = std::next(data.data(), keySize);
+    auto* it = out.as<std::byte>();
+
+    try {
+        const auto& ecdsa = provider(curve);
+
+        for (std::size_t i{0}; i < count; ++i) {
+            const auto child =
+                be::big_uint32_buf_t{first + static_cast<Bip32Index>(i)};
+            std::memcpy(index, &child, sizeof(child));
+            const auto hashed = crypto_.Hash().HMAC(
+                proto::HASHTYPE_SHA512,
+                code.Bytes(),
+                reader(data),
+                [&hash](const auto) {
+                    return WritableView{hash.data(), 64};
+                });
+
+            if (false == hashed) {
+                LogOutput(OT_METHOD)(__FUNCTION__)(
+                    ": Failed to calculate hash")
+                    .Flush();
+
+                return false;
+            }
+
+            const auto added = ecdsa.PubkeyAdd(
+                key->Bytes(), {hash.as<char>(), 32}, [it](const auto) {
+                    return WritableView{it, keySize};
+                });
+
+            if (false == added) {
+                LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid child (")(
+                    child.value())(")")
+                    .Flush();
+
+                return false;
+            }
+
+            std::advance(it, keySize);
+        }
+    } catch (const std::exception& e) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
+
+        return false;
+    }
+
+    return true;
+}
 #endif  // OT_CRYPTO_WITH_BIP32
 
 auto Bip32::DeserializePrivate(
@@ -25,6 +25,16 @@ public:
         const EcdsaCurve& curve,
         const OTPassword& seed,
         const Path& path) const final;
+    Key DerivePublic(
+        const EcdsaCurve& curve,
+        const Key& parent,
+        const Path& path) const final;
+    bool DerivePublic(
+        const EcdsaCurve& curve,
+        const Key& parent,
+        const Bip32Index first,
+        const std::size_t count,
+        const AllocateOutput keys) const final;
 #endif  // OT_CRYPTO_WITH_BIP32
     bool DeserializePrivate(
         const std::string& serialized,
@@ -13,6 +13,10 @@ class Secp256k1 final : virtual public crypto::Secp256k1,
                         public EcdsaProvider
 {
 public:
+    bool PubkeyAdd(
+        const ReadView pubkey,
+        const ReadView scalar,
+        const AllocateOutput result) const noexcept final;
     bool RandomKeypair(
         const AllocateOutput privateKey,
         const AllocateOutput publicKey,
@@ -318,6 +318,51 @@ std::size_t Sodium::KeySize(const proto::SymmetricMode mode) const
 }
 
 #if OT_CRYPTO_SUPPORTED_KEY_ED25519
+auto Sodium::PubkeyAdd(
+    const ReadView pubkey,
+    const ReadView scalar,
+    const AllocateOutput result) const noexcept -> bool
+{
+    if (false == bool(result)) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid output allocator")
+            .Flush();
+
+        return false;
+    }
+
+    if (crypto_core_ed25519_BYTES != pubkey.size()) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid public key").Flush();
+
+        return false;
+    }
+
+    auto tweak = std::array<unsigned char, crypto_core_ed25519_BYTES>{};
+    const auto haveTweak = ScalarMultiplyBase(scalar, [&tweak](const auto) {
+        return WritableView{tweak.data(), tweak.size()};
+    });
+
+    if (false == haveTweak) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid scalar").Flush();
+
+        return false;
+    }
+
+    auto pub = result(crypto_core_ed25519_BYTES);
+
+    if (false == pub.valid(crypto_core_ed25519_BYTES)) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(
+            ": Failed to allocate space for public key")
+            .Flush();
+
+        return false;
+    }
+
+    return 0 == ::crypto_core_ed25519_add(
+                    pub.as<unsigned char>(),
+                    reinterpret_cast<const unsigned char*>(pubkey.data()),
+                    tweak.data());
+}
+
 bool Sodium::RandomKeypair(
     const AllocateOutput privateKey,
     const AllocateOutput publicKey,
@@ -29,6 +29,10 @@ public:
         std::uint8_t* output) const final;
     bool RandomizeMemory(void* destination, const std::size_t size) const final;
 #if OT_CRYPTO_SUPPORTED_KEY_ED25519
+    bool PubkeyAdd(
+        const ReadView pubkey,
+        const ReadView scalar,
+        const AllocateOutput result) const noexcept final;
     bool RandomKeypair(
         const AllocateOutput privateKey,
         const AllocateOutput publicKey,
@@ -30,6 +30,21 @@ namespace opentxs::internal
 
 namespace opentxs::api::internal
 {
+/** In-memory copies of ledger box files and of signatures which have already
+ *  been verified. Only notaries provide one. */
+struct BoxCache {
+    virtual void Erase(const std::string& location) const noexcept = 0;
+    virtual bool Load(const std::string& location, std::string& contents) const
+        noexcept = 0;
+    virtual void SetVerified(const std::string& digest) const noexcept = 0;
+    virtual void Store(
+        const std::string& location,
+        const std::string& contents) const noexcept = 0;
+    virtual bool Verified(const std::string& digest) const noexcept = 0;
+
+    virtual ~BoxCache() = default;
+};
+
 struct Context : virtual public api::Context {
     virtual OTCaller& GetPasswordCaller() const = 0;
     virtual void Init() = 0;
@@ -42,6 +57,7 @@ struct Context : virtual public api::Context {
 struct Core : virtual public api::Core {
     const proto::Ciphertext encrypted_secret_{};
 
+    virtual const BoxCache* Boxes() const noexcept = 0;
     virtual INTERNAL_PASSWORD_CALLBACK* GetInternalPasswordCallback() const = 0;
     virtual bool GetSecret(
         const opentxs::Lock& lock,
@@ -53,6 +53,10 @@ struct Blockchain : virtual public api::client::Blockchain {
         virtual std::vector<Status> Lookup(
             const identifier::Nym& nym,
             const Data& element) const noexcept = 0;
+        /// Results are in the same order as elements
+        virtual std::vector<std::vector<Status>> Lookup(
+            const identifier::Nym& nym,
+            const std::vector<OTData>& elements) const noexcept = 0;
 
         virtual ~TxoDB() = default;
     };
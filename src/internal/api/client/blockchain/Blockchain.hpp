@@ -64,6 +64,7 @@ using FilterHash = opentxs::blockchain::client::internal::FilterDatabase::Hash;
 using FilterHeader =
     opentxs::blockchain::client::internal::FilterDatabase::Header;
 using FilterType = opentxs::blockchain::filter::Type;
+using PeerScore = opentxs::blockchain::client::internal::PeerScore;
 using Position = opentxs::blockchain::block::Position;
 using Protocol = opentxs::blockchain::p2p::Protocol;
 using Service = opentxs::blockchain::p2p::Service;
@@ -84,6 +85,8 @@ enum Table {
     FilterHeadersBasic = 10,
     FilterHeadersBCH = 11,
     FilterHeadersOpentxs = 12,
+    Config = 13,
+    PeerScores = 14,
 };
 }  // namespace opentxs::api::client::blockchain
 #endif  // OT_BLOCKCHAIN
@@ -101,6 +104,9 @@ struct BalanceList : virtual public blockchain::BalanceList {
         Identifier& id) noexcept = 0;
     virtual BalanceTree& Nym(const identifier::Nym& id) noexcept = 0;
     virtual const client::internal::Blockchain& Parent() const noexcept = 0;
+    /// Disconnect every block above the parent height from all trees
+    virtual void Reorg(
+        const opentxs::blockchain::block::Height parent) noexcept = 0;
 };
 
 struct BalanceElement : virtual public blockchain::BalanceNode::Element {
@@ -142,8 +148,12 @@ struct BalanceNode : virtual public blockchain::BalanceNode {
 };
 
 struct BalanceTree : virtual public blockchain::BalanceTree {
+    /// Confirmed and unconfirmed amounts
+    using Balance = std::pair<Amount, Amount>;
+
     virtual const api::internal::Core& API() const noexcept = 0;
     virtual bool AssociateTransaction(
+        const std::string& txid,
         const std::vector<Activity>& unspent,
         const std::vector<Activity>& spent,
         std::set<OTIdentifier>& contacts,
@@ -152,11 +162,27 @@ struct BalanceTree : virtual public blockchain::BalanceTree {
     virtual void ClaimAccountID(
         const std::string& id,
         internal::BalanceNode* node) const noexcept = 0;
+    /// Returns false if the transaction is unknown
+    virtual bool ConfirmTransaction(
+        const std::string& txid,
+        const opentxs::blockchain::block::Height height) const noexcept = 0;
+    /// Sum of all subaccounts, answered from a running total
+    virtual Balance GetBalance() const noexcept = 0;
+    virtual Balance GetBalance(const Identifier& account) const noexcept = 0;
+    /// Make elements (pubkey hashes) findable via LookupElement
+    virtual void IndexElements(
+        const std::vector<std::pair<OTData, Key>>& elements) const
+        noexcept = 0;
+    virtual std::optional<Key> LookupElement(const ReadView element) const
+        noexcept = 0;
     virtual std::optional<std::pair<Key, Amount>> LookupUTXO(
         const Coin& coin) const noexcept = 0;
     virtual const blockchain::internal::HD& HDChain(
         const Identifier& account) const noexcept(false) = 0;
     virtual const internal::BalanceList& Parent() const noexcept = 0;
+    /// Return transactions in blocks above the parent height to unconfirmed
+    virtual void Reorg(
+        const opentxs::blockchain::block::Height parent) const noexcept = 0;
 
     virtual bool AddHDNode(
         const proto::HDPath& path,
@@ -16,33 +16,51 @@
 
 #include <array>
 #include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <optional>
 #include <string>
 #include <tuple>
+#include <vector>
 
 namespace be = boost::endian;
 
 namespace opentxs::blockchain::internal
 {
+using Sha256Digest = std::array<std::byte, 32>;
+
 // Source of BitReader class:
 // https://github.com/rasky/gcs/blob/master/cpp/gcs.cpp
 // The license there reads:
 // "This is free and unencumbered software released into the public domain."
+//
+// Modified to refill a 64 bit accumulator a word at a time and to decode
+// unary runs with a count leading zeros instruction
 class BitReader
 {
 public:
     OPENTXS_EXPORT bool eof();
+    // nbits must not exceed 57
     OPENTXS_EXPORT std::uint64_t read(std::size_t nbits);
+    // Returns the number of 1 bits preceding the next 0 bit and consumes the
+    // terminating 0
+    OPENTXS_EXPORT std::uint64_t read_unary();
 
+    // The input is not copied and must outlive the reader
     OPENTXS_EXPORT BitReader(const Data& input_data);
     OPENTXS_EXPORT BitReader(std::uint8_t* data, int len);
 
 private:
-    OTData raw_data_;
-    std::uint8_t* data_{nullptr};
+    enum { ACCUM_BITS = sizeof(std::uint64_t) * 8 };
+
+    const std::uint8_t* data_{nullptr};
     std::size_t len_{};
+    // Unread bits are stored starting at the most significant bit
     std::uint64_t accum_{};
     std::size_t n_{};
 
+    void refill();
+
     BitReader() = delete;
     BitReader(const BitReader&) = delete;
     BitReader(BitReader&&) = delete;
@@ -54,11 +72,17 @@ private:
 // https://github.com/rasky/gcs/blob/master/cpp/gcs.cpp
 // The license there reads:
 // "This is free and unencumbered software released into the public domain."
+//
+// Modified to emit whole 64 bit words and to encode unary runs with a single
+// shift and or
 class BitWriter
 {
 public:
     OPENTXS_EXPORT void flush();
+    // nbits must not exceed 64
     OPENTXS_EXPORT void write(std::size_t nbits, std::uint64_t value);
+    // Writes count 1 bits followed by a 0 bit
+    OPENTXS_EXPORT void write_unary(std::uint64_t count);
 
     OPENTXS_EXPORT BitWriter(Data& output);
 
@@ -66,15 +90,69 @@ private:
     enum { ACCUM_BITS = sizeof(std::uint64_t) * 8 };
 
     Data& output_;
+    // Pending bits are stored starting at the most significant bit
     std::uint64_t accum_{};
     std::size_t n_{};
 
     BitWriter() = delete;
 };
 
+// SipHash-2-4 with the key schedule computed once, so the same key can be
+// applied to any number of elements from any number of threads without
+// allocating
+class SipHasher
+{
+public:
+    static constexpr std::size_t lanes_{4};
+
+    using Items = std::array<ReadView, lanes_>;
+    using Hashes = std::array<std::uint64_t, lanes_>;
+
+    /// Returns the high 64 bits of hash * range, which maps hash uniformly
+    /// into [0, range)
+    OPENTXS_EXPORT static std::uint64_t Reduce(
+        const std::uint64_t hash,
+        const std::uint64_t range) noexcept;
+
+    OPENTXS_EXPORT std::uint64_t operator()(const ReadView item) const
+        noexcept;
+
+    /// Hashes lanes_ items at once with the rounds of every lane interleaved
+    OPENTXS_EXPORT void Hash(const Items& items, Hashes& output) const
+        noexcept;
+    /// Replaces the contents of output with the reduced hash of every item
+    OPENTXS_EXPORT void HashToRange(
+        const std::vector<OTData>& items,
+        const std::uint64_t range,
+        std::vector<std::uint64_t>& output) const noexcept;
+
+    /// Throws std::runtime_error if key is not 16 bytes
+    OPENTXS_EXPORT SipHasher(const ReadView key) noexcept(false);
+
+private:
+    std::uint64_t k0_;
+    std::uint64_t k1_;
+
+    SipHasher() = delete;
+};
+
 struct GCS {
+    /// Deduplicated set of elements to be matched against many filters
+    using Targets = std::vector<OTData>;
+    /// Working memory for Match which may be reused across filters
+    using Scratch = std::vector<std::uint64_t>;
+
     virtual OTData Encode() const noexcept = 0;
     virtual OTData Hash() const noexcept = 0;
+    /** Test a prepared target set against the filter
+     *
+     *  The filter is decoded at most once per call. The contents of scratch
+     *  are overwritten, but its capacity is retained so that a caller
+     *  matching the same targets against a range of filters does not
+     *  allocate per filter.
+     */
+    virtual bool Match(const Targets& targets, Scratch& scratch) const
+        noexcept = 0;
     virtual proto::GCS Serialize() const noexcept = 0;
     virtual bool Test(const Data& target) const noexcept = 0;
     virtual bool Test(const std::vector<OTData>& targets) const noexcept = 0;
@@ -107,6 +185,11 @@ auto Deserialize(const Type chain, const std::uint8_t type) noexcept
 auto Deserialize(const api::Core& api, const ReadView bytes) noexcept
     -> block::Position;
 auto DisplayString(const Type type) noexcept -> std::string;
+// Bitcoin double SHA-256 of the concatenated segments. This is computed
+// in-tree rather than by the crypto provider since block verification
+// hashes a large number of small messages.
+OPENTXS_EXPORT auto DoubleSha256(
+    const std::initializer_list<ReadView> segments) noexcept -> Sha256Digest;
 OPENTXS_EXPORT auto BlockHashToFilterKey(const ReadView hash) noexcept
     -> std::array<std::byte, 16>;
 OPENTXS_EXPORT auto FilterHashToHeader(
@@ -120,8 +203,22 @@ OPENTXS_EXPORT auto FilterToHeader(
     const api::Core& api,
     const ReadView filter,
     const ReadView previous = {}) noexcept -> OTData;
+// Sorts and deduplicates elements for use with GCS::Match
+OPENTXS_EXPORT auto GCSTargets(const std::vector<OTData>& elements) noexcept
+    -> GCS::Targets;
 OPENTXS_EXPORT auto Grind(const std::function<void()> function) noexcept
     -> void;
+/// Returns nothing for an empty or malleated tree. Each level of a large
+/// tree is hashed across all cores, several nodes at a time per core.
+OPENTXS_EXPORT auto MerkleRoot(std::vector<Sha256Digest> leaves) noexcept
+    -> std::optional<Sha256Digest>;
+// Splits [0, count) into contiguous ranges of at least minimum elements
+// and runs job on each range concurrently
+OPENTXS_EXPORT auto Parallel(
+    const std::size_t count,
+    const std::size_t minimum,
+    const std::function<void(std::size_t, std::size_t)>& job) noexcept
+    -> void;
 auto Serialize(const Type chain, const filter::Type type) noexcept(false)
     -> std::uint8_t;
 auto Serialize(const block::Position& position) noexcept -> Space;
@@ -8,6 +8,128 @@
 #include "Internal.hpp"
 
 #include "opentxs/blockchain/block/bitcoin/Header.hpp"
+#include "opentxs/blockchain/block/Header.hpp"
+#include "opentxs/Bytes.hpp"
+
+#include <boost/endian/buffers.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace opentxs::blockchain::block::internal
+{
+/// Fixed size database record for a block header and its chain metadata
+/**
+ *  Every field has an alignment of one so records can be read in place from
+ *  the database memory map. Work values are stored as 256 bit big endian
+ *  integers and may be compared with memcmp.
+ */
+struct FlatHeader {
+    using Work = std::array<std::uint8_t, 32>;
+
+    std::array<std::uint8_t, 80> raw_;
+    boost::endian::little_uint32_buf_t type_;
+    boost::endian::little_int64_buf_t height_;
+    boost::endian::little_uint32_buf_t status_;
+    boost::endian::little_uint32_buf_t inherit_status_;
+    Work work_;
+    Work inherit_work_;
+    Work cumulative_work_;
+
+    FlatHeader() noexcept;
+};
+
+/// Non-owning accessor for a FlatHeader record
+/**
+ *  When constructed from a database callback the view is only valid for the
+ *  duration of that callback.
+ */
+class FlatHeaderView
+{
+public:
+    using Status = block::Header::Status;
+
+    /// True if Raw() holds a header in the 80 byte bitcoin layout
+    auto BitcoinFormat() const noexcept -> bool
+    {
+        switch (Type()) {
+            case blockchain::Type::Bitcoin:
+            case blockchain::Type::Bitcoin_testnet3:
+            case blockchain::Type::BitcoinCash:
+            case blockchain::Type::BitcoinCash_testnet3: {
+                return true;
+            }
+            default: {
+                return false;
+            }
+        }
+    }
+    auto CumulativeWork() const noexcept -> ReadView
+    {
+        return view(record_->cumulative_work_);
+    }
+    auto Height() const noexcept -> block::Height
+    {
+        return record_->height_.value();
+    }
+    auto InheritedState() const noexcept -> Status
+    {
+        return static_cast<Status>(record_->inherit_status_.value());
+    }
+    auto InheritWork() const noexcept -> ReadView
+    {
+        return view(record_->inherit_work_);
+    }
+    auto LocalState() const noexcept -> Status
+    {
+        return static_cast<Status>(record_->status_.value());
+    }
+    auto ParentHash() const noexcept -> ReadView
+    {
+        return {reinterpret_cast<const char*>(record_->raw_.data()) + 4, 32};
+    }
+    auto Raw() const noexcept -> ReadView { return view(record_->raw_); }
+    auto Type() const noexcept -> blockchain::Type
+    {
+        return static_cast<blockchain::Type>(record_->type_.value());
+    }
+    auto Work() const noexcept -> ReadView { return view(record_->work_); }
+
+    /// Returns a null view if the input is not a valid record
+    static auto Parse(const ReadView in) noexcept -> FlatHeaderView
+    {
+        if (sizeof(FlatHeader) != in.size()) { return FlatHeaderView{}; }
+
+        return FlatHeaderView{reinterpret_cast<const FlatHeader*>(in.data())};
+    }
+
+    operator bool() const noexcept { return nullptr != record_; }
+
+    FlatHeaderView() noexcept
+        : record_(nullptr)
+    {
+    }
+    FlatHeaderView(const FlatHeader* record) noexcept
+        : record_(record)
+    {
+    }
+
+private:
+    const FlatHeader* record_;
+
+    template <std::size_t N>
+    static auto view(const std::array<std::uint8_t, N>& in) noexcept
+        -> ReadView
+    {
+        return {reinterpret_cast<const char*>(in.data()), in.size()};
+    }
+};
+
+/// Copies the header and its metadata into a FlatHeader record
+OPENTXS_EXPORT auto Flatten(const block::Header& header) noexcept
+    -> FlatHeader;
+}  // namespace opentxs::blockchain::block::internal
 
 namespace opentxs::blockchain::block::bitcoin::internal
 {
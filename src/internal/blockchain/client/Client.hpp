@@ -20,8 +20,14 @@
 #include "internal/core/Core.hpp"
 
 #include <boost/asio.hpp>
+#include <boost/endian/buffers.hpp>
+#include <boost/lockfree/stack.hpp>
 #include <boost/thread/thread.hpp>
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <future>
 #include <map>
 #include <memory>
@@ -82,6 +88,10 @@ struct FilterDatabase {
     virtual bool HaveFilterHeader(
         const filter::Type type,
         const block::Hash& block) const noexcept = 0;
+    // Returns null pointer if the filter does not exist
+    virtual std::unique_ptr<const blockchain::internal::GCS> LoadFilter(
+        const filter::Type type,
+        const ReadView block) const noexcept = 0;
     virtual Hash LoadFilterHash(const filter::Type type, const ReadView block)
         const noexcept = 0;
     virtual Hash LoadFilterHeader(const filter::Type type, const ReadView block)
@@ -114,6 +124,27 @@ struct FilterOracle {
         const ReadView previousHeader,
         const std::vector<ReadView> hashes) const noexcept = 0;
     virtual void CheckBlocks() const noexcept = 0;
+    virtual block::Position FilterHeaderTip(const filter::Type type) const
+        noexcept = 0;
+    virtual block::Position FilterTip(const filter::Type type) const
+        noexcept = 0;
+    /// Stores the filter headers contained in a snapshot
+    /**
+     *  The block headers in the snapshot must already be in the best chain.
+     */
+    virtual bool ImportSnapshot(const Snapshot& snapshot) const noexcept = 0;
+    /** Test a set of elements against every stored filter in a height range
+     *
+     *  Returns the best chain positions of the blocks whose filters match.
+     *  Decode those blocks with the predicate returned by
+     *  transaction::bitcoin::BlockView::Match for the same elements so only
+     *  the matching transactions are materialized.
+     */
+    virtual std::vector<block::Position> Match(
+        const filter::Type type,
+        const std::vector<OTData>& elements,
+        const block::Height start,
+        const block::Height stop) const noexcept = 0;
 
     virtual void Start() noexcept = 0;
     virtual std::shared_future<void> Shutdown() noexcept = 0;
@@ -122,10 +153,16 @@ struct FilterOracle {
 };
 
 struct HeaderOracle : virtual public opentxs::blockchain::client::HeaderOracle {
+    /// Appends the block headers in a snapshot to the best chain
+    virtual bool ImportSnapshot(const Snapshot& snapshot) noexcept = 0;
+
     virtual ~HeaderOracle() = default;
 };
 
 struct HeaderDatabase {
+    using HeaderView =
+        std::function<void(const block::internal::FlatHeaderView&)>;
+
     virtual bool ApplyUpdate(const client::UpdateTransaction& update) const
         noexcept = 0;
     // Throws std::out_of_range if no block at that position
@@ -138,10 +175,18 @@ struct HeaderDatabase {
         noexcept = 0;
     virtual bool HaveCheckpoint() const noexcept = 0;
     virtual bool HeaderExists(const block::Hash& hash) const noexcept = 0;
+    virtual bool IsBestBlock(
+        const block::Height position,
+        const ReadView hash) const noexcept = 0;
     virtual bool IsSibling(const block::Hash& hash) const noexcept = 0;
     // Throws std::out_of_range if the header does not exist
     virtual std::unique_ptr<block::Header> LoadHeader(
         const block::Hash& hash) const noexcept(false) = 0;
+    // The view passed to the callback points into the database and is only
+    // valid until the callback returns. Returns false if the header does not
+    // exist.
+    virtual bool LoadHeaderView(const ReadView hash, const HeaderView cb) const
+        noexcept = 0;
     virtual std::vector<block::pHash> RecentHashes() const noexcept = 0;
     virtual Hashes SiblingHashes() const noexcept = 0;
     // Returns null pointer if the header does not exist
@@ -151,6 +196,56 @@ struct HeaderDatabase {
     virtual ~HeaderDatabase() = default;
 };
 
+// Lock-free cache of reusable receive buffers in power of two size classes
+//
+// Buffers are adopted by zmq frames without copying. The release callback of
+// the frame returns the buffer to the pool from whichever thread destroys the
+// last reference, so every outstanding buffer keeps the pool alive.
+class ReceiveBuffers final
+    : public std::enable_shared_from_this<ReceiveBuffers>
+{
+public:
+    struct Buffer {
+        std::shared_ptr<ReceiveBuffers> pool_;
+        const std::size_t class_;
+        std::unique_ptr<std::byte[]> data_;
+
+        Buffer(const std::size_t sizeClass, const std::size_t bytes) noexcept;
+    };
+    struct Deleter {
+        auto operator()(Buffer* buffer) const noexcept -> void;
+    };
+
+    using Pointer = std::unique_ptr<Buffer, Deleter>;
+
+    static auto Factory() noexcept -> std::shared_ptr<ReceiveBuffers>;
+    static auto Release(void* data, void* hint) noexcept -> void;
+
+    auto Get(const std::size_t bytes) noexcept -> Pointer;
+
+    ~ReceiveBuffers();
+
+private:
+    using Stack = boost::lockfree::stack<Buffer*>;
+
+    static constexpr std::size_t min_class_{6};
+    static constexpr std::size_t max_class_{25};
+    static constexpr std::size_t max_cached_{64};
+    static constexpr std::size_t cache_limit_{8 * 1024 * 1024};
+
+    std::vector<std::unique_ptr<Stack>> free_;
+
+    static auto size_class(const std::size_t bytes) noexcept -> std::size_t;
+
+    auto put(Buffer* buffer) noexcept -> void;
+
+    ReceiveBuffers() noexcept;
+    ReceiveBuffers(const ReceiveBuffers&) = delete;
+    ReceiveBuffers(ReceiveBuffers&&) = delete;
+    ReceiveBuffers& operator=(const ReceiveBuffers&) = delete;
+    ReceiveBuffers& operator=(ReceiveBuffers&&) = delete;
+};
+
 struct IO {
     using tcp = boost::asio::ip::tcp;
 
@@ -174,19 +269,13 @@ struct IO {
 
 private:
     const api::Core& api_;
-    mutable std::mutex lock_;
     OTZMQListenCallback cb_;
     OTZMQRouterSocket socket_;
-    mutable int next_buffer_;
-    mutable std::map<int, Space> buffers_;
+    const std::shared_ptr<ReceiveBuffers> buffers_;
     mutable boost::asio::io_context context_;
     std::unique_ptr<boost::asio::io_context::work> work_;
     boost::thread_group thread_pool_;
 
-    auto clear_buffer(const int id) const noexcept -> void;
-    auto get_buffer(const std::size_t bytes) const noexcept
-        -> std::pair<int, WritableView>;
-
     auto callback(zmq::Message& in) noexcept -> void;
 
     IO() = delete;
@@ -206,6 +295,7 @@ struct Network : virtual public opentxs::blockchain::Network {
     };
 
     virtual Type Chain() const noexcept = 0;
+    virtual const internal::FilterOracle& FilterOracle() const noexcept = 0;
     virtual const client::HeaderOracle& HeaderOracle() const noexcept = 0;
     virtual bool IsSynchronized() const noexcept = 0;
     virtual void RequestFilterHeaders(
@@ -229,6 +319,16 @@ struct Network : virtual public opentxs::blockchain::Network {
     virtual ~Network() = default;
 };
 
+/// Connection quality observed for a peer address during one session
+struct PeerScore {
+    std::uint32_t handshakes_{0};
+    std::uint32_t failures_{0};
+    std::uint32_t misbehavior_{0};
+    /// Round trip time in milliseconds, or zero if not measured
+    std::uint32_t rtt_{0};
+    std::uint64_t bytes_{0};
+};
+
 struct PeerDatabase {
     using Address = std::unique_ptr<p2p::internal::Address>;
     using Protocol = p2p::Protocol;
@@ -236,11 +336,16 @@ struct PeerDatabase {
     using Type = p2p::Network;
 
     virtual bool AddOrUpdate(Address address) const noexcept = 0;
+    /// Returns the highest scoring peer which is not banned or excluded
     virtual Address Get(
         const Protocol protocol,
         const std::set<Type> onNetworks,
-        const std::set<Service> withServices) const noexcept = 0;
+        const std::set<Service> withServices,
+        const std::set<OTIdentifier>& exclude) const noexcept = 0;
     virtual bool Import(std::vector<Address> peers) const noexcept = 0;
+    /// Merge the results of a connection into the stored score of a peer
+    virtual bool Score(const Identifier& address, const PeerScore& session)
+        const noexcept = 0;
 
     virtual ~PeerDatabase() = default;
 };
@@ -262,12 +367,25 @@ struct PeerManager {
         Shutdown = OT_ZMQ_SHUTDOWN_SIGNAL,
     };
 
+    /// Register a peer which is able to serve the specified download task
+    virtual void AddDownloader(const int peer, const Task type) const
+        noexcept = 0;
     virtual bool AddPeer(const p2p::Address& address) const noexcept = 0;
     virtual bool Connect() noexcept = 0;
     virtual const PeerDatabase& Database() const noexcept = 0;
     virtual void Disconnect(const int id) const noexcept = 0;
     virtual std::string Endpoint(const Task type) const noexcept = 0;
     virtual std::size_t GetPeerCount() const noexcept = 0;
+    /// Report download progress for a scheduled task
+    /**
+     *  block is the block hash associated with the received message, which
+     *  completes a unit of work if it matches the unit's stop hash.
+     */
+    virtual void Received(
+        const int peer,
+        const Task type,
+        const block::Hash& block,
+        const std::size_t bytes) const noexcept = 0;
     virtual void RequestFilterHeaders(
         const filter::Type type,
         const block::Height start,
@@ -284,6 +402,47 @@ struct PeerManager {
 
     virtual ~PeerManager() = default;
 };
+
+/// Fixed layout of the first bytes of a header snapshot file
+/**
+ *  A snapshot file consists of a SnapshotHeader followed by count_
+ *  SnapshotRecord entries for consecutive best chain heights beginning at
+ *  start_. All multi-byte integers are little endian.
+ */
+struct SnapshotHeader {
+    std::array<std::uint8_t, 8> magic_;
+    boost::endian::little_uint32_buf_t chain_;
+    boost::endian::little_uint32_buf_t filter_;
+    boost::endian::little_int64_buf_t start_;
+    boost::endian::little_uint64_buf_t count_;
+};
+
+/// Serialized block header with its filter hash and filter header
+struct SnapshotRecord {
+    std::array<std::uint8_t, 80> header_;
+    std::array<std::uint8_t, 32> filter_hash_;
+    std::array<std::uint8_t, 32> filter_header_;
+};
+
+/// Read-only view of a memory mapped snapshot file
+/**
+ *  The contents of a snapshot are not trusted. Consumers must verify proof
+ *  of work, hash chain linkage, and checkpoints before importing records.
+ */
+struct Snapshot {
+    static constexpr auto magic_ = std::array<std::uint8_t, 8>{
+        {'o', 't', 's', 'n', 'a', 'p', '0', '1'}};
+
+    virtual blockchain::Type Chain() const noexcept = 0;
+    virtual std::size_t Count() const noexcept = 0;
+    virtual filter::Type FilterType() const noexcept = 0;
+    virtual block::Height Height(const std::size_t index) const noexcept = 0;
+    virtual const SnapshotRecord& Record(const std::size_t index) const
+        noexcept = 0;
+    virtual block::Height Start() const noexcept = 0;
+
+    virtual ~Snapshot() = default;
+};
 #endif  // OT_BLOCKCHAIN
 
 struct Wallet {
@@ -36,6 +36,7 @@ struct Address : virtual public p2p::Address {
 struct Peer : virtual public p2p::Peer {
     virtual OTIdentifier AddressID() const noexcept = 0;
     virtual std::shared_future<void> Shutdown() noexcept = 0;
+    virtual void Submit(network::zeromq::Message& work) noexcept = 0;
 
     virtual ~Peer() override = default;
 };
@@ -29,6 +29,17 @@ network::zeromq::Frame* Factory::ZMQFrame(
     return new ReturnType(data, size);
 }
 
+network::zeromq::Frame* Factory::ZMQFrame(
+    void* data,
+    const std::size_t size,
+    void (*cleanup)(void*, void*),
+    void* hint)
+{
+    using ReturnType = network::zeromq::implementation::Frame;
+
+    return new ReturnType(data, size, cleanup, hint);
+}
+
 network::zeromq::Frame* Factory::ZMQFrame(const ProtobufType& data)
 {
     using ReturnType = network::zeromq::implementation::Frame;
@@ -68,6 +79,19 @@ Frame::Frame(const void* data, const std::size_t bytes) noexcept
     std::memcpy(zmq_msg_data(&message_), data, zmq_msg_size(&message_));
 }
 
+Frame::Frame(
+    void* data,
+    const std::size_t bytes,
+    zmq_free_fn* cleanup,
+    void* hint) noexcept
+    : zeromq::Frame()
+    , message_()
+{
+    const auto init = zmq_msg_init_data(&message_, data, bytes, cleanup, hint);
+
+    OT_ASSERT(0 == init);
+}
+
 Frame::operator std::string() const noexcept
 {
     return std::string{Bytes()};
@@ -82,7 +106,15 @@ auto Frame::Bytes() const noexcept -> ReadView
 
 auto Frame::clone() const noexcept -> Frame*
 {
-    return new Frame(zmq_msg_data(&message_), zmq_msg_size(&message_));
+    auto* output = new Frame();
+
+    // Frame content is immutable so zmq can share it by reference count
+    // instead of duplicating large payloads
+    const auto copy = zmq_msg_copy(&output->message_, &message_);
+
+    OT_ASSERT(0 == copy);
+
+    return output;
 }
 
 Frame::~Frame() { zmq_msg_close(&message_); }
@@ -38,6 +38,11 @@ private:
     explicit Frame(const ProtobufType& input) noexcept;
     explicit Frame(const std::size_t bytes) noexcept;
     Frame(const void* data, const std::size_t bytes) noexcept;
+    Frame(
+        void* data,
+        const std::size_t bytes,
+        zmq_free_fn* cleanup,
+        void* hint) noexcept;
     Frame(const Frame&) = delete;
     Frame(Frame&&) = delete;
     Frame& operator=(Frame&&) = delete;
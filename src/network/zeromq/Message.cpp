@@ -86,6 +86,17 @@ Frame& Message::AddFrame(const void* input, const std::size_t size)
     return messages_.back().get();
 }
 
+Frame& Message::AddFrame(
+    void* input,
+    const std::size_t size,
+    FrameCleanup cleanup,
+    void* hint)
+{
+    messages_.emplace_back(Factory::ZMQFrame(input, size, cleanup, hint));
+
+    return messages_.back().get();
+}
+
 Frame& Message::AddFrame(const ProtobufType& input)
 {
     messages_.emplace_back(Factory::ZMQFrame(input));
@@ -93,6 +104,13 @@ Frame& Message::AddFrame(const ProtobufType& input)
     return messages_.back().get();
 }
 
+Frame& Message::AddFrame(const Frame& input)
+{
+    messages_.emplace_back(input);
+
+    return messages_.back().get();
+}
+
 const Frame& Message::at(const std::size_t index) const
 {
     OT_ASSERT(messages_.size() > index);
@@ -27,7 +27,13 @@ public:
 
     Frame& AddFrame() final;
     Frame& AddFrame(const ProtobufType& input) final;
+    Frame& AddFrame(const Frame& input) final;
     Frame& AddFrame(const void* input, const std::size_t size) final;
+    Frame& AddFrame(
+        void* input,
+        const std::size_t size,
+        FrameCleanup cleanup,
+        void* hint) final;
     Frame& at(const std::size_t index) final;
 
     void EnsureDelimiter() final;
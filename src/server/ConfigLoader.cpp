@@ -174,6 +174,23 @@ bool ConfigLoader::load(
             static_cast<std::int32_t>(lValue));
     }
 
+    {
+        const char* szComment = "; worker_threads is the number of threads "
+                                "executing client requests. 0 uses one "
+                                "thread per core.\n";
+
+        bool bIsNewKey = false;
+        std::int64_t lValue = 0;
+        config.CheckSet_long(
+            String::Factory("heartbeat"),
+            String::Factory("worker_threads"),
+            0,
+            lValue,
+            bIsNewKey,
+            String::Factory(szComment));
+        ServerSettings::SetWorkerThreads(static_cast<std::int32_t>(lValue));
+    }
+
     // PERMISSIONS
 
     {
@@ -32,6 +32,7 @@
 
 #include <irrxml/irrXML.hpp>
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstdint>
 #include <memory>
@@ -56,9 +57,12 @@ bool MainFile::SaveMainFileToString(String& strMainFile)
     tag.add_attribute("version", "3.0");
     tag.add_attribute("notaryID", server_.GetServerID().str());
     tag.add_attribute("serverNymID", server_.GetServerNym().ID().str());
+    // Everything below the reservation ceiling may already have been issued
+    const auto& transactor = server_.GetTransactor();
     tag.add_attribute(
         "transactionNum",
-        std::to_string(server_.GetTransactor().transactionNumber()));
+        std::to_string(std::max(
+            transactor.transactionNumber_, transactor.reserved_)));
 
     // Save the basket account information
 
@@ -306,6 +310,8 @@ bool MainFile::LoadMainFile(bool bReadOnly)
                             xml->getAttributeValue("transactionNum"));
                         server_.GetTransactor().transactionNumber(
                             strTransactionNumber->ToLong());
+                        server_.GetTransactor().loadNumberJournal(
+                            bReadOnly);
                         LogNormal("Loading Open Transactions server").Flush();
                         LogNormal("* File version: ")(version_).Flush();
                         LogNormal("* Last Issued Transaction Number: ")(
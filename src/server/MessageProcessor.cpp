@@ -14,13 +14,15 @@
 #include "opentxs/api/Wallet.hpp"
 #include "opentxs/core/Armored.hpp"
 #include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Item.hpp"
+#include "opentxs/core/Ledger.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/Message.hpp"
+#include "opentxs/core/OTStorage.hpp"
+#include "opentxs/core/OTTransaction.hpp"
 #include "opentxs/core/String.hpp"
 #include "opentxs/identity/Nym.hpp"
-#include "opentxs/network/zeromq/socket/Dealer.hpp"
 #include "opentxs/network/zeromq/socket/Pull.hpp"
-#include "opentxs/network/zeromq/socket/Reply.hpp"
 #include "opentxs/network/zeromq/socket/Router.hpp"
 #include "opentxs/network/zeromq/Context.hpp"
 #include "opentxs/network/zeromq/FrameIterator.hpp"
@@ -28,17 +30,20 @@
 #include "opentxs/network/zeromq/Frame.hpp"
 #include "opentxs/network/zeromq/ListenCallback.hpp"
 #include "opentxs/network/zeromq/Message.hpp"
-#include "opentxs/network/zeromq/ReplyCallback.hpp"
 #include "opentxs/otx/Reply.hpp"
 #include "opentxs/otx/Request.hpp"
 #include "opentxs/Proto.tpp"
 
 #include "internal/api/Api.hpp"
+#include "RequestScheduler.hpp"
 #include "Server.hpp"
+#include "ServerSettings.hpp"
 #include "UserCommandProcessor.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <sys/types.h>
+#include <memory>
 #include <ostream>
 #include <string>
 
@@ -64,20 +69,6 @@ MessageProcessor::MessageProcessor(
     , frontend_socket_(server.API().ZeroMQ().RouterSocket(
           frontend_callback_,
           zmq::socket::Socket::Direction::Bind))
-    , backend_callback_(zmq::ReplyCallback::Factory(
-          [=](const zmq::Message& incoming) -> OTZMQMessage {
-              return this->process_backend(incoming);
-          }))
-    , backend_socket_(server.API().ZeroMQ().ReplySocket(
-          backend_callback_,
-          zmq::socket::Socket::Direction::Bind))
-    , internal_callback_(zmq::ListenCallback::Factory(
-          [=](const zmq::Message& incoming) -> void {
-              this->process_internal(incoming);
-          }))
-    , internal_socket_(server.API().ZeroMQ().DealerSocket(
-          internal_callback_,
-          zmq::socket::Socket::Direction::Connect))
     , notification_callback_(zmq::ListenCallback::Factory(
           [=](const zmq::Message& incoming) -> void {
               this->process_notification(incoming);
@@ -85,18 +76,15 @@ MessageProcessor::MessageProcessor(
     , notification_socket_(server.API().ZeroMQ().PullSocket(
           notification_callback_,
           zmq::socket::Socket::Direction::Bind))
+    , scheduler_()
     , thread_()
-    , internal_endpoint_(
-          std::string("inproc://opentxs/notary/") + Identifier::Random()->str())
     , counter_lock_()
     , drop_incoming_(0)
     , drop_outgoing_(0)
     , active_connections_()
     , connection_map_lock_()
 {
-    auto bound = backend_socket_->Start(internal_endpoint_);
-    bound &= internal_socket_->Start(internal_endpoint_);
-    bound &= notification_socket_->Start(
+    const auto bound = notification_socket_->Start(
         server_.API().Endpoints().InternalPushNotification());
 
     OT_ASSERT(bound);
@@ -121,10 +109,9 @@ void MessageProcessor::associate_connection(
 
 void MessageProcessor::cleanup()
 {
+    scheduler_.Stop();
     frontend_socket_->Close();
     notification_socket_->Close();
-    internal_socket_->Close();
-    backend_socket_->Close();
 
     if (thread_.joinable()) { thread_.join(); }
 }
@@ -196,41 +183,48 @@ void MessageProcessor::init(
     LogNormal("Bound to endpoint: ")(endpoint.str()).Flush();
 }
 
-void MessageProcessor::run()
+std::unique_ptr<Message> MessageProcessor::parse_message(
+    const std::string& messageString) const
 {
-    while (running_) {
-        // timeout is the time left until the next cron should execute.
-        const auto timeout = server_.ComputeTimeout();
+    if (messageString.size() < 1) { return {}; }
 
-        if (timeout.count() <= 0) {
-            // ProcessCron and process_backend must not run simultaneously
-            Lock lock(lock_);
-            server_.ProcessCron();
-        }
+    auto armored = Armored::Factory();
+    armored->MemSet(messageString.data(), messageString.size());
+    auto serialized = String::Factory();
+    armored->GetString(serialized);
+    auto request{server_.API().Factory().Message()};
 
-        Sleep(std::chrono::milliseconds(50));
+    if (false == serialized->Exists()) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Empty serialized request.")
+            .Flush();
+
+        return {};
     }
-}
 
-OTZMQMessage MessageProcessor::process_backend(const zmq::Message& incoming)
-{
-    // ProcessCron and process_backend must not run simultaneously
-    Lock lock(lock_);
-    std::string reply{};
+    if (false == request->LoadContractFromString(serialized)) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to deserialized request.")
+            .Flush();
 
-    std::string messageString{};
-    if (0 < incoming.Body().size()) {
-        messageString = *incoming.Body().begin();
+        return {};
     }
 
-    bool error = process_message(messageString, reply);
+    return request;
+}
 
-    if (error) { reply = ""; }
+void MessageProcessor::run()
+{
+    while (running_) {
+        // timeout is the time left until the next cron should execute.
+        const auto timeout = server_.ComputeTimeout();
 
-    auto output = server_.API().ZeroMQ().ReplyMessage(incoming);
-    output->AddFrame(reply);
+        if (timeout.count() <= 0) {
+            // ProcessCron may modify any nym or account
+            scheduler_.RunExclusive(
+                [this]() -> void { server_.ProcessCron(); });
+        }
 
-    return output;
+        Sleep(std::chrono::milliseconds(50));
+    }
 }
 
 bool MessageProcessor::process_command(
@@ -284,82 +278,86 @@ void MessageProcessor::process_frontend(const zmq::Message& incoming)
     }
 }
 
-void MessageProcessor::process_internal(const zmq::Message& incoming)
-{
-    Lock lock(counter_lock_);
-
-    if (0 < drop_outgoing_) {
-        LogNormal(OT_METHOD)(__FUNCTION__)(
-            ": Dropping outgoing message for testing.")
-            .Flush();
-        --drop_outgoing_;
-    } else {
-        lock.unlock();
-        OTZMQMessage reply{incoming};
-        const auto sent = frontend_socket_->Send(reply);
-
-        if (sent) {
-            LogTrace(OT_METHOD)(__FUNCTION__)(": Reply message delivered.")
-                .Flush();
-        } else {
-            LogOutput(OT_METHOD)(__FUNCTION__)(
-                ": Failed to send reply message.")
-                .Flush();
-        }
-    }
-}
-
 void MessageProcessor::process_legacy(
     const Data& id,
     const network::zeromq::Message& incoming)
 {
     LogTrace(OT_METHOD)(__FUNCTION__)(": Processing request via ")(id.asHex())
         .Flush();
-    OTZMQMessage request{incoming};
-    internal_socket_->Send(request);
-}
-
-bool MessageProcessor::process_message(
-    const std::string& messageString,
-    std::string& reply)
-{
-    if (messageString.size() < 1) { return true; }
+    std::string messageString{};
 
-    auto armored = Armored::Factory();
-    armored->MemSet(messageString.data(), messageString.size());
-    auto serialized = String::Factory();
-    armored->GetString(serialized);
-    auto request{server_.API().Factory().Message()};
+    if (0 < incoming.Body().size()) {
+        messageString = *incoming.Body().begin();
+    }
 
-    if (false == serialized->Exists()) {
-        LogOutput(OT_METHOD)(__FUNCTION__)(": Empty serialized request.")
-            .Flush();
+    const std::shared_ptr<const Message> request{parse_message(messageString)};
+    const OTZMQMessage message{incoming};
+    // The ledger in a transaction request is parsed here to find the
+    // accounts it touches and then handed to the job so it is parsed once
+    auto ledger = std::shared_ptr<Ledger>{};
+    auto resources = RequestScheduler::Resources{};
+    const auto exclusive =
+        bool(request) &&
+        (false == request_resources(*request, resources, ledger));
+    const auto job = [this, request, message, ledger]() -> void {
+        // Files written while processing the request are moved into place
+        // together by the barrier below
+        OTDB::Stage();
+        std::string reply{};
+        const bool error = (false == bool(request)) ||
+                           process_message(*request, ledger, reply);
+
+        if (error) { reply = ""; }
+
+        // The reply must not be sent before the files it describes are on
+        // disk. Concurrent requests reaching this point share one barrier.
+        // A failed request may still have changed stored state, so every
+        // request waits for it.
+        if (false == OTDB::Sync()) {
+            // The request has already been applied in memory. Replying with
+            // an error would tell the client it failed although it may
+            // survive a restart, and replying with success could acknowledge
+            // state which does not. Neither is safe, so the notary stops.
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Unable to make the processed request durable.")
+                .Flush();
+            OT_FAIL;
+        }
 
-        return true;
-    }
+        auto output = server_.API().ZeroMQ().ReplyMessage(message);
+        output->AddFrame(reply);
+        send_reply(output);
+    };
 
-    if (false == request->LoadContractFromString(serialized)) {
-        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to deserialized request.")
-            .Flush();
+    if (false == bool(request)) {
+        job();
 
-        return true;
+        return;
     }
 
+    scheduler_.Queue(resources, exclusive, job);
+}
+
+bool MessageProcessor::process_message(
+    const Message& request,
+    const std::shared_ptr<Ledger>& ledger,
+    std::string& reply)
+{
     auto replymsg{server_.API().Factory().Message()};
 
     OT_ASSERT(false != bool(replymsg));
 
-    const bool processed =
-        server_.CommandProcessor().ProcessUserCommand(*request, *replymsg);
+    const bool processed = server_.CommandProcessor().ProcessUserCommand(
+        request, *replymsg, ledger);
 
     if (false == processed) {
         LogDetail(OT_METHOD)(__FUNCTION__)(": Failed to process user command ")(
-            request->m_strCommand)
+            request.m_strCommand)
             .Flush();
-        LogVerbose(OT_METHOD)(__FUNCTION__)(String::Factory(*request)).Flush();
+        LogVerbose(OT_METHOD)(__FUNCTION__)(String::Factory(request)).Flush();
     } else {
         LogDetail(OT_METHOD)(__FUNCTION__)(
-            ": Successfully processed user command ")(request->m_strCommand)
+            ": Successfully processed user command ")(request.m_strCommand)
             .Flush();
     }
 
@@ -480,10 +478,161 @@ OTData MessageProcessor::query_connection(const identifier::Nym& nymID)
     return it->second;
 }
 
+bool MessageProcessor::request_resources(
+    const Message& request,
+    RequestScheduler::Resources& resources,
+    std::shared_ptr<Ledger>& ledger) const
+{
+    const std::string nymID{request.m_strNymID->Get()};
+
+    if (nymID.empty()) { return false; }
+
+    resources.emplace(nymID);
+
+    switch (Message::Type(request.m_strCommand->Get())) {
+        case MessageType::pingNotary:
+        case MessageType::getRequestNumber:
+        case MessageType::getTransactionNumbers:
+        case MessageType::checkNym:
+        case MessageType::getNymbox:
+        case MessageType::processNymbox:
+        case MessageType::getInstrumentDefinition:
+        case MessageType::getMint: {
+
+            return true;
+        }
+        case MessageType::sendNymMessage: {
+            const std::string recipient{request.m_strNymID2->Get()};
+
+            if (recipient.empty()) { return false; }
+
+            resources.emplace(recipient);
+
+            return true;
+        }
+        case MessageType::getAccountData:
+        case MessageType::getBoxReceipt: {
+            const std::string accountID{request.m_strAcctID->Get()};
+
+            if (accountID.empty()) { return false; }
+
+            resources.emplace(accountID);
+
+            return true;
+        }
+        case MessageType::notarizeTransaction:
+        case MessageType::processInbox: {
+
+            return transaction_resources(request, resources, ledger);
+        }
+        default: {
+            // Anything which may touch a resource not named in the message
+            // runs exclusively
+            return false;
+        }
+    }
+}
+
+void MessageProcessor::send_reply(const zmq::Message& reply)
+{
+    Lock lock(counter_lock_);
+
+    if (0 < drop_outgoing_) {
+        LogNormal(OT_METHOD)(__FUNCTION__)(
+            ": Dropping outgoing message for testing.")
+            .Flush();
+        --drop_outgoing_;
+    } else {
+        lock.unlock();
+        OTZMQMessage message{reply};
+        const auto sent = frontend_socket_->Send(message);
+
+        if (sent) {
+            LogTrace(OT_METHOD)(__FUNCTION__)(": Reply message delivered.")
+                .Flush();
+        } else {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Failed to send reply message.")
+                .Flush();
+        }
+    }
+}
+
 void MessageProcessor::Start()
 {
+    const auto threads = ServerSettings::GetWorkerThreads();
+    scheduler_.Start(static_cast<std::size_t>(std::max(threads, 0)));
     thread_ = std::thread(&MessageProcessor::run, this);
 }
 
+bool MessageProcessor::transaction_resources(
+    const Message& request,
+    RequestScheduler::Resources& resources,
+    std::shared_ptr<Ledger>& ledger) const
+{
+    const auto nymID = identifier::Nym::Factory(request.m_strNymID);
+    const auto accountID = Identifier::Factory(request.m_strAcctID);
+
+    if (accountID->empty()) { return false; }
+
+    resources.emplace(request.m_strAcctID->Get());
+    auto parsed = std::shared_ptr<Ledger>{server_.API().Factory().Ledger(
+        nymID, accountID, server_.GetServerID())};
+
+    OT_ASSERT(parsed);
+
+    if (false ==
+        parsed->LoadLedgerFromString(String::Factory(request.m_ascPayload))) {
+
+        return false;
+    }
+
+    // The worker reuses the ledger even if the request runs exclusively
+    ledger = parsed;
+
+    for (const auto& it : ledger->GetTransactionMap()) {
+        const auto& transaction = it.second;
+
+        if (nullptr == transaction) { return false; }
+
+        const auto type = transaction->GetType();
+
+        if ((transactionType::transfer != type) &&
+            (transactionType::processInbox != type)) {
+
+            return false;
+        }
+
+        for (const auto& item : transaction->GetItemList()) {
+            if (nullptr == item) { return false; }
+
+            switch (item->GetType()) {
+                case itemType::transfer: {
+                    // The destination inbox receives a pending transfer
+                    const auto& destination = item->GetDestinationAcctID();
+
+                    if (destination.empty()) { return false; }
+
+                    resources.emplace(String::Factory(destination)->Get());
+                } break;
+                case itemType::balanceStatement:
+                case itemType::transactionStatement:
+                case itemType::acceptCronReceipt:
+                case itemType::acceptItemReceipt:
+                case itemType::acceptFinalReceipt:
+                case itemType::acceptBasketReceipt: {
+                } break;
+                default: {
+                    // Accepting or rejecting a pending transfer writes to
+                    // the sender's inbox, which is not named in the request
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
 MessageProcessor::~MessageProcessor() { cleanup(); }
 }  // namespace opentxs::server
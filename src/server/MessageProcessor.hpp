@@ -7,19 +7,17 @@
 
 #include "Internal.hpp"
 
-#include "opentxs/core/Lockable.hpp"
 #include "opentxs/core/Flag.hpp"
-#include "opentxs/network/zeromq/socket/Dealer.hpp"
 #include "opentxs/network/zeromq/socket/Socket.hpp"
 #include "opentxs/network/zeromq/socket/Pull.hpp"
 #include "opentxs/network/zeromq/socket/Push.hpp"
-#include "opentxs/network/zeromq/socket/Reply.hpp"
 #include "opentxs/network/zeromq/socket/Router.hpp"
 #include "opentxs/network/zeromq/socket/Sender.tpp"
 #include "opentxs/network/zeromq/ListenCallback.hpp"
-#include "opentxs/network/zeromq/ReplyCallback.hpp"
 #include "opentxs/Proto.hpp"
 
+#include "RequestScheduler.hpp"
+
 #include <atomic>
 #include <memory>
 #include <string>
@@ -27,7 +25,7 @@
 
 namespace opentxs::server
 {
-class MessageProcessor : Lockable
+class MessageProcessor
 {
 public:
     void DropIncoming(const int count) const;
@@ -50,14 +48,10 @@ private:
     const Flag& running_;
     OTZMQListenCallback frontend_callback_;
     OTZMQRouterSocket frontend_socket_;
-    OTZMQReplyCallback backend_callback_;
-    OTZMQReplySocket backend_socket_;
-    OTZMQListenCallback internal_callback_;
-    OTZMQDealerSocket internal_socket_;
     OTZMQListenCallback notification_callback_;
     OTZMQPullSocket notification_socket_;
+    RequestScheduler scheduler_;
     std::thread thread_;
-    const std::string internal_endpoint_;
     mutable std::mutex counter_lock_;
     mutable int drop_incoming_{0};
     mutable int drop_outgoing_{0};
@@ -73,22 +67,34 @@ private:
     void associate_connection(
         const identifier::Nym& nymID,
         const Data& connection);
-    OTZMQMessage process_backend(const network::zeromq::Message& incoming);
     bool process_command(
         const proto::ServerRequest& request,
         identifier::Nym& nymID);
     void process_frontend(const network::zeromq::Message& incoming);
-    void process_internal(const network::zeromq::Message& incoming);
     void process_legacy(
         const Data& id,
         const network::zeromq::Message& incoming);
-    bool process_message(const std::string& messageString, std::string& reply);
+    bool process_message(
+        const Message& request,
+        const std::shared_ptr<Ledger>& ledger,
+        std::string& reply);
     void process_notification(const network::zeromq::Message& incoming);
     void process_proto(
         const Data& id,
         const network::zeromq::Message& incoming);
+    std::unique_ptr<Message> parse_message(
+        const std::string& messageString) const;
     OTData query_connection(const identifier::Nym& nymID);
+    bool request_resources(
+        const Message& request,
+        RequestScheduler::Resources& resources,
+        std::shared_ptr<Ledger>& ledger) const;
     void run();
+    void send_reply(const network::zeromq::Message& reply);
+    bool transaction_resources(
+        const Message& request,
+        RequestScheduler::Resources& resources,
+        std::shared_ptr<Ledger>& ledger) const;
 
     MessageProcessor() = delete;
 };
@@ -0,0 +1,288 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "stdafx.hpp"
+
+#include "NumberJournal.hpp"
+
+#include "opentxs/core/Log.hpp"
+
+#include <boost/endian/buffers.hpp>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+#define OT_METHOD "opentxs::server::NumberJournal::"
+
+namespace be = boost::endian;
+
+namespace opentxs::server
+{
+namespace
+{
+struct Record {
+    be::little_int64_buf_t ceiling_;
+    be::little_uint64_buf_t check_;
+};
+
+static_assert(16 == sizeof(Record), "Unexpected padding");
+
+// Distinguishes a complete record from a partially written one
+constexpr std::uint64_t record_check(const std::int64_t ceiling) noexcept
+{
+    return ~static_cast<std::uint64_t>(ceiling) ^ 0x4f544e554d4a524eULL;
+}
+}  // namespace
+
+NumberJournal::NumberJournal() noexcept
+    : path_()
+    , fd_(-1)
+    , read_only_(false)
+    , corrupt_(false)
+    , records_(0)
+    , highest_(0)
+{
+}
+
+bool NumberJournal::Append(const TransactionNumber ceiling) noexcept
+{
+#ifdef _WIN32
+    return false;
+#else
+    if ((false == IsOpen()) || read_only_) { return false; }
+
+    if (false == write(records_, ceiling)) {
+        // Never leave a partial record in front of the next append. If that
+        // is not possible stop using the journal entirely.
+        if (false == truncate(records_)) { close(); }
+
+        return false;
+    }
+
+    ++records_;
+    highest_ = std::max(highest_, ceiling);
+
+    return true;
+#endif
+}
+
+void NumberJournal::close() noexcept
+{
+#ifndef _WIN32
+    if (IsOpen()) { ::close(fd_); }
+#endif
+
+    fd_ = -1;
+    records_ = 0;
+}
+
+bool NumberJournal::Open(
+    const std::string& path,
+    const bool readOnly,
+    TransactionNumber& highest) noexcept
+{
+    highest = 0;
+#ifdef _WIN32
+    LogOutput(OT_METHOD)(__FUNCTION__)(
+        ": Journal is not supported on this platform")
+        .Flush();
+
+    return false;
+#else
+    if (IsOpen()) { return false; }
+
+    path_ = path;
+    read_only_ = readOnly;
+    corrupt_ = false;
+    fd_ = readOnly ? ::open(path_.c_str(), O_RDONLY)
+                   : ::open(path_.c_str(), O_RDWR | O_CREAT, 0600);
+
+    if (false == IsOpen()) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to open ")(path_).Flush();
+
+        return false;
+    }
+
+    // The directory entry of a newly created journal must reach the disk
+    // before any lease recorded in it is relied upon
+    if ((false == readOnly) && (false == sync_folder())) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to sync the folder of ")(
+            path_)
+            .Flush();
+        close();
+
+        return false;
+    }
+
+    struct stat info {
+    };
+
+    if (0 != ::fstat(fd_, &info)) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to read ")(path_).Flush();
+        close();
+
+        return false;
+    }
+
+    const auto bytes = static_cast<std::size_t>(info.st_size);
+    Record record{};
+    auto valid = std::size_t{0};
+
+    while (sizeof(record) == ::pread(
+                                 fd_,
+                                 &record,
+                                 sizeof(record),
+                                 static_cast<off_t>(valid * sizeof(record)))) {
+        const auto ceiling = record.ceiling_.value();
+
+        if (record_check(ceiling) != record.check_.value()) { break; }
+
+        highest = std::max(highest, ceiling);
+        ++valid;
+    }
+
+    // Every append is synced before the next one starts, so only the final
+    // record can have been interrupted
+    if (((valid + 1) * sizeof(record)) < bytes) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid record ")(valid)(
+            " is followed by more data in ")(path_)(
+            ". The journal is corrupt and must be repaired manually.")
+            .Flush();
+        corrupt_ = true;
+        highest = 0;
+        close();
+
+        return false;
+    }
+
+    records_ = valid;
+    highest_ = highest;
+
+    if ((valid * sizeof(record)) != bytes) {
+        if (readOnly) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Ignoring incomplete record in ")(path_)
+                .Flush();
+        } else {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Discarding incomplete record in ")(path_)
+                .Flush();
+
+            if (false == truncate(valid)) {
+                close();
+
+                return false;
+            }
+        }
+    }
+
+    return true;
+#endif
+}
+
+bool NumberJournal::Reset(const TransactionNumber ceiling) noexcept
+{
+    if ((false == IsOpen()) || read_only_) { return false; }
+
+    // The first record is overwritten with the current ceiling before the
+    // rest are dropped, so the journal never holds less than the highest
+    // reservation even if the process stops between the two steps
+    if (false == write(0, ceiling)) { return false; }
+
+    highest_ = std::max(highest_, ceiling);
+
+    return truncate(1);
+}
+
+bool NumberJournal::sync() const noexcept
+{
+#if defined(__APPLE__)
+    return 0 == ::fcntl(fd_, F_FULLFSYNC);
+#elif defined(_WIN32)
+    return false;
+#else
+    return 0 == ::fdatasync(fd_);
+#endif
+}
+
+bool NumberJournal::sync_folder() const noexcept
+{
+#ifdef _WIN32
+    return false;
+#else
+    const auto slash = path_.find_last_of('/');
+    const auto folder = (std::string::npos == slash)
+                            ? std::string{"."}
+                            : path_.substr(0, std::max(slash, std::size_t{1}));
+    const auto fd = ::open(folder.c_str(), O_RDONLY);
+
+    if (-1 == fd) { return false; }
+
+    const auto synced = (0 == ::fsync(fd));
+    ::close(fd);
+
+    return synced;
+#endif
+}
+
+bool NumberJournal::truncate(const std::size_t records) noexcept
+{
+#ifdef _WIN32
+    return false;
+#else
+    if ((false == IsOpen()) || read_only_) { return false; }
+
+    const auto size = static_cast<off_t>(records * sizeof(Record));
+
+    if ((0 != ::ftruncate(fd_, size)) || (false == sync())) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to truncate ")(path_)
+            .Flush();
+
+        return false;
+    }
+
+    records_ = records;
+
+    return true;
+#endif
+}
+
+bool NumberJournal::write(
+    const std::size_t position,
+    const TransactionNumber ceiling) noexcept
+{
+#ifdef _WIN32
+    return false;
+#else
+    Record record{};
+    record.ceiling_ = ceiling;
+    record.check_ = record_check(ceiling);
+    const auto written = ::pwrite(
+        fd_,
+        &record,
+        sizeof(record),
+        static_cast<off_t>(position * sizeof(record)));
+
+    if ((sizeof(record) != static_cast<std::size_t>(written)) ||
+        (false == sync())) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to write ")(path_)
+            .Flush();
+
+        return false;
+    }
+
+    return true;
+#endif
+}
+
+NumberJournal::~NumberJournal() { close(); }
+}  // namespace opentxs::server
@@ -0,0 +1,77 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Internal.hpp"
+
+#include "opentxs/Types.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace opentxs::server
+{
+/** Append-only record of transaction number reservations
+ *
+ *  Each record holds the highest number covered by a lease and is synced
+ *  to disk before any number from that lease is issued. A torn or corrupt
+ *  trailing record is discarded during recovery, which is safe because the
+ *  numbers it covered were never handed out. An invalid record followed by
+ *  more data can not be the result of an interrupted append, so Open
+ *  refuses such a journal and reports it through Corrupt. Records are 16
+ *  bytes and never straddle a sector, so a rewrite of the first record is
+ *  atomic.
+ */
+class NumberJournal
+{
+public:
+    bool Corrupt() const noexcept { return corrupt_; }
+    /// Highest ceiling read or written since the journal was opened
+    TransactionNumber Highest() const noexcept { return highest_; }
+    bool IsOpen() const noexcept { return -1 != fd_; }
+    std::size_t size() const noexcept { return records_; }
+
+    /// Durably records a new lease ceiling
+    bool Append(const TransactionNumber ceiling) noexcept;
+    /// Reads existing records and returns the highest ceiling, or zero
+    ///
+    /// A read only journal is never created, truncated or written. Opening
+    /// a writable journal fails unless its folder can be synced, so a newly
+    /// created journal can not disappear in a crash.
+    bool Open(
+        const std::string& path,
+        const bool readOnly,
+        TransactionNumber& highest) noexcept;
+    /// Compacts the journal to a single record holding the current ceiling
+    bool Reset(const TransactionNumber ceiling) noexcept;
+
+    NumberJournal() noexcept;
+
+    ~NumberJournal();
+
+private:
+    std::string path_;
+    int fd_;
+    bool read_only_;
+    bool corrupt_;
+    std::size_t records_;
+    TransactionNumber highest_;
+
+    bool sync() const noexcept;
+    bool sync_folder() const noexcept;
+
+    void close() noexcept;
+    bool truncate(const std::size_t records) noexcept;
+    bool write(
+        const std::size_t position,
+        const TransactionNumber ceiling) noexcept;
+
+    NumberJournal(const NumberJournal&) = delete;
+    NumberJournal(NumberJournal&&) = delete;
+    NumberJournal& operator=(const NumberJournal&) = delete;
+    NumberJournal& operator=(NumberJournal&&) = delete;
+};
+}  // namespace opentxs::server
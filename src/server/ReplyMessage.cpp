@@ -29,6 +29,7 @@ ReplyMessage::ReplyMessage(
     const identifier::Server& notaryID,
     const identity::Nym& signer,
     const Message& input,
+    const std::shared_ptr<Ledger>& inputLedger,
     Server& server,
     const MessageType& type,
     Message& output,
@@ -37,6 +38,7 @@ ReplyMessage::ReplyMessage(
     , wallet_(wallet)
     , signer_(signer)
     , original_(input)
+    , input_ledger_(inputLedger)
     , reason_(reason)
     , notary_id_(notaryID)
     , message_(output)
@@ -199,6 +201,11 @@ bool ReplyMessage::init()
 
 const bool& ReplyMessage::Init() const { return init_; }
 
+std::shared_ptr<Ledger> ReplyMessage::InputLedger() const
+{
+    return input_ledger_;
+}
+
 bool ReplyMessage::init_nym()
 {
     sender_nym_ = wallet_.Nym(identifier::Nym::Factory(original_.m_strNymID));
@@ -26,6 +26,7 @@ public:
         const identifier::Server& notaryID,
         const identity::Nym& signer,
         const Message& input,
+        const std::shared_ptr<Ledger>& inputLedger,
         Server& server,
         const MessageType& type,
         Message& output,
@@ -34,6 +35,9 @@ public:
     std::set<RequestNumber> Acknowledged() const;
     bool HaveContext() const;
     const bool& Init() const;
+    /// The ledger from the request payload, if it was parsed before the
+    /// request was dispatched
+    std::shared_ptr<Ledger> InputLedger() const;
     const Message& Original() const;
     const bool& Success() const;
 
@@ -68,6 +72,7 @@ private:
     const opentxs::api::Wallet& wallet_;
     const identity::Nym& signer_;
     const Message& original_;
+    const std::shared_ptr<Ledger> input_ledger_;
     const PasswordPrompt& reason_;
     const OTServerID notary_id_;
     Message& message_;
@@ -0,0 +1,196 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "stdafx.hpp"
+
+#include "RequestScheduler.hpp"
+
+#include "opentxs/core/Log.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#define OT_METHOD "opentxs::server::RequestScheduler::"
+
+namespace opentxs::server
+{
+RequestScheduler::RequestScheduler() noexcept
+    : lock_()
+    , ready_()
+    , queue_()
+    , busy_()
+    , running_(0)
+    , exclusive_running_(false)
+    , stop_(false)
+    , workers_()
+{
+}
+
+RequestScheduler::Tasks::iterator RequestScheduler::next(const Lock&) noexcept
+{
+    if (exclusive_running_) { return queue_.end(); }
+
+    // Resources claimed by earlier queued tasks are treated as busy so that
+    // conflicting requests are never reordered
+    auto claimed = Resources{};
+
+    for (auto it = queue_.begin(); it != queue_.end(); ++it) {
+        const auto& task = *it;
+
+        if (task.exclusive_) {
+            if ((queue_.begin() == it) && (0 == running_)) { return it; }
+
+            return queue_.end();
+        }
+
+        if ((false == overlaps(task.resources_, busy_)) &&
+            (false == overlaps(task.resources_, claimed))) {
+            return it;
+        }
+
+        claimed.insert(task.resources_.begin(), task.resources_.end());
+    }
+
+    return queue_.end();
+}
+
+bool RequestScheduler::overlaps(
+    const Resources& lhs,
+    const Resources& rhs) noexcept
+{
+    auto l = lhs.begin();
+    auto r = rhs.begin();
+
+    while ((lhs.end() != l) && (rhs.end() != r)) {
+        if (*l < *r) {
+            ++l;
+        } else if (*r < *l) {
+            ++r;
+        } else {
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void RequestScheduler::Queue(
+    const Resources& resources,
+    const bool exclusive,
+    const Job& job) noexcept
+{
+    Lock lock(lock_);
+
+    if (stop_) { return; }
+
+    queue_.push_back(Task{resources, exclusive, job});
+    lock.unlock();
+    ready_.notify_one();
+}
+
+void RequestScheduler::release(const Lock&, const Task& task) noexcept
+{
+    for (const auto& resource : task.resources_) { busy_.erase(resource); }
+
+    if (task.exclusive_) { exclusive_running_ = false; }
+
+    --running_;
+}
+
+void RequestScheduler::reserve(const Lock&, const Task& task) noexcept
+{
+    busy_.insert(task.resources_.begin(), task.resources_.end());
+
+    if (task.exclusive_) { exclusive_running_ = true; }
+
+    ++running_;
+}
+
+void RequestScheduler::RunExclusive(const Job& job) noexcept
+{
+    // If the task is discarded the promise is destroyed without being
+    // satisfied, which also releases the waiting thread
+    auto promise = std::make_shared<std::promise<void>>();
+    auto future = promise->get_future();
+    Queue({}, true, [job, promise]() -> void {
+        job();
+        promise->set_value();
+    });
+    promise.reset();
+    future.wait();
+}
+
+void RequestScheduler::Start(const std::size_t threads) noexcept
+{
+    Lock lock(lock_);
+
+    if (false == workers_.empty()) { return; }
+
+    const auto count = (0 == threads)
+                           ? std::max(std::thread::hardware_concurrency(), 1u)
+                           : threads;
+
+    for (std::size_t i{0}; i < count; ++i) {
+        workers_.emplace_back(&RequestScheduler::worker, this);
+    }
+
+    LogDetail(OT_METHOD)(__FUNCTION__)(": Started ")(count)(" worker threads")
+        .Flush();
+}
+
+void RequestScheduler::Stop() noexcept
+{
+    auto workers = std::vector<std::thread>{};
+    auto discard = Tasks{};
+
+    {
+        Lock lock(lock_);
+        stop_ = true;
+        workers.swap(workers_);
+    }
+
+    ready_.notify_all();
+
+    for (auto& thread : workers) {
+        if (thread.joinable()) { thread.join(); }
+    }
+
+    Lock lock(lock_);
+    discard.swap(queue_);
+    lock.unlock();
+}
+
+void RequestScheduler::worker() noexcept
+{
+    Lock lock(lock_);
+
+    while (false == stop_) {
+        auto it = next(lock);
+
+        if (queue_.end() == it) {
+            ready_.wait(lock);
+
+            continue;
+        }
+
+        const auto task = std::move(*it);
+        queue_.erase(it);
+        reserve(lock, task);
+        lock.unlock();
+        task.job_();
+        lock.lock();
+        release(lock, task);
+        ready_.notify_all();
+    }
+}
+
+RequestScheduler::~RequestScheduler() { Stop(); }
+}  // namespace opentxs::server
@@ -0,0 +1,85 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Internal.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace opentxs::server
+{
+/** Runs notary requests on a pool of worker threads
+ *
+ *  Every job names the nyms and accounts it modifies. A job starts as soon
+ *  as none of its resources are held by a running job or claimed by a job
+ *  queued ahead of it, so jobs on disjoint resources run in parallel while
+ *  conflicting jobs execute in the order they arrived. All resources for a
+ *  job are acquired at once under the scheduler mutex, so there is no lock
+ *  ordering between jobs to get wrong.
+ *
+ *  An exclusive job waits for every earlier job to finish and blocks every
+ *  later job until it completes.
+ */
+class RequestScheduler
+{
+public:
+    using Job = std::function<void()>;
+    using Resources = std::set<std::string>;
+
+    OPENTXS_EXPORT void Queue(
+        const Resources& resources,
+        const bool exclusive,
+        const Job& job) noexcept;
+    /// Blocks until the job has executed or the scheduler has stopped
+    OPENTXS_EXPORT void RunExclusive(const Job& job) noexcept;
+    /// A thread count of zero uses one worker per hardware thread
+    OPENTXS_EXPORT void Start(const std::size_t threads) noexcept;
+    /// Finishes running jobs and discards queued jobs
+    OPENTXS_EXPORT void Stop() noexcept;
+
+    OPENTXS_EXPORT RequestScheduler() noexcept;
+
+    OPENTXS_EXPORT ~RequestScheduler();
+
+private:
+    struct Task {
+        Resources resources_;
+        bool exclusive_;
+        Job job_;
+    };
+
+    using Tasks = std::list<Task>;
+
+    std::mutex lock_;
+    std::condition_variable ready_;
+    Tasks queue_;
+    Resources busy_;
+    std::size_t running_;
+    bool exclusive_running_;
+    bool stop_;
+    std::vector<std::thread> workers_;
+
+    static bool overlaps(const Resources& lhs, const Resources& rhs) noexcept;
+
+    Tasks::iterator next(const Lock& lock) noexcept;
+    void release(const Lock& lock, const Task& task) noexcept;
+    void reserve(const Lock& lock, const Task& task) noexcept;
+    void worker() noexcept;
+
+    RequestScheduler(const RequestScheduler&) = delete;
+    RequestScheduler(RequestScheduler&&) = delete;
+    RequestScheduler& operator=(const RequestScheduler&) = delete;
+    RequestScheduler& operator=(RequestScheduler&&) = delete;
+};
+}  // namespace opentxs::server
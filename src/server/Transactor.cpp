@@ -18,12 +18,17 @@
 
 #include "internal/api/Api.hpp"
 #include "MainFile.hpp"
+#include "NumberJournal.hpp"
 #include "Server.hpp"
 
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
 #include <cinttypes>
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 
@@ -31,11 +36,18 @@
 
 namespace opentxs::server
 {
+// Numbers reserved by each journal record
+const TransactionNumber Transactor::lease_size_{1000};
+// Journal records written between main file rewrites
+const std::size_t Transactor::checkpoint_interval_{64};
 
 Transactor::Transactor(Server& server, const PasswordPrompt& reason)
     : server_(server)
     , reason_(reason)
+    , lock_()
     , transactionNumber_(0)
+    , reserved_(0)
+    , journal_()
     , idToBasketMap_()
     , contractIdToBasketAccountId_()
     , voucherAccounts_(server.API())
@@ -53,23 +65,25 @@ Transactor::Transactor(Server& server, const PasswordPrompt& reason)
 bool Transactor::issueNextTransactionNumber(
     TransactionNumber& lTransactionNumber)
 {
-    // transactionNumber_ stores the last VALID AND ISSUED transaction number.
-    // So first, we increment that, since we don't want to issue the same number
-    // twice.
-    transactionNumber_++;
+    Lock lock(lock_);
 
-    // Next, we save it to file.
-    if (!server_.GetMainFile().SaveMainFile()) {
-        LogOutput(OT_METHOD)(__FUNCTION__)(": Error saving main server file.")
-            .Flush();
-        transactionNumber_--;
-        return false;
+    return issue_next_transaction_number(lock, lTransactionNumber);
+}
+
+bool Transactor::issue_next_transaction_number(
+    const Lock& lock,
+    TransactionNumber& lTransactionNumber)
+{
+    // transactionNumber_ stores the last VALID AND ISSUED transaction number.
+    // Before it is incremented, make sure the next number is covered by a
+    // lease which has already reached the disk.
+    if (transactionNumber_ >= reserved_) {
+        if (!reserve_numbers(lock)) { return false; }
     }
 
-    // SUCCESS?
-    // Now the server main file has saved the latest transaction number,
-    // NOW we set it onto the parameter and return true.
+    transactionNumber_++;
     lTransactionNumber = transactionNumber_;
+
     return true;
 }
 
@@ -77,7 +91,11 @@ bool Transactor::issueNextTransactionNumberToNym(
     ClientContext& context,
     TransactionNumber& lTransactionNumber)
 {
-    if (!issueNextTransactionNumber(lTransactionNumber)) { return false; }
+    Lock lock(lock_);
+
+    if (!issue_next_transaction_number(lock, lTransactionNumber)) {
+        return false;
+    }
 
     // Each Nym stores the transaction numbers that have been issued to it.
     // (On client AND server side.)
@@ -90,22 +108,93 @@ bool Transactor::issueNextTransactionNumberToNym(
         LogOutput(OT_METHOD)(__FUNCTION__)(
             ": Error adding transaction number to Nym file.")
             .Flush();
+        // The number never left the server and remains inside the current
+        // lease, so it can be issued again.
         transactionNumber_--;
-        // Save it back how it was, since we're not issuing this number after
-        // all.
-        server_.GetMainFile().SaveMainFile();
 
         return false;
     }
 
     // SUCCESS?
-    // Now the server main file has saved the latest transaction number,
-    // NOW we set it onto the parameter and return true.
+    // Now the reservation containing the latest transaction number is on
+    // disk, NOW we set it onto the parameter and return true.
     lTransactionNumber = transactionNumber_;
 
     return true;
 }
 
+bool Transactor::loadNumberJournal(const bool readOnly)
+{
+    Lock lock(lock_);
+    auto opened = journal_.IsOpen();
+
+    if (false == opened) {
+        const auto filename =
+            std::string(server_.WalletFilename().Get()) + ".journal";
+        const auto path =
+            boost::filesystem::path(server_.API().DataFolder()) / filename;
+        auto highest = TransactionNumber{0};
+        opened = journal_.Open(path.string(), readOnly, highest);
+
+        if (journal_.Corrupt()) {
+            // Falling back to the main file could reissue numbers which were
+            // reserved by the unreadable records
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Transaction number journal is corrupt.")
+                .Flush();
+            OT_FAIL;
+        }
+
+        if ((false == opened) && (false == readOnly)) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Transaction number journal unavailable. Reservations will "
+                "be recorded in the main file.")
+                .Flush();
+        }
+    }
+
+    // Every number inside a recorded lease may have been issued before the
+    // server stopped, so issuance resumes after the highest one. The journal
+    // remembers this value, so a reloaded main file can not lower it.
+    transactionNumber_ = std::max(transactionNumber_, journal_.Highest());
+    reserved_ = transactionNumber_;
+
+    return opened;
+}
+
+void Transactor::checkpoint(const Lock&)
+{
+    // The journal keeps the current ceiling, so a main file write which has
+    // not reached the disk yet can never cause a number to be reissued.
+    if (server_.GetMainFile().SaveMainFile()) { journal_.Reset(reserved_); }
+}
+
+bool Transactor::reserve_numbers(const Lock& lock)
+{
+    const auto ceiling = transactionNumber_ + lease_size_;
+
+    if (journal_.Append(ceiling)) {
+        reserved_ = ceiling;
+
+        if (checkpoint_interval_ <= journal_.size()) { checkpoint(lock); }
+
+        return true;
+    }
+
+    // Without a journal every lease is recorded by rewriting the main file
+    const auto previous = reserved_;
+    reserved_ = ceiling;
+
+    if (server_.GetMainFile().SaveMainFile()) { return true; }
+
+    reserved_ = previous;
+    LogOutput(OT_METHOD)(__FUNCTION__)(
+        ": Failed to record transaction number reservation.")
+        .Flush();
+
+    return false;
+}
+
 // Server stores a map of BASKET_ID to BASKET_ACCOUNT_ID.
 bool Transactor::addBasketAccountID(
     const Identifier& BASKET_ID,
@@ -10,9 +10,13 @@
 #include "opentxs/core/AccountList.hpp"
 #include "opentxs/Types.hpp"
 
+#include "NumberJournal.hpp"
+
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace opentxs
@@ -39,6 +43,12 @@ public:
         transactionNumber_ = value;
     }
 
+    // Must be called after the main file sets the transaction number and
+    // before any number is issued. Safe to call again after the main file is
+    // reloaded: the journal is only opened once. In read only mode the
+    // journal is never created or modified.
+    bool loadNumberJournal(const bool readOnly = false);
+
     bool addBasketAccountID(
         const Identifier& basketId,
         const Identifier& basketAccountId,
@@ -69,10 +79,19 @@ public:
 private:
     typedef std::map<std::string, std::string> BasketsMap;
 
+    static const TransactionNumber lease_size_;
+    static const std::size_t checkpoint_interval_;
+
     Server& server_;
     const PasswordPrompt& reason_;
+    // Requests for different nyms may issue numbers concurrently
+    std::mutex lock_;
     // This stores the last VALID AND ISSUED transaction number.
     TransactionNumber transactionNumber_;
+    // Numbers up to this value are durably reserved and may be issued
+    // without touching the disk
+    TransactionNumber reserved_;
+    NumberJournal journal_;
     // maps basketId with basketAccountId
     BasketsMap idToBasketMap_;
     // basket issuer account ID, which is *different* on each server, using the
@@ -82,6 +101,12 @@ private:
     // The list of voucher accounts (see GetVoucherAccount below for details)
     AccountList voucherAccounts_;
 
+    void checkpoint(const Lock& lock);
+    bool issue_next_transaction_number(
+        const Lock& lock,
+        TransactionNumber& txNumber);
+    bool reserve_numbers(const Lock& lock);
+
     Transactor() = delete;
 };
 }  // namespace server
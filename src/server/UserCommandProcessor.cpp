@@ -1452,11 +1452,9 @@ bool UserCommandProcessor::cmd_notarize_transaction(ReplyMessage& reply) const
     const auto& serverNymID = serverNym.ID();
     const auto accountID = Identifier::Factory(msgIn.m_strAcctID);
     auto nymboxHash = Identifier::Factory();
-    auto input{manager_.Factory().Ledger(nymID, accountID, serverID)};
     auto responseLedger{manager_.Factory().Ledger(
         serverNymID, accountID, serverID, ledgerType::message, false)};
 
-    OT_ASSERT(input);
     OT_ASSERT(responseLedger);
 
     if (false == hash_check(context, nymboxHash)) {
@@ -1465,8 +1463,9 @@ bool UserCommandProcessor::cmd_notarize_transaction(ReplyMessage& reply) const
         return false;
     }
 
-    if (false ==
-        input->LoadLedgerFromString(String::Factory(msgIn.m_ascPayload))) {
+    const auto input = input_ledger(reply, nymID, accountID, serverID);
+
+    if (false == bool(input)) {
         LogOutput(OT_METHOD)(__FUNCTION__)(": Unable to load input ledger.")
             .Flush();
 
@@ -1556,11 +1555,9 @@ bool UserCommandProcessor::cmd_process_inbox(ReplyMessage& reply) const
     const auto& nym = reply.Context().RemoteNym();
     const auto accountID = Identifier::Factory(msgIn.m_strAcctID);
     auto nymboxHash = Identifier::Factory();
-    auto input{manager_.Factory().Ledger(nymID, accountID, serverID)};
     auto responseLedger{manager_.Factory().Ledger(
         serverNymID, accountID, serverID, ledgerType::message, false)};
 
-    OT_ASSERT(input);
     OT_ASSERT(responseLedger);
 
     if (false == hash_check(context, nymboxHash)) {
@@ -1569,8 +1566,9 @@ bool UserCommandProcessor::cmd_process_inbox(ReplyMessage& reply) const
         return false;
     }
 
-    if (false ==
-        input->LoadLedgerFromString(String::Factory(msgIn.m_ascPayload))) {
+    const auto input = input_ledger(reply, nymID, accountID, serverID);
+
+    if (false == bool(input)) {
         LogOutput(OT_METHOD)(__FUNCTION__)(": Unable to load input ledger.")
             .Flush();
 
@@ -2357,6 +2355,10 @@ bool UserCommandProcessor::cmd_trigger_clause(ReplyMessage& reply) const
         theMatchingClauses.insert({clauseID, clause});
         smartContract->ExecuteClauses(theMatchingClauses, reason_);
 
+        // The clause ran outside of a cron round, so nothing else will write
+        // the contract it changed
+        server_.Cron().SaveCron();
+
         if (smartContract->IsFlaggedForRemoval()) {
             LogOutput(OT_METHOD)(__FUNCTION__)(": Removing smart contract ")(
                 smartContract->GetTransactionNum())(" from cron.")
@@ -2637,6 +2639,31 @@ bool UserCommandProcessor::isAdmin(const identifier::Nym& nymID)
     return (0 == adminNym.compare(String::Factory(nymID)->Get()));
 }
 
+std::shared_ptr<Ledger> UserCommandProcessor::input_ledger(
+    const ReplyMessage& reply,
+    const identifier::Nym& nymID,
+    const Identifier& accountID,
+    const identifier::Server& serverID) const
+{
+    // The message processor parses transaction ledgers in order to schedule
+    // them, so reuse that copy if one was provided
+    auto output = reply.InputLedger();
+
+    if (output) { return output; }
+
+    output = manager_.Factory().Ledger(nymID, accountID, serverID);
+
+    OT_ASSERT(output);
+
+    if (false == output->LoadLedgerFromString(
+                     String::Factory(reply.Original().m_ascPayload))) {
+
+        return {};
+    }
+
+    return output;
+}
+
 std::unique_ptr<Ledger> UserCommandProcessor::load_inbox(
     const identifier::Nym& nymID,
     const Identifier& accountID,
@@ -2778,7 +2805,8 @@ std::unique_ptr<Ledger> UserCommandProcessor::load_outbox(
 
 bool UserCommandProcessor::ProcessUserCommand(
     const Message& msgIn,
-    Message& msgOut)
+    Message& msgOut,
+    const std::shared_ptr<Ledger>& inputLedger)
 {
     const std::string command(msgIn.m_strCommand->Get());
     const auto type = Message::Type(command);
@@ -2788,6 +2816,7 @@ bool UserCommandProcessor::ProcessUserCommand(
         server_.GetServerID(),
         server_.GetServerNym(),
         msgIn,
+        inputLedger,
         server_,
         type,
         msgOut,
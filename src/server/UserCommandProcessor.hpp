@@ -37,7 +37,12 @@ public:
         ClientContext& context,
         Server& server) const;
 
-    bool ProcessUserCommand(const Message& msgIn, Message& msgOut);
+    /// inputLedger is the transaction ledger from msgIn's payload if the
+    /// caller has already parsed it
+    bool ProcessUserCommand(
+        const Message& msgIn,
+        Message& msgOut,
+        const std::shared_ptr<Ledger>& inputLedger = {});
 
 private:
     friend class Server;
@@ -127,6 +132,11 @@ private:
         const identity::Nym& serverNym) const;
     bool hash_check(const ClientContext& context, Identifier& nymboxHash) const;
     RequestNumber initialize_request_number(ClientContext& context) const;
+    std::shared_ptr<Ledger> input_ledger(
+        const ReplyMessage& reply,
+        const identifier::Nym& nymID,
+        const Identifier& accountID,
+        const identifier::Server& serverID) const;
     std::unique_ptr<Ledger> load_inbox(
         const identifier::Nym& nymID,
         const Identifier& accountID,
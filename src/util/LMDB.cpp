@@ -539,6 +539,15 @@ auto LMDB::Queue(
 
 auto LMDB::Read(const Table table, const ReadCallback cb, const Dir dir) const
     noexcept -> bool
+{
+    return ReadFrom(table, {}, cb, dir);
+}
+
+auto LMDB::ReadFrom(
+    const Table table,
+    const ReadView index,
+    const ReadCallback cb,
+    const Dir dir) const noexcept -> bool
 {
     struct Cleanup {
         bool success_;
@@ -598,7 +607,26 @@ auto LMDB::Read(const Table table, const ReadCallback cb, const Dir dir) const
     auto again{true};
     auto key = MDB_val{};
     auto value = MDB_val{};
-    cleanup.success_ = 0 == ::mdb_cursor_get(cursor, &key, &value, start);
+
+    if (0 == index.size()) {
+        cleanup.success_ = 0 == ::mdb_cursor_get(cursor, &key, &value, start);
+    } else {
+        key = MDB_val{index.size(), const_cast<char*>(index.data())};
+        cleanup.success_ =
+            0 == ::mdb_cursor_get(cursor, &key, &value, MDB_SET_RANGE);
+
+        if (Dir::Backward == dir) {
+            if (false == cleanup.success_) {
+                cleanup.success_ =
+                    0 == ::mdb_cursor_get(cursor, &key, &value, MDB_LAST);
+            } else if (
+                ReadView{static_cast<char*>(key.mv_data), key.mv_size} !=
+                index) {
+                cleanup.success_ =
+                    0 == ::mdb_cursor_get(cursor, &key, &value, MDB_PREV);
+            }
+        }
+    }
 
     try {
         if (cleanup.success_) {
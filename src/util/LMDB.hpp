@@ -97,6 +97,13 @@ public:
         const Mode mode = Mode::One) const noexcept;
     bool Read(const Table table, const ReadCallback cb, const Dir dir) const
         noexcept;
+    // Like Read, but the cursor starts at the first key not less than
+    // (Forward) or not greater than (Backward) the supplied key
+    bool ReadFrom(
+        const Table table,
+        const ReadView key,
+        const ReadCallback cb,
+        const Dir dir) const noexcept;
     Result Store(
         const Table table,
         const ReadView key,
@@ -14,6 +14,7 @@
 #include "blockchain/bitcoin/CompactSize.hpp"
 #include "blockchain/p2p/bitcoin/message/Getblocks.hpp"
 #include "blockchain/p2p/bitcoin/Message.hpp"
+#include "internal/blockchain/block/Block.hpp"
 #include "internal/blockchain/client/Client.hpp"
 #include "internal/blockchain/Blockchain.hpp"
 #endif  // OT_BLOCKCHAIN
@@ -0,0 +1,138 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "OTTestEnvironment.hpp"
+
+#include "api/client/blockchain/BalanceLedger.hpp"
+
+namespace
+{
+using Ledger = ot::api::client::blockchain::implementation::BalanceLedger;
+using Balance = Ledger::Balance;
+
+const std::string account_1_{"account 1"};
+const std::string account_2_{"account 2"};
+const std::string tx_1_{"tx 1"};
+const std::string tx_2_{"tx 2"};
+const std::string tx_3_{"tx 3"};
+
+TEST(Test_BalanceLedger, confirmation)
+{
+    auto ledger = Ledger{};
+
+    EXPECT_EQ(ledger.Get(), Balance(0, 0));
+    EXPECT_EQ(ledger.Get(account_1_), Balance(0, 0));
+
+    ledger.Add(tx_1_, {{account_1_, 100}, {account_2_, 20}});
+    ledger.Add(tx_2_, {{account_1_, 5}});
+
+    EXPECT_EQ(ledger.Get(), Balance(0, 125));
+    EXPECT_EQ(ledger.Get(account_1_), Balance(0, 105));
+    EXPECT_EQ(ledger.Get(account_2_), Balance(0, 20));
+    EXPECT_TRUE(ledger.Confirm(tx_1_, 10));
+    EXPECT_EQ(ledger.Get(), Balance(120, 5));
+    EXPECT_EQ(ledger.Get(account_1_), Balance(100, 5));
+    EXPECT_EQ(ledger.Get(account_2_), Balance(20, 0));
+
+    // Confirming again at the same height changes nothing
+    EXPECT_TRUE(ledger.Confirm(tx_1_, 10));
+    EXPECT_EQ(ledger.Get(), Balance(120, 5));
+
+    // Unknown transactions can not be confirmed
+    EXPECT_FALSE(ledger.Confirm(tx_3_, 10));
+    EXPECT_EQ(ledger.Get(), Balance(120, 5));
+}
+
+TEST(Test_BalanceLedger, reorg)
+{
+    auto ledger = Ledger{};
+    ledger.Add(tx_1_, {{account_1_, 100}});
+    ledger.Add(tx_2_, {{account_1_, -30}, {account_2_, 30}});
+    ledger.Add(tx_3_, {{account_2_, 7}});
+
+    ASSERT_TRUE(ledger.Confirm(tx_1_, 10));
+    ASSERT_TRUE(ledger.Confirm(tx_2_, 11));
+    ASSERT_TRUE(ledger.Confirm(tx_3_, 12));
+    EXPECT_EQ(ledger.Get(), Balance(107, 0));
+    EXPECT_EQ(ledger.Get(account_1_), Balance(70, 0));
+    EXPECT_EQ(ledger.Get(account_2_), Balance(37, 0));
+
+    // Blocks above the parent return their transactions to unconfirmed
+    ledger.Reorg(10);
+
+    EXPECT_EQ(ledger.Get(), Balance(100, 7));
+    EXPECT_EQ(ledger.Get(account_1_), Balance(100, -30));
+    EXPECT_EQ(ledger.Get(account_2_), Balance(0, 37));
+
+    // The disconnected transactions may be confirmed again in the new chain
+    EXPECT_TRUE(ledger.Confirm(tx_3_, 11));
+    EXPECT_EQ(ledger.Get(), Balance(107, 0));
+    EXPECT_EQ(ledger.Get(account_2_), Balance(7, 30));
+
+    ledger.Reorg(0);
+
+    EXPECT_EQ(ledger.Get(), Balance(0, 107));
+    EXPECT_EQ(ledger.Get(account_1_), Balance(0, 70));
+    EXPECT_EQ(ledger.Get(account_2_), Balance(0, 37));
+}
+
+TEST(Test_BalanceLedger, idempotent_add)
+{
+    auto ledger = Ledger{};
+    ledger.Add(tx_1_, {{account_1_, 100}});
+    ledger.Add(tx_1_, {{account_1_, 100}});
+
+    EXPECT_EQ(ledger.Get(), Balance(0, 100));
+
+    ASSERT_TRUE(ledger.Confirm(tx_1_, 10));
+
+    ledger.Add(tx_1_, {{account_1_, 100}});
+
+    EXPECT_EQ(ledger.Get(), Balance(100, 0));
+    EXPECT_EQ(ledger.Get(account_1_), Balance(100, 0));
+
+    // A later association which finds more outputs applies the difference
+    ledger.Add(tx_1_, {{account_1_, 100}, {account_2_, 25}});
+
+    EXPECT_EQ(ledger.Get(), Balance(125, 0));
+    EXPECT_EQ(ledger.Get(account_2_), Balance(25, 0));
+
+    // Nothing is recorded for a transaction without deltas
+    ledger.Add(tx_2_, {});
+
+    EXPECT_FALSE(ledger.Confirm(tx_2_, 11));
+    EXPECT_EQ(ledger.Get(), Balance(125, 0));
+}
+
+TEST(Test_BalanceLedger, move_between_blocks)
+{
+    auto ledger = Ledger{};
+    ledger.Add(tx_1_, {{account_1_, 100}});
+    ledger.Add(tx_2_, {{account_1_, 50}});
+
+    ASSERT_TRUE(ledger.Confirm(tx_1_, 10));
+    ASSERT_TRUE(ledger.Confirm(tx_2_, 10));
+    EXPECT_EQ(ledger.Get(), Balance(150, 0));
+
+    // Moving a confirmed transaction to another block keeps the balance
+    EXPECT_TRUE(ledger.Confirm(tx_2_, 12));
+    EXPECT_EQ(ledger.Get(), Balance(150, 0));
+
+    // Only the block the transaction now belongs to is rolled back
+    ledger.Reorg(11);
+
+    EXPECT_EQ(ledger.Get(), Balance(100, 50));
+
+    EXPECT_TRUE(ledger.Confirm(tx_2_, 11));
+    EXPECT_TRUE(ledger.Confirm(tx_1_, 11));
+    EXPECT_EQ(ledger.Get(), Balance(150, 0));
+
+    // Block 10 is empty after the move, so nothing above it remains behind
+    ledger.Reorg(10);
+
+    EXPECT_EQ(ledger.Get(), Balance(0, 150));
+    EXPECT_EQ(ledger.Get(account_1_), Balance(0, 150));
+}
+}  // namespace
@@ -112,4 +112,155 @@ TEST_F(Test_BlockHeader, Deserialize)
     ASSERT_TRUE(pHeader);
     EXPECT_EQ(expectedHash.get(), pHeader->Hash());
 }
+
+TEST_F(Test_BlockHeader, flat_record)
+{
+    std::unique_ptr<const bb::Header> pHeader{
+        ot::Factory::GenesisBlockHeader(api_, b::Type::Bitcoin)};
+
+    ASSERT_TRUE(pHeader);
+
+    const auto& header = *pHeader;
+    const auto& bitcoin = dynamic_cast<const bb::bitcoin::Header&>(header);
+    const auto flat = bb::internal::Flatten(header);
+    const auto view = bb::internal::FlatHeaderView::Parse(
+        {reinterpret_cast<const char*>(&flat), sizeof(flat)});
+
+    ASSERT_TRUE(view);
+    EXPECT_FALSE(bb::internal::FlatHeaderView::Parse(
+        {reinterpret_cast<const char*>(&flat), sizeof(flat) - 1}));
+    EXPECT_EQ(view.Type(), header.Type());
+    EXPECT_EQ(view.Height(), header.Height());
+    EXPECT_EQ(view.LocalState(), header.LocalState());
+    EXPECT_EQ(view.InheritedState(), header.InheritedState());
+    EXPECT_EQ(view.ParentHash(), header.ParentHash().Bytes());
+    EXPECT_EQ(view.Raw(), bitcoin.Encode()->Bytes());
+
+    std::unique_ptr<const bb::Header> pCopy{
+        ot::Factory::BitcoinBlockHeader(api_, header.Hash(), view)};
+
+    ASSERT_TRUE(pCopy);
+
+    const auto& copy = *pCopy;
+
+    EXPECT_EQ(copy.Hash(), header.Hash());
+    EXPECT_EQ(copy.ParentHash(), header.ParentHash());
+    EXPECT_EQ(copy.Height(), header.Height());
+    EXPECT_EQ(copy.LocalState(), header.LocalState());
+    EXPECT_EQ(copy.InheritedState(), header.InheritedState());
+    EXPECT_EQ(copy.Work()->asHex(), header.Work()->asHex());
+    EXPECT_EQ(copy.ParentWork()->asHex(), header.ParentWork()->asHex());
+    EXPECT_EQ(
+        dynamic_cast<const bb::bitcoin::Header&>(copy).Encode()->asHex(),
+        bitcoin.Encode()->asHex());
+}
+
+TEST_F(Test_BlockHeader, flat_record_format)
+{
+    for (const auto type :
+         {b::Type::Bitcoin,
+          b::Type::Bitcoin_testnet3,
+          b::Type::BitcoinCash,
+          b::Type::BitcoinCash_testnet3}) {
+        std::unique_ptr<const bb::Header> pHeader{
+            ot::Factory::GenesisBlockHeader(api_, type)};
+
+        ASSERT_TRUE(pHeader);
+
+        const auto flat = bb::internal::Flatten(*pHeader);
+        const auto view = bb::internal::FlatHeaderView::Parse(
+            {reinterpret_cast<const char*>(&flat), sizeof(flat)});
+
+        ASSERT_TRUE(view);
+        EXPECT_TRUE(view.BitcoinFormat());
+
+        std::unique_ptr<const bb::Header> pCopy{
+            ot::Factory::BitcoinBlockHeader(api_, pHeader->Hash(), view)};
+
+        ASSERT_TRUE(pCopy);
+        EXPECT_EQ(pCopy->Type(), type);
+        EXPECT_EQ(pCopy->Work()->Decimal(), pHeader->Work()->Decimal());
+    }
+
+    auto flat = bb::internal::FlatHeader{};
+    flat.type_ = static_cast<std::uint32_t>(b::Type::Ethereum_frontier);
+    const auto view = bb::internal::FlatHeaderView::Parse(
+        {reinterpret_cast<const char*>(&flat), sizeof(flat)});
+
+    ASSERT_TRUE(view);
+    EXPECT_FALSE(view.BitcoinFormat());
+}
+
+TEST_F(Test_BlockHeader, double_sha256)
+{
+    namespace bi = ot::blockchain::internal;
+
+    auto message = std::string{};
+
+    for (auto i = 0; i < 300; ++i) {
+        auto expected = api_.Factory().Data();
+        api_.Crypto().Hash().Digest(
+            ot::proto::HASHTYPE_SHA256D, message, expected->WriteInto());
+        const auto split = message.size() / 3;
+        const auto hash = bi::DoubleSha256(
+            {ot::ReadView{message}.substr(0, split),
+             ot::ReadView{message}.substr(split)});
+
+        ASSERT_EQ(expected->size(), hash.size());
+        EXPECT_EQ(0, std::memcmp(expected->data(), hash.data(), hash.size()));
+
+        message.push_back(static_cast<char>(i * 7));
+    }
+}
+
+TEST_F(Test_BlockHeader, merkle_root)
+{
+    namespace bi = ot::blockchain::internal;
+
+    auto reference = [](std::vector<bi::Sha256Digest> level) {
+        while (1 < level.size()) {
+            if (1 == (level.size() % 2)) { level.emplace_back(level.back()); }
+
+            auto next = std::vector<bi::Sha256Digest>{};
+
+            for (auto i = std::size_t{0}; i < level.size(); i += 2) {
+                next.emplace_back(bi::DoubleSha256(
+                    {ot::ReadView{
+                         reinterpret_cast<const char*>(level[i].data()), 32},
+                     ot::ReadView{
+                         reinterpret_cast<const char*>(level[i + 1].data()),
+                         32}}));
+            }
+
+            level.swap(next);
+        }
+
+        return level.front();
+    };
+    auto leaves = [](const std::size_t count) {
+        auto output = std::vector<bi::Sha256Digest>{};
+
+        for (auto i = std::size_t{0}; i < count; ++i) {
+            const auto preimage = std::to_string(i);
+            output.emplace_back(bi::DoubleSha256({preimage}));
+        }
+
+        return output;
+    };
+
+    EXPECT_FALSE(bi::MerkleRoot({}).has_value());
+
+    for (const auto count : {1, 2, 3, 7, 8, 9, 16, 17, 33, 4097}) {
+        const auto input = leaves(static_cast<std::size_t>(count));
+        const auto root = bi::MerkleRoot(input);
+
+        ASSERT_TRUE(root.has_value());
+        EXPECT_EQ(root.value(), reference(input));
+    }
+
+    auto malleated = leaves(3);
+    malleated.emplace_back(malleated.back());
+
+    EXPECT_FALSE(bi::MerkleRoot(malleated).has_value());
+}
 }  // namespace
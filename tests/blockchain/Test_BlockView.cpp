@@ -0,0 +1,285 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "OTTestEnvironment.hpp"
+
+#include "blockchain/transaction/bitcoin/BlockView.hpp"
+#include "blockchain/transaction/bitcoin/Transaction.hpp"
+
+namespace b = ot::blockchain;
+namespace bi = b::internal;
+namespace bt = b::transaction::bitcoin;
+
+namespace
+{
+using Bytes = std::string;
+
+auto le32(const std::uint32_t value) -> Bytes
+{
+    auto output = Bytes{};
+
+    for (auto i{0}; i < 4; ++i) {
+        output.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+
+    return output;
+}
+
+auto le64(const std::uint64_t value) -> Bytes
+{
+    return le32(static_cast<std::uint32_t>(value)) +
+           le32(static_cast<std::uint32_t>(value >> 32));
+}
+
+// Every script and count in these tests is below 0xfd
+auto pushed(const Bytes& script) -> Bytes
+{
+    return Bytes(1, static_cast<char>(script.size())) + script;
+}
+
+auto view(const Bytes& bytes) -> ot::ReadView
+{
+    return ot::ReadView{bytes.data(), bytes.size()};
+}
+
+auto digest(const bi::Sha256Digest& hash) -> Bytes
+{
+    return Bytes{reinterpret_cast<const char*>(hash.data()), hash.size()};
+}
+
+// One input and two outputs, legacy serialization
+const auto legacy_outpoint_ = Bytes(32, '\x11') + le32(2);
+const auto legacy_input_script_ = Bytes{"abc"};
+const auto legacy_output_script_1_ = Bytes{"\x51"};
+const auto legacy_output_script_2_ = Bytes{"\x76\xa9"};
+const auto legacy_tx_ = le32(1) + "\x01" + legacy_outpoint_ +
+                        pushed(legacy_input_script_) + le32(0xffffffff) +
+                        "\x02" + le64(50) + pushed(legacy_output_script_1_) +
+                        le64(7) + pushed(legacy_output_script_2_) + le32(0);
+
+// One input with two witness items and one output
+const auto segwit_outpoint_ = Bytes(32, '\x22') + le32(0);
+const auto segwit_output_script_ = Bytes{"\x00\x14", 2} + Bytes(20, '\x33');
+const auto segwit_witness_1_ = Bytes{"wit"};
+const auto segwit_witness_2_ = Bytes{"ne"};
+const auto segwit_body_ = Bytes{"\x01"} + segwit_outpoint_ + pushed({}) +
+                          le32(0xfffffffe) + "\x01" + le64(100) +
+                          pushed(segwit_output_script_);
+const auto segwit_stripped_ = le32(2) + segwit_body_ + le32(5);
+const auto segwit_tx_ = le32(2) + Bytes{"\x00\x01", 2} + segwit_body_ +
+                        "\x02" + pushed(segwit_witness_1_) +
+                        pushed(segwit_witness_2_) + le32(5);
+
+auto header(const std::vector<Bytes>& stripped) -> Bytes
+{
+    auto txids = std::vector<bi::Sha256Digest>{};
+
+    for (const auto& tx : stripped) {
+        txids.emplace_back(bi::DoubleSha256({view(tx)}));
+    }
+
+    const auto root = bi::MerkleRoot(std::move(txids));
+
+    EXPECT_TRUE(root.has_value());
+
+    return le32(1) + Bytes(32, '\xaa') + digest(root.value()) +
+           le32(1234567890) + le32(0x1d00ffff) + le32(42);
+}
+
+auto block(
+    const std::vector<Bytes>& transactions,
+    const std::vector<Bytes>& stripped) -> Bytes
+{
+    auto output = header(stripped);
+    output.push_back(static_cast<char>(transactions.size()));
+
+    for (const auto& tx : transactions) { output += tx; }
+
+    return output;
+}
+
+TEST(Test_BlockView, non_segwit)
+{
+    const auto bytes = block({legacy_tx_}, {legacy_tx_});
+    auto parsed = bt::BlockView{};
+
+    ASSERT_TRUE(parsed.Parse(view(bytes)));
+    EXPECT_TRUE(parsed.VerifyMerkleRoot());
+    EXPECT_EQ(parsed.Version(), 1);
+    EXPECT_EQ(parsed.PreviousBlockHash(), view(Bytes(32, '\xaa')));
+    EXPECT_EQ(parsed.Timestamp(), ot::Clock::from_time_t(1234567890));
+    EXPECT_EQ(parsed.nBits(), 0x1d00ffffu);
+    EXPECT_EQ(parsed.Nonce(), 42u);
+    ASSERT_EQ(parsed.Transactions().size(), 1u);
+    ASSERT_EQ(parsed.Inputs().size(), 1u);
+    ASSERT_EQ(parsed.Outputs().size(), 2u);
+    EXPECT_TRUE(parsed.Witnesses().empty());
+
+    const auto& tx = parsed.Transactions().front();
+
+    EXPECT_FALSE(tx.segwit_);
+    EXPECT_EQ(tx.version_, 1);
+    EXPECT_EQ(tx.lock_time_, 0u);
+    EXPECT_EQ(tx.raw_, view(legacy_tx_));
+    EXPECT_EQ(parsed.Txid(tx), parsed.Wtxid(tx));
+    EXPECT_EQ(parsed.Txid(tx), bi::DoubleSha256({view(legacy_tx_)}));
+    EXPECT_EQ(parsed.Inputs()[0].outpoint_, view(legacy_outpoint_));
+    EXPECT_EQ(parsed.Inputs()[0].script_, view(legacy_input_script_));
+    EXPECT_EQ(parsed.Inputs()[0].sequence_, 0xffffffffu);
+    EXPECT_EQ(parsed.Outputs()[0].value_, 50);
+    EXPECT_EQ(parsed.Outputs()[0].script_, view(legacy_output_script_1_));
+    EXPECT_EQ(parsed.Outputs()[1].value_, 7);
+    EXPECT_EQ(parsed.Outputs()[1].script_, view(legacy_output_script_2_));
+}
+
+TEST(Test_BlockView, segwit)
+{
+    const auto bytes =
+        block({legacy_tx_, segwit_tx_}, {legacy_tx_, segwit_stripped_});
+    auto parsed = bt::BlockView{};
+
+    ASSERT_TRUE(parsed.Parse(view(bytes)));
+    EXPECT_TRUE(parsed.VerifyMerkleRoot());
+    ASSERT_EQ(parsed.Transactions().size(), 2u);
+    ASSERT_EQ(parsed.Inputs().size(), 2u);
+    ASSERT_EQ(parsed.Outputs().size(), 3u);
+    ASSERT_EQ(parsed.Witnesses().size(), 2u);
+
+    const auto& tx = parsed.Transactions().at(1);
+
+    EXPECT_TRUE(tx.segwit_);
+    EXPECT_EQ(tx.version_, 2);
+    EXPECT_EQ(tx.lock_time_, 5u);
+    EXPECT_EQ(tx.raw_, view(segwit_tx_));
+    EXPECT_EQ(tx.first_input_, 1u);
+    EXPECT_EQ(tx.first_output_, 2u);
+    EXPECT_EQ(parsed.Txid(tx), bi::DoubleSha256({view(segwit_stripped_)}));
+    EXPECT_EQ(parsed.Wtxid(tx), bi::DoubleSha256({view(segwit_tx_)}));
+    EXPECT_NE(parsed.Txid(tx), parsed.Wtxid(tx));
+
+    const auto& input = parsed.Inputs().at(tx.first_input_);
+
+    EXPECT_TRUE(input.script_.empty());
+    EXPECT_EQ(input.sequence_, 0xfffffffeu);
+    EXPECT_EQ(input.first_witness_, 0u);
+    EXPECT_EQ(input.witness_count_, 2u);
+    EXPECT_EQ(parsed.Witnesses()[0], view(segwit_witness_1_));
+    EXPECT_EQ(parsed.Witnesses()[1], view(segwit_witness_2_));
+}
+
+TEST(Test_BlockView, offsets)
+{
+    const auto bytes =
+        block({legacy_tx_, segwit_tx_}, {legacy_tx_, segwit_stripped_});
+    auto parsed = bt::BlockView{};
+
+    ASSERT_TRUE(parsed.Parse(view(bytes)));
+
+    const auto* base = bytes.data();
+    const auto offset = [&](const ot::ReadView item) {
+        return static_cast<std::size_t>(item.data() - base);
+    };
+    const auto first = bt::BlockView::header_bytes_ + 1;
+    const auto second = first + legacy_tx_.size();
+    const auto& txs = parsed.Transactions();
+
+    EXPECT_EQ(offset(parsed.Header()), 0u);
+    EXPECT_EQ(parsed.Header().size(), bt::BlockView::header_bytes_);
+    EXPECT_EQ(offset(parsed.MerkleRoot()), 36u);
+    EXPECT_EQ(offset(txs[0].raw_), first);
+    EXPECT_EQ(offset(txs[0].body_), first + 4);
+    EXPECT_EQ(offset(txs[0].lock_time_field_), second - 4);
+    EXPECT_EQ(offset(txs[1].raw_), second);
+    // The marker and flag bytes are excluded from the txid preimage
+    EXPECT_EQ(offset(txs[1].version_field_), second);
+    EXPECT_EQ(offset(txs[1].body_), second + 6);
+    EXPECT_EQ(txs[1].body_, view(segwit_body_));
+    EXPECT_EQ(offset(parsed.Inputs()[0].outpoint_), first + 5);
+    EXPECT_EQ(offset(parsed.Inputs()[0].script_), first + 5 + 36 + 1);
+    EXPECT_EQ(offset(parsed.Witnesses()[0]), bytes.size() - 4 - 2 - 1 - 3);
+    EXPECT_EQ(offset(parsed.Witnesses()[1]), bytes.size() - 4 - 2);
+}
+
+TEST(Test_BlockView, truncated)
+{
+    const auto bytes =
+        block({legacy_tx_, segwit_tx_}, {legacy_tx_, segwit_stripped_});
+    auto parsed = bt::BlockView{};
+
+    for (std::size_t size{0}; size < bytes.size(); ++size) {
+        EXPECT_FALSE(parsed.Parse(ot::ReadView{bytes.data(), size}));
+        EXPECT_TRUE(parsed.Header().empty());
+        EXPECT_TRUE(parsed.Transactions().empty());
+        EXPECT_TRUE(parsed.Inputs().empty());
+        EXPECT_TRUE(parsed.Outputs().empty());
+        EXPECT_TRUE(parsed.Witnesses().empty());
+    }
+
+    EXPECT_FALSE(parsed.Parse(view(bytes + Bytes(1, '\x00'))));
+
+    // A transaction count larger than the remaining bytes could hold
+    auto oversized = bytes;
+    oversized[bt::BlockView::header_bytes_] = '\xfc';
+
+    EXPECT_FALSE(parsed.Parse(view(oversized)));
+
+    // A view which failed to parse can be reused for a valid block
+    EXPECT_TRUE(parsed.Parse(view(bytes)));
+    EXPECT_EQ(parsed.Transactions().size(), 2u);
+}
+
+TEST(Test_BlockView, materialize_matched)
+{
+    const auto& api = dynamic_cast<const ot::api::client::internal::Manager&>(
+        ot::Context().StartClient({}, 0));
+    const auto bytes =
+        block({legacy_tx_, segwit_tx_}, {legacy_tx_, segwit_stripped_});
+    auto parsed = bt::BlockView{};
+
+    ASSERT_TRUE(parsed.Parse(view(bytes)));
+
+    const auto element = [](const Bytes& in) {
+        return ot::Data::Factory(in.data(), in.size());
+    };
+    const auto none = parsed.Materialize(
+        api,
+        b::Type::Bitcoin,
+        bt::BlockView::Match({element(Bytes(32, '\x44'))}));
+
+    EXPECT_TRUE(none.empty());
+
+    const auto byOutput = parsed.Materialize(
+        api,
+        b::Type::Bitcoin,
+        bt::BlockView::Match({element(segwit_output_script_)}));
+
+    ASSERT_EQ(byOutput.size(), 1u);
+
+    const auto& segwit = *byOutput.front();
+
+    EXPECT_TRUE(segwit.hasWitnessData());
+    EXPECT_EQ(segwit.Version(), 2);
+    EXPECT_EQ(segwit.lockTime(), 5u);
+    ASSERT_EQ(segwit.inputs().size(), 1u);
+    ASSERT_EQ(segwit.outputs().size(), 1u);
+    ASSERT_EQ(segwit.witnesses().size(), 1u);
+    EXPECT_EQ(segwit.witnesses()[0].components().size(), 2u);
+    EXPECT_EQ(segwit.Encode()->Bytes(), view(segwit_tx_));
+
+    const auto byOutpoint = parsed.Materialize(
+        api,
+        b::Type::Bitcoin,
+        bt::BlockView::Match({element(legacy_outpoint_)}));
+
+    ASSERT_EQ(byOutpoint.size(), 1u);
+
+    const auto& legacy = *byOutpoint.front();
+
+    EXPECT_FALSE(legacy.hasWitnessData());
+    EXPECT_EQ(legacy.inputs()[0].Previous().second, 2u);
+    EXPECT_EQ(legacy.outputs().size(), 2u);
+    EXPECT_EQ(legacy.Encode()->Bytes(), view(legacy_tx_));
+}
+}  // namespace
@@ -43,6 +43,63 @@ TEST_F(Test_Filters, bloom_filter)
     EXPECT_TRUE(pFilter->Test(object4));
 }
 
+TEST_F(Test_Filters, blocked_bloom_filter)
+{
+    const auto count = std::size_t{1000};
+    auto present = std::vector<ot::OTData>{};
+    auto absent = std::vector<ot::OTData>{};
+
+    for (std::size_t i{0}; i < count; ++i) {
+        const auto in = std::to_string(i);
+        const auto out = std::to_string(i + count);
+        present.emplace_back(ot::Data::Factory(in.data(), in.size()));
+        absent.emplace_back(ot::Data::Factory(out.data(), out.size()));
+    }
+
+    ot::OTBloomFilter pFilter{
+        ot::Factory::BlockedBloomFilter(api_, 9873485, count, 0.001)};
+
+    for (const auto& element : present) { pFilter->AddElement(element); }
+
+    auto falsePositives = std::size_t{0};
+
+    for (std::size_t i{0}; i < count; ++i) {
+        EXPECT_TRUE(pFilter->Test(present.at(i)));
+
+        if (pFilter->Test(absent.at(i))) { ++falsePositives; }
+    }
+
+    EXPECT_LT(falsePositives, 20);
+    EXPECT_TRUE(pFilter->Test(present));
+    EXPECT_TRUE(pFilter->Test(std::vector<ot::OTData>{
+        absent.at(0), absent.at(1), present.at(count - 1)}));
+    EXPECT_FALSE(pFilter->Test(std::vector<ot::OTData>{}));
+
+    const auto serialized = pFilter->Serialize();
+    ot::OTBloomFilter pCopy{ot::Factory::BlockedBloomFilter(api_, serialized)};
+
+    EXPECT_EQ(serialized->asHex(), pCopy->Serialize()->asHex());
+
+    for (const auto& element : present) { EXPECT_TRUE(pCopy->Test(element)); }
+
+    // The hash function count is stored at the start of the trailer
+    using Trailer = ot::blockchain::internal::SerializedBloomFilter;
+    const auto offset = serialized->size() - sizeof(Trailer);
+
+    for (const std::uint32_t invalid : {0u, 17u, 0xffffffffu}) {
+        auto bytes = ot::Data::Factory(serialized);
+        auto count = boost::endian::little_uint32_buf_t{invalid};
+        std::memcpy(
+            static_cast<std::byte*>(bytes->data()) + offset,
+            &count,
+            sizeof(count));
+        const auto corrupt = std::unique_ptr<ot::blockchain::BloomFilter>{
+            ot::Factory::BlockedBloomFilter(api_, bytes)};
+
+        EXPECT_FALSE(corrupt);
+    }
+}
+
 TEST_F(Test_Filters, bitstreams)
 {
     namespace be = boost::endian;
@@ -79,6 +136,110 @@ TEST_F(Test_Filters, bitstreams)
     EXPECT_TRUE(o5 == v5);
 }
 
+TEST_F(Test_Filters, bitstreams_unary)
+{
+    auto data = ot::Data::Factory();
+
+    const std::uint64_t q1{0};
+    const std::uint64_t q2{5};
+    const std::uint64_t q3{63};
+    const std::uint64_t q4{64};
+    const std::uint64_t q5{200};
+    const std::uint64_t r1{524287};
+    const std::uint64_t r2{12345};
+
+    ot::blockchain::internal::BitWriter stream(data);
+
+    stream.write_unary(q1);
+    stream.write(19, r1);
+    stream.write_unary(q2);
+    stream.write_unary(q3);
+    stream.write(19, r2);
+    stream.write_unary(q4);
+    stream.write_unary(q5);
+    stream.write(19, r1);
+    stream.flush();
+
+    EXPECT_EQ(data->size(), (1 + 19 + 6 + 64 + 19 + 65 + 201 + 19 + 7) / 8);
+
+    ot::blockchain::internal::BitReader reader(data);
+
+    EXPECT_EQ(reader.read_unary(), q1);
+    EXPECT_EQ(reader.read(19), r1);
+    EXPECT_EQ(reader.read_unary(), q2);
+    EXPECT_EQ(reader.read_unary(), q3);
+    EXPECT_EQ(reader.read(19), r2);
+    EXPECT_EQ(reader.read_unary(), q4);
+    EXPECT_EQ(reader.read_unary(), q5);
+    EXPECT_EQ(reader.read(19), r1);
+}
+
+TEST_F(Test_Filters, siphash)
+{
+    namespace bc = ot::blockchain::internal;
+
+    // Reference vectors from the SipHash paper: key 00..0f, message of
+    // length i containing bytes 00..(i - 1)
+    const std::vector<std::uint64_t> expected{
+        0x726fdb47dd0e0e31,
+        0x74f839c593dc67fd,
+        0x0d6c8009d9a94f5a,
+        0x85676696d7fb7e2d,
+        0xcf2794e0277187b7,
+        0x18765564cd99a68d,
+        0xcbc9466e58fee3ce,
+        0xab0200f58b01d137,
+        0x93f5f5799a932462,
+        0x9e0082df0ba9e4b0,
+        0x7a5dbbc594ddb9f3,
+        0xf4b32f46226bada7,
+        0x751e8fbc860ee5fb,
+        0x14ea5627c0843d90,
+        0xf723ca908e7af2ee,
+        0xa129ca6149be45e5,
+        0x3f2acc7f57c29bdb,
+    };
+    auto key = std::string{};
+
+    for (auto i = char{0}; i < 16; ++i) { key.push_back(i); }
+
+    const auto hasher = bc::SipHasher{key};
+    auto message = std::string{};
+    auto messages = std::vector<ot::OTData>{};
+
+    for (const auto& hash : expected) {
+        EXPECT_EQ(hasher(message), hash);
+
+        messages.emplace_back(
+            ot::Data::Factory(message.data(), message.size()));
+        message.push_back(static_cast<char>(message.size()));
+    }
+
+    auto output = std::vector<std::uint64_t>{};
+    const auto range = std::uint64_t{784931};
+    hasher.HashToRange(messages, range, output);
+
+    ASSERT_EQ(output.size(), expected.size());
+
+    for (auto i = std::size_t{0}; i < expected.size(); ++i) {
+        EXPECT_EQ(output.at(i), bc::SipHasher::Reduce(expected.at(i), range));
+    }
+
+    EXPECT_EQ(bc::SipHasher::Reduce(0xffffffffffffffff, 0), 0);
+    EXPECT_EQ(
+        bc::SipHasher::Reduce(0xffffffffffffffff, 0xffffffffffffffff),
+        0xfffffffffffffffe);
+    EXPECT_EQ(bc::SipHasher::Reduce(0x8000000000000000, 10), 5);
+
+    auto password = api_.Factory().BinarySecret();
+    password->setMemory(key.data(), static_cast<std::uint32_t>(key.size()));
+    auto provider = std::uint64_t{};
+
+    EXPECT_TRUE(api_.Crypto().Hash().SipHash(
+        *password, messages.back(), provider, 2, 4));
+    EXPECT_EQ(provider, expected.back());
+}
+
 TEST_F(Test_Filters, gcs)
 {
     std::string s1("blah");
@@ -120,6 +281,57 @@ TEST_F(Test_Filters, gcs)
     EXPECT_FALSE(gcs.Test(excludedElements));
 }
 
+TEST_F(Test_Filters, gcs_batch_match)
+{
+    namespace bc = ot::blockchain::internal;
+
+    std::string s1("blah");
+    std::string s2("foo");
+    std::string s3("justus");
+    std::string s4("fellowtraveler");
+    std::string s5("islajames");
+    std::string s6("timewaitsfornoman");
+
+    const auto object1(ot::Data::Factory(s1.data(), s1.length()));
+    const auto object2(ot::Data::Factory(s2.data(), s2.length()));
+    const auto object3(ot::Data::Factory(s3.data(), s3.length()));
+    const auto object4(ot::Data::Factory(s4.data(), s4.length()));
+    const auto object5(ot::Data::Factory(s5.data(), s5.length()));
+    const auto object6(ot::Data::Factory(s6.data(), s6.length()));
+
+    std::array<std::byte, 16> keyA{};
+    std::array<std::byte, 16> keyB{};
+
+    for (std::size_t ii = 0; ii < 16; ii++) {
+        keyA[ii] = static_cast<std::byte>(1);
+        keyB[ii] = static_cast<std::byte>(ii);
+    }
+
+    std::unique_ptr<bc::GCS> pGcsA{
+        ot::Factory::GCS(api_, 19, 784931, keyA, {object1, object2})};
+    std::unique_ptr<bc::GCS> pGcsB{
+        ot::Factory::GCS(api_, 19, 784931, keyB, {object3, object4})};
+
+    ASSERT_TRUE(pGcsA);
+    ASSERT_TRUE(pGcsB);
+
+    const auto& gcsA = *pGcsA;
+    const auto& gcsB = *pGcsB;
+    const auto targetsA = bc::GCSTargets({object2, object5, object2});
+    const auto targetsB = bc::GCSTargets({object4, object6});
+    const auto targetsC = bc::GCSTargets({object5, object6});
+    auto scratch = bc::GCS::Scratch{};
+
+    EXPECT_EQ(targetsA.size(), 2);
+    EXPECT_TRUE(gcsA.Match(targetsA, scratch));
+    EXPECT_FALSE(gcsB.Match(targetsA, scratch));
+    EXPECT_FALSE(gcsA.Match(targetsB, scratch));
+    EXPECT_TRUE(gcsB.Match(targetsB, scratch));
+    EXPECT_FALSE(gcsA.Match(targetsC, scratch));
+    EXPECT_FALSE(gcsB.Match(targetsC, scratch));
+    EXPECT_FALSE(gcsA.Match({}, scratch));
+}
+
 TEST_F(Test_Filters, bip158_headers)
 {
     namespace bc = ot::blockchain::internal;
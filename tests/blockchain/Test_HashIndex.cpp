@@ -0,0 +1,101 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "OTTestEnvironment.hpp"
+
+#include "api/client/blockchain/HashIndex.hpp"
+
+namespace
+{
+template <typename Hash = std::hash<ot::ReadView>>
+using Index = ot::api::client::blockchain::implementation::
+    HashIndex<std::uint64_t, Hash>;
+
+// Sends every key to the same slot so each lookup walks the probe sequence
+struct Collide {
+    auto operator()(const ot::ReadView) const noexcept -> std::size_t
+    {
+        return 7;
+    }
+};
+
+auto key(const std::uint64_t value) -> std::string
+{
+    return std::string{"key "} + std::to_string(value);
+}
+
+TEST(Test_HashIndex, lookup_miss)
+{
+    auto index = Index<>{};
+
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_FALSE(index.Find("missing").has_value());
+    EXPECT_FALSE(index.Find("").has_value());
+    EXPECT_TRUE(index.Add("present", 1));
+    EXPECT_FALSE(index.Find("missing").has_value());
+    EXPECT_FALSE(index.Find("presen").has_value());
+    EXPECT_FALSE(index.Find("present ").has_value());
+    EXPECT_EQ(index.Find("present").value_or(0), 1u);
+}
+
+TEST(Test_HashIndex, duplicate)
+{
+    auto index = Index<>{};
+
+    EXPECT_TRUE(index.Add("key", 1));
+    EXPECT_FALSE(index.Add("key", 2));
+    EXPECT_EQ(index.size(), 1u);
+    EXPECT_EQ(index.Find("key").value_or(0), 1u);
+}
+
+TEST(Test_HashIndex, collisions)
+{
+    auto index = Index<Collide>{};
+    constexpr auto count = std::uint64_t{40};
+
+    for (auto i = std::uint64_t{0}; i < count; ++i) {
+        EXPECT_TRUE(index.Add(key(i), i));
+    }
+
+    EXPECT_EQ(index.size(), count);
+
+    for (auto i = std::uint64_t{0}; i < count; ++i) {
+        const auto found = index.Find(key(i));
+
+        ASSERT_TRUE(found.has_value());
+        EXPECT_EQ(found.value(), i);
+    }
+
+    EXPECT_FALSE(index.Find(key(count)).has_value());
+    EXPECT_FALSE(index.Add(key(0), count));
+}
+
+TEST(Test_HashIndex, growth)
+{
+    auto index = Index<>{};
+    constexpr auto count = std::uint64_t{10000};
+
+    for (auto i = std::uint64_t{0}; i < count; ++i) {
+        ASSERT_TRUE(index.Add(key(i), i));
+
+        // Entries added before any resize must remain reachable
+        if (0 == (i % 1000)) {
+            for (auto j = std::uint64_t{0}; j <= i; j += 97) {
+                EXPECT_EQ(index.Find(key(j)).value_or(count), j);
+            }
+        }
+    }
+
+    EXPECT_EQ(index.size(), count);
+
+    for (auto i = std::uint64_t{0}; i < count; ++i) {
+        EXPECT_EQ(index.Find(key(i)).value_or(count), i);
+    }
+
+    for (auto i = count; i < 2 * count; ++i) {
+        EXPECT_FALSE(index.Find(key(i)).has_value());
+    }
+}
+}  // namespace
@@ -0,0 +1,147 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "OTTestEnvironment.hpp"
+
+#include "api/client/blockchain/database/Database.hpp"
+
+namespace b = ot::blockchain;
+namespace bp = b::p2p;
+
+namespace
+{
+using Database = ot::api::client::blockchain::database::implementation::
+    Database;
+
+class Test_PeerDatabase : public ::testing::Test
+{
+public:
+    const ot::api::client::internal::Manager& api_;
+    const Database& db_;
+
+    auto add(
+        const b::Type chain,
+        const std::uint8_t last,
+        const std::set<bp::Service>& services = {}) const -> ot::OTIdentifier
+    {
+        const auto bytes = std::array<std::uint8_t, 4>{{10, 0, 0, last}};
+        auto address = ot::Factory::BlockchainAddress(
+            api_,
+            bp::Protocol::bitcoin,
+            bp::Network::ipv4,
+            ot::Data::Factory(bytes.data(), bytes.size()),
+            18333,
+            chain,
+            ot::Clock::now(),
+            services);
+
+        EXPECT_TRUE(address);
+
+        auto output = ot::Identifier::Factory(address->ID());
+
+        EXPECT_TRUE(db_.AddOrUpdate(std::move(address)));
+
+        return output;
+    }
+
+    auto find(
+        const b::Type chain,
+        const std::set<bp::Service>& services,
+        const std::set<ot::OTIdentifier>& exclude) const -> std::string
+    {
+        const auto address = db_.Find(
+            chain,
+            bp::Protocol::bitcoin,
+            {bp::Network::ipv4},
+            services,
+            exclude);
+
+        return address ? address->ID().str() : std::string{};
+    }
+
+    auto score(
+        const ot::Identifier& id,
+        const std::uint32_t handshakes,
+        const std::uint32_t failures,
+        const std::uint32_t misbehavior = 0) const -> void
+    {
+        auto session = b::client::internal::PeerScore{};
+        session.handshakes_ = handshakes;
+        session.failures_ = failures;
+        session.misbehavior_ = misbehavior;
+
+        EXPECT_TRUE(db_.Score(id, session));
+    }
+
+    Test_PeerDatabase()
+        : api_(dynamic_cast<const ot::api::client::internal::Manager&>(
+              ot::Context().StartClient({}, 0)))
+        , db_(dynamic_cast<const ot::api::client::internal::Blockchain&>(
+                  api_.Blockchain())
+                  .BlockchainDB())
+    {
+    }
+};
+
+TEST_F(Test_PeerDatabase, ranking)
+{
+    constexpr auto chain{b::Type::Bitcoin_testnet3};
+    const auto alpha = add(chain, 1, {bp::Service::CompactFilters});
+    const auto bravo = add(chain, 2);
+    const auto charlie = add(chain, 3);
+    const auto delta = add(chain, 4);
+    score(alpha, 1, 0);
+    score(bravo, 3, 0);
+    score(charlie, 0, 1);
+    // A misbehaving peer is banned regardless of its other results
+    score(delta, 10, 0, 1);
+
+    EXPECT_EQ(find(chain, {}, {}), bravo->str());
+
+    // Only a peer advertising every requested service may be chosen
+    EXPECT_EQ(find(chain, {bp::Service::CompactFilters}, {}), alpha->str());
+    EXPECT_EQ(
+        find(chain, {bp::Service::CompactFilters, bp::Service::Bloom}, {}),
+        "");
+
+    // A later session changes the ranking
+    score(alpha, 5, 0);
+
+    EXPECT_EQ(find(chain, {}, {}), alpha->str());
+}
+
+TEST_F(Test_PeerDatabase, exclusion)
+{
+    constexpr auto chain{b::Type::BitcoinCash_testnet3};
+    const auto alpha = add(chain, 11);
+    const auto bravo = add(chain, 12);
+    score(alpha, 50, 0);
+    score(bravo, 40, 0);
+
+    const auto best = find(chain, {}, {});
+
+    EXPECT_EQ(best, alpha->str());
+
+    // Connected peers are passed as exclusions so the same address is never
+    // returned twice in a row
+    const auto next = find(chain, {}, {alpha});
+
+    EXPECT_FALSE(next.empty());
+    EXPECT_NE(next, alpha->str());
+
+    auto all = std::set<ot::OTIdentifier>{};
+
+    for (auto id = find(chain, {}, all); false == id.empty();
+         id = find(chain, {}, all)) {
+        EXPECT_EQ(0u, all.count(ot::Identifier::Factory(id)));
+
+        all.emplace(ot::Identifier::Factory(id));
+    }
+
+    EXPECT_GE(all.size(), 2u);
+    EXPECT_EQ(1u, all.count(alpha));
+    EXPECT_EQ(1u, all.count(bravo));
+}
+}  // namespace
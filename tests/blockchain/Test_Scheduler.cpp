@@ -0,0 +1,155 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "OTTestEnvironment.hpp"
+
+#include "blockchain/client/Scheduler.hpp"
+
+namespace b = ot::blockchain;
+namespace bci = b::client::implementation;
+
+namespace
+{
+using Scheduler = bci::Scheduler;
+using Task = Scheduler::Task;
+
+class Test_Scheduler : public ::testing::Test
+{
+public:
+    static constexpr auto filter_{b::filter::Type::Basic_BIP158};
+
+    Scheduler scheduler_;
+    const ot::Time now_;
+
+    static auto hash(const std::uint8_t fill) -> ot::OTData
+    {
+        auto bytes = std::array<std::uint8_t, 32>{};
+        bytes.fill(fill);
+
+        return ot::Data::Factory(bytes.data(), bytes.size());
+    }
+
+    auto queue(const std::uint8_t fill) -> void
+    {
+        scheduler_.Queue(Task::Getcfilters, filter_, fill, hash(fill));
+    }
+
+    Test_Scheduler()
+        : scheduler_()
+        , now_(ot::Clock::now())
+    {
+    }
+};
+
+TEST_F(Test_Scheduler, assignment)
+{
+    scheduler_.AddPeer(1, Task::Getcfilters);
+    scheduler_.AddPeer(2, Task::Getcfilters);
+    scheduler_.AddPeer(3, Task::Getcfheaders);
+
+    for (std::uint8_t i{1}; i < 7; ++i) { queue(i); }
+
+    // Queueing the same stop hash twice does not create another unit
+    queue(1);
+
+    EXPECT_EQ(scheduler_.Backlog(), 6u);
+
+    const auto assigned = scheduler_.Assign(now_);
+    auto count = std::map<int, std::size_t>{};
+
+    for (const auto& [peer, unit] : assigned) {
+        EXPECT_EQ(peer, unit.peer_);
+        EXPECT_EQ(unit.type_, Task::Getcfilters);
+        EXPECT_EQ(unit.attempts_, 1u);
+        ++count[peer];
+    }
+
+    // Each capable peer is filled to its limit and the peer which can not
+    // serve cfilters gets nothing
+    EXPECT_EQ(assigned.size(), 2 * Scheduler::max_outstanding_);
+    EXPECT_EQ(count.at(1), Scheduler::max_outstanding_);
+    EXPECT_EQ(count.at(2), Scheduler::max_outstanding_);
+    EXPECT_EQ(count.count(3), 0u);
+    EXPECT_TRUE(scheduler_.Assign(now_).empty());
+
+    const auto& [peer, unit] = assigned.front();
+    const auto later = now_ + std::chrono::seconds(1);
+
+    EXPECT_FALSE(
+        scheduler_.Received(peer, Task::Getcfheaders, unit.stop_, 1, later));
+    EXPECT_TRUE(
+        scheduler_.Received(peer, Task::Getcfilters, unit.stop_, 1, later));
+    EXPECT_EQ(scheduler_.Backlog(), 5u);
+
+    const auto next = scheduler_.Assign(later);
+
+    ASSERT_EQ(next.size(), 1u);
+    EXPECT_EQ(next.front().first, peer);
+}
+
+TEST_F(Test_Scheduler, timeout_reassignment)
+{
+    scheduler_.AddPeer(1, Task::Getcfilters);
+    scheduler_.AddPeer(2, Task::Getcfilters);
+    queue(1);
+
+    const auto first = scheduler_.Assign(now_);
+
+    ASSERT_EQ(first.size(), 1u);
+
+    const auto original = first.front().first;
+
+    EXPECT_TRUE(scheduler_.Assign(now_ + std::chrono::seconds(1)).empty());
+
+    const auto expired =
+        now_ + Scheduler::minimum_timeout_ + std::chrono::seconds(1);
+    const auto second = scheduler_.Assign(expired);
+
+    ASSERT_EQ(second.size(), 1u);
+
+    const auto& [peer, unit] = second.front();
+
+    EXPECT_NE(peer, original);
+    EXPECT_EQ(unit.previous_, original);
+    EXPECT_EQ(unit.attempts_, 2u);
+    EXPECT_EQ(scheduler_.Backlog(), 1u);
+
+    // A late reply from the original peer still carries the requested data,
+    // so it completes the unit and the reply from the new assignee is then
+    // ignored
+    EXPECT_TRUE(scheduler_.Received(
+        original, Task::Getcfilters, unit.stop_, 1, expired));
+    EXPECT_EQ(scheduler_.Backlog(), 0u);
+    EXPECT_FALSE(
+        scheduler_.Received(peer, Task::Getcfilters, unit.stop_, 1, expired));
+}
+
+TEST_F(Test_Scheduler, peer_disconnect)
+{
+    scheduler_.AddPeer(1, Task::Getcfilters);
+    queue(1);
+    queue(2);
+
+    const auto first = scheduler_.Assign(now_);
+
+    ASSERT_EQ(first.size(), 2u);
+
+    // Units held by a disconnected peer wait until another peer is available
+    scheduler_.RemovePeer(1);
+
+    EXPECT_EQ(scheduler_.Backlog(), 2u);
+    EXPECT_TRUE(scheduler_.Assign(now_).empty());
+
+    scheduler_.AddPeer(2, Task::Getcfilters);
+    const auto second = scheduler_.Assign(now_);
+
+    ASSERT_EQ(second.size(), 2u);
+
+    for (const auto& [peer, unit] : second) {
+        EXPECT_EQ(peer, 2);
+        EXPECT_EQ(unit.previous_, 1);
+    }
+}
+}  // namespace
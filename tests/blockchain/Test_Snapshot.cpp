@@ -0,0 +1,271 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "OTTestEnvironment.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace b = ot::blockchain;
+namespace bb = b::block;
+namespace bc = b::client;
+
+namespace
+{
+class Test_Snapshot : public ::testing::Test
+{
+public:
+    using Header = bc::internal::SnapshotHeader;
+    using Record = bc::internal::SnapshotRecord;
+
+    const std::string path_;
+
+    static auto make_header(const std::uint64_t count) -> Header
+    {
+        auto output = Header{};
+        output.magic_ = bc::internal::Snapshot::magic_;
+        output.chain_ = static_cast<std::uint32_t>(b::Type::BitcoinCash);
+        output.filter_ =
+            static_cast<std::uint32_t>(b::filter::Type::Basic_BCHVariant);
+        output.start_ = 1;
+        output.count_ = count;
+
+        return output;
+    }
+
+    static auto make_record(const std::uint8_t fill) -> Record
+    {
+        auto output = Record{};
+        output.header_.fill(fill);
+        output.filter_hash_.fill(static_cast<std::uint8_t>(fill + 1));
+        output.filter_header_.fill(static_cast<std::uint8_t>(fill + 2));
+
+        return output;
+    }
+
+    auto write(const Header& header, const std::vector<Record>& records) const
+        -> void
+    {
+        auto file = std::ofstream{path_, std::ios::binary | std::ios::trunc};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        for (const auto& record : records) {
+            file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        }
+    }
+
+    Test_Snapshot()
+        : path_(::testing::TempDir() + "opentxs-test-snapshot")
+    {
+    }
+
+    ~Test_Snapshot() override { std::remove(path_.c_str()); }
+};
+
+TEST_F(Test_Snapshot, missing_file)
+{
+    std::remove(path_.c_str());
+
+    EXPECT_FALSE(ot::Factory::BlockchainSnapshot(path_));
+}
+
+TEST_F(Test_Snapshot, valid_file)
+{
+    write(make_header(2), {make_record(1), make_record(4)});
+    const auto pSnapshot = ot::Factory::BlockchainSnapshot(path_);
+
+    ASSERT_TRUE(pSnapshot);
+
+    const auto& snapshot = *pSnapshot;
+
+    EXPECT_EQ(snapshot.Chain(), b::Type::BitcoinCash);
+    EXPECT_EQ(snapshot.FilterType(), b::filter::Type::Basic_BCHVariant);
+    EXPECT_EQ(snapshot.Start(), 1);
+    EXPECT_EQ(snapshot.Count(), 2u);
+    EXPECT_EQ(snapshot.Height(1), 2);
+    EXPECT_EQ(snapshot.Record(0).header_.front(), 1);
+    EXPECT_EQ(snapshot.Record(1).filter_hash_.front(), 5);
+    EXPECT_EQ(snapshot.Record(1).filter_header_.back(), 6);
+}
+
+TEST_F(Test_Snapshot, truncated_file)
+{
+    write(make_header(3), {make_record(1), make_record(4)});
+
+    EXPECT_FALSE(ot::Factory::BlockchainSnapshot(path_));
+}
+
+TEST_F(Test_Snapshot, invalid_magic)
+{
+    auto header = make_header(1);
+    header.magic_.fill(0);
+    write(header, {make_record(1)});
+
+    EXPECT_FALSE(ot::Factory::BlockchainSnapshot(path_));
+}
+
+TEST_F(Test_Snapshot, genesis_start)
+{
+    auto header = make_header(1);
+    header.start_ = 0;
+    write(header, {make_record(1)});
+
+    EXPECT_FALSE(ot::Factory::BlockchainSnapshot(path_));
+}
+
+class Test_SnapshotImport : public Test_Snapshot
+{
+public:
+    // Bitcoin mainnet blocks 1 through 6
+    static const std::vector<std::string> headers_;
+    // Basic_BIP158 filter header of the Bitcoin genesis block
+    static const std::string genesis_filter_header_;
+
+    const ot::api::client::internal::Manager& api_;
+    std::unique_ptr<bc::internal::Network> network_;
+    bc::internal::HeaderOracle& header_oracle_;
+    const bc::internal::FilterOracle& filter_oracle_;
+
+    auto make_snapshot(const b::filter::Type type) const -> void
+    {
+        auto header = make_header(headers_.size());
+        header.chain_ = static_cast<std::uint32_t>(b::Type::Bitcoin);
+        header.filter_ = static_cast<std::uint32_t>(type);
+        auto records = std::vector<Record>{};
+        auto previous =
+            ot::Data::Factory(genesis_filter_header_, ot::Data::Mode::Hex);
+
+        for (const auto& hex : headers_) {
+            auto& record = records.emplace_back(make_record(
+                static_cast<std::uint8_t>(records.size() * 3)));
+            const auto raw = ot::Data::Factory(hex, ot::Data::Mode::Hex);
+
+            EXPECT_EQ(raw->size(), record.header_.size());
+
+            std::memcpy(record.header_.data(), raw->data(), raw->size());
+            const auto filterHeader = b::internal::FilterHashToHeader(
+                api_,
+                {reinterpret_cast<const char*>(record.filter_hash_.data()),
+                 record.filter_hash_.size()},
+                previous->Bytes());
+
+            EXPECT_EQ(filterHeader->size(), record.filter_header_.size());
+
+            std::memcpy(
+                record.filter_header_.data(),
+                filterHeader->data(),
+                filterHeader->size());
+            previous = filterHeader;
+        }
+
+        write(header, records);
+    }
+
+    auto block_hash(const std::size_t index) const -> bb::pHash
+    {
+        const auto raw =
+            ot::Data::Factory(headers_.at(index), ot::Data::Mode::Hex);
+
+        return api_.Factory().BlockHeader(b::Type::Bitcoin, raw)->Hash();
+    }
+
+    Test_SnapshotImport()
+        : Test_Snapshot()
+        , api_(dynamic_cast<const ot::api::client::internal::Manager&>(
+              ot::Context().StartClient({}, 0)))
+        , network_(ot::Factory::BlockchainNetworkBitcoin(
+              api_,
+              dynamic_cast<const ot::api::client::internal::Blockchain&>(
+                  api_.Blockchain()),
+              b::Type::Bitcoin,
+              "do not init peers",
+              "inproc://empty"))
+        , header_oracle_(dynamic_cast<bc::internal::HeaderOracle&>(
+              network_->HeaderOracle()))
+        , filter_oracle_(network_->FilterOracle())
+    {
+    }
+};
+
+// clang-format off
+const std::vector<std::string> Test_SnapshotImport::headers_{
+    {"010000006fe28c0ab6f1b372c1a6a246ae63f74f931e8365e15a089c68d6190000000000982051fd1e4ba744bbbe680e1fee14677ba1a3c3540bf7b1cdb606e857233e0e61bc6649ffff001d01e36299"},
+    {"010000004860eb18bf1b1620e37e9490fc8a427514416fd75159ab86688e9a8300000000d5fdcc541e25de1c7a5addedf24858b8bb665c9f36ef744ee42c316022c90f9bb0bc6649ffff001d08d2bd61"},
+    {"01000000bddd99ccfda39da1b108ce1a5d70038d0a967bacb68b6b63065f626a0000000044f672226090d85db9a9f2fbfe5f0f9609b387af7be5b7fbb7a1767c831c9e995dbe6649ffff001d05e0ed6d"},
+    {"010000004944469562ae1c2c74d9a535e00b6f3e40ffbad4f2fda3895501b582000000007a06ea98cd40ba2e3288262b28638cec5337c1456aaf5eedc8e9e5a20f062bdf8cc16649ffff001d2bfee0a9"},
+    {"0100000085144a84488ea88d221c8bd6c059da090e88f8a2c99690ee55dbba4e00000000e11c48fecdd9e72510ca84f023370c9a38bf91ac5cae88019bee94d24528526344c36649ffff001d1d03e477"},
+    {"01000000fc33f596f822a0a1951ffdbf2a897b095636ad871707bf5d3162729b00000000379dfb96a5ea8c81700ea4ac6b97ae9a9312b2d4301a29580e924ee6761a2520adc46649ffff001d189c4c97"},
+};
+// clang-format on
+
+const std::string Test_SnapshotImport::genesis_filter_header_{
+    "9f3c30f0c37fb977cf3e1a3173c631e8ff119ad3088b6f5b2bced0802139c202"};
+
+TEST_F(Test_SnapshotImport, reject_checkpoint_mismatch)
+{
+    make_snapshot(b::filter::Type::Basic_BIP158);
+    const auto pSnapshot = ot::Factory::BlockchainSnapshot(path_);
+
+    ASSERT_TRUE(pSnapshot);
+    ASSERT_TRUE(header_oracle_.AddCheckpoint(3, block_hash(3)));
+    EXPECT_FALSE(header_oracle_.ImportSnapshot(*pSnapshot));
+    EXPECT_EQ(header_oracle_.BestChain().first, 0);
+    EXPECT_TRUE(header_oracle_.DeleteCheckpoint());
+}
+
+TEST_F(Test_SnapshotImport, reject_unreached_checkpoint)
+{
+    make_snapshot(b::filter::Type::Basic_BIP158);
+    const auto pSnapshot = ot::Factory::BlockchainSnapshot(path_);
+
+    ASSERT_TRUE(pSnapshot);
+    ASSERT_TRUE(header_oracle_.AddCheckpoint(100, block_hash(0)));
+    EXPECT_FALSE(header_oracle_.ImportSnapshot(*pSnapshot));
+    EXPECT_EQ(header_oracle_.BestChain().first, 0);
+    EXPECT_TRUE(header_oracle_.DeleteCheckpoint());
+}
+
+TEST_F(Test_SnapshotImport, import_headers)
+{
+    make_snapshot(b::filter::Type::Basic_BIP158);
+    const auto pSnapshot = ot::Factory::BlockchainSnapshot(path_);
+
+    ASSERT_TRUE(pSnapshot);
+    EXPECT_TRUE(header_oracle_.ImportSnapshot(*pSnapshot));
+
+    const auto [height, hash] = header_oracle_.BestChain();
+
+    EXPECT_EQ(height, headers_.size());
+    EXPECT_EQ(hash, block_hash(headers_.size() - 1));
+}
+
+TEST_F(Test_SnapshotImport, reject_wrong_filter_type)
+{
+    make_snapshot(b::filter::Type::Basic_BCHVariant);
+    const auto pSnapshot = ot::Factory::BlockchainSnapshot(path_);
+
+    ASSERT_TRUE(pSnapshot);
+    EXPECT_FALSE(filter_oracle_.ImportSnapshot(*pSnapshot));
+    EXPECT_EQ(
+        filter_oracle_.FilterHeaderTip(b::filter::Type::Basic_BIP158).first,
+        0);
+}
+
+TEST_F(Test_SnapshotImport, import_filter_headers)
+{
+    make_snapshot(b::filter::Type::Basic_BIP158);
+    const auto pSnapshot = ot::Factory::BlockchainSnapshot(path_);
+
+    ASSERT_TRUE(pSnapshot);
+    EXPECT_TRUE(filter_oracle_.ImportSnapshot(*pSnapshot));
+
+    const auto [height, hash] =
+        filter_oracle_.FilterHeaderTip(b::filter::Type::Basic_BIP158);
+
+    EXPECT_EQ(height, headers_.size());
+    EXPECT_EQ(hash, block_hash(headers_.size() - 1));
+}
+}  // namespace
@@ -0,0 +1,625 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "OTTestEnvironment.hpp"
+
+#include <boost/asio.hpp>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace b = ot::blockchain;
+namespace bb = b::block;
+namespace bc = b::client;
+
+using boost::asio::ip::tcp;
+using Clock = std::chrono::steady_clock;
+
+/*  Replays a recorded peer session to a syncing client and reports throughput
+ *
+ *  OT_BENCHMARK_RECORDING names a file of raw bitcoin wire protocol messages
+ *  (24 byte message header followed by the payload) sent by a full node
+ *  serving OT_BENCHMARK_CHAIN (btc, bch, tnbtc or tnbch, default bch). The
+ *  file must contain the node's version message plus the headers, cfheaders
+ *  and cfilter messages to replay, in any order. A capture of this client's
+ *  own sync session is the simplest source since cfheaders responses are
+ *  matched to requests by stop hash.
+ *
+ *  The fake peer listens on OT_BENCHMARK_ADDRESS (default 127.0.0.2) at the
+ *  default port of the chain, and that address is used as the seed node so
+ *  the client never contacts the real network. OT_BENCHMARK_TIMEOUT limits
+ *  the run time in seconds (default 3600).
+ *
+ *  The benchmark is not registered with ctest.
+ */
+
+namespace
+{
+enum class Stage : std::size_t {
+    headers = 0,
+    cfheaders = 1,
+    cfilters = 2,
+};
+
+struct Chain {
+    b::Type type_;
+    b::filter::Type filter_;
+    std::uint16_t port_;
+};
+
+struct Recording {
+    // block hashes in best chain order, starting with the genesis block
+    std::vector<std::string> hashes_{};
+    // raw 80 byte block headers, indexed the same way as hashes_
+    std::vector<std::string> headers_{};
+    std::map<std::string, bb::Height> heights_{};
+    // stop hash to wire message
+    std::map<std::string, std::string> cfheaders_{};
+    // block hash to wire message
+    std::map<std::string, std::string> cfilters_{};
+    std::array<char, 4> magic_{};
+    std::string version_{};
+    bb::Height cfheader_tip_{0};
+    bb::Height cfilter_tip_{0};
+};
+
+struct Event {
+    Stage stage_;
+    bb::Height height_;
+    Clock::time_point time_;
+};
+
+class Histogram
+{
+public:
+    static constexpr std::size_t buckets_{16};
+
+    auto Add(const Clock::duration latency) noexcept -> void
+    {
+        const auto ms =
+            std::chrono::duration_cast<std::chrono::milliseconds>(latency)
+                .count();
+        auto bucket = std::size_t{0};
+
+        while ((bucket + 1 < buckets_) && ((1 << bucket) <= ms)) { ++bucket; }
+
+        ++counts_.at(bucket);
+    }
+    auto Print(std::ostream& out) const noexcept -> void
+    {
+        for (auto i = std::size_t{0}; i < buckets_; ++i) {
+            if (0 == counts_.at(i)) { continue; }
+
+            out << "    < " << std::setw(6) << (1 << i)
+                << " ms: " << counts_.at(i) << '\n';
+        }
+    }
+
+private:
+    std::array<std::size_t, buckets_> counts_{};
+};
+
+const std::map<std::string, Chain> chains_{
+    {"btc", {b::Type::Bitcoin, b::filter::Type::Basic_BIP158, 8333}},
+    {"bch", {b::Type::BitcoinCash, b::filter::Type::Basic_BCHVariant, 8333}},
+    {"tnbtc",
+     {b::Type::Bitcoin_testnet3, b::filter::Type::Basic_BIP158, 18333}},
+    {"tnbch",
+     {b::Type::BitcoinCash_testnet3,
+      b::filter::Type::Basic_BCHVariant,
+      18333}},
+};
+const std::map<Stage, std::string> stage_names_{
+    {Stage::headers, "headers"},
+    {Stage::cfheaders, "cfheaders"},
+    {Stage::cfilters, "cfilters"},
+};
+constexpr auto header_batch_ = std::size_t{2000};
+constexpr auto message_header_size_ = std::size_t{24};
+
+auto env(const char* name, const std::string& fallback) -> std::string
+{
+    const auto* value = std::getenv(name);
+
+    return (nullptr == value) ? fallback : std::string{value};
+}
+
+auto read_compact(const char*& it, const char* end, std::uint64_t& out) -> bool
+{
+    if (it >= end) { return false; }
+
+    const auto first = static_cast<std::uint8_t>(*it++);
+    auto size = std::size_t{0};
+
+    switch (first) {
+        case 0xfd: {
+            size = 2;
+        } break;
+        case 0xfe: {
+            size = 4;
+        } break;
+        case 0xff: {
+            size = 8;
+        } break;
+        default: {
+            out = first;
+
+            return true;
+        }
+    }
+
+    if (static_cast<std::size_t>(end - it) < size) { return false; }
+
+    out = 0;
+
+    for (auto i = std::size_t{0}; i < size; ++i) {
+        out |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(it[i]))
+               << (8 * i);
+    }
+
+    it += size;
+
+    return true;
+}
+
+auto read_u32(const char* in) -> std::uint32_t
+{
+    auto output = std::uint32_t{0};
+
+    for (auto i = std::size_t{0}; i < 4; ++i) {
+        output |= static_cast<std::uint32_t>(static_cast<std::uint8_t>(in[i]))
+                  << (8 * i);
+    }
+
+    return output;
+}
+
+auto write_compact(std::string& out, const std::uint64_t value) -> void
+{
+    if (0xfd > value) {
+        out.push_back(static_cast<char>(value));
+    } else {
+        out.push_back(static_cast<char>(0xfd));
+        out.push_back(static_cast<char>(value & 0xff));
+        out.push_back(static_cast<char>((value >> 8) & 0xff));
+    }
+}
+
+class Benchmark_Sync : public ::testing::Test
+{
+public:
+    const ot::api::client::internal::Manager& api_;
+    Recording recording_;
+    std::mutex lock_;
+    std::vector<Event> events_;
+    std::map<Stage, Clock::time_point> first_request_;
+    std::atomic<bool> stop_;
+
+    auto checksum(const std::string& payload) const -> std::string
+    {
+        auto output = std::string{};
+        api_.Crypto().Hash().Digest(
+            ot::proto::HASHTYPE_SHA256D, payload, ot::writer(output));
+        output.resize(4);
+
+        return output;
+    }
+
+    auto hash(const std::string& header) const -> std::string
+    {
+        auto output = std::string{};
+        api_.Crypto().Hash().Digest(
+            ot::proto::HASHTYPE_SHA256D, header, ot::writer(output));
+
+        return output;
+    }
+
+    auto height(const std::string& hash) const -> bb::Height
+    {
+        const auto it = recording_.heights_.find(hash);
+
+        return (recording_.heights_.end() == it) ? -1 : it->second;
+    }
+
+    auto load(const std::string& path, const Chain& chain) -> bool
+    {
+        auto file = std::ifstream{path, std::ios::binary};
+        const auto data = std::string{
+            std::istreambuf_iterator<char>{file},
+            std::istreambuf_iterator<char>{}};
+        auto headers = std::map<std::string, std::string>{};
+        auto ranges = std::map<bb::Height, std::string>{};
+
+        for (auto offset = std::size_t{0};
+             message_header_size_ <= (data.size() - offset);) {
+            const auto* start = data.data() + offset;
+            const auto command =
+                std::string{start + 4, ::strnlen(start + 4, 12)};
+            const auto size = std::size_t{read_u32(start + 16)};
+
+            if ((data.size() - offset - message_header_size_) < size) { break; }
+
+            const auto wire =
+                std::string{start, message_header_size_ + size};
+            const auto* it = start + message_header_size_;
+            const auto* end = it + size;
+            offset += wire.size();
+            std::memcpy(recording_.magic_.data(), start, 4);
+
+            if ("version" == command) {
+                recording_.version_ = wire;
+            } else if ("headers" == command) {
+                auto count = std::uint64_t{0};
+                auto txCount = std::uint64_t{0};
+
+                if (false == read_compact(it, end, count)) { return false; }
+
+                for (auto i = std::uint64_t{0}; i < count; ++i) {
+                    if (80 > (end - it)) { return false; }
+
+                    auto header = std::string{it, 80};
+                    it += 80;
+
+                    if (false == read_compact(it, end, txCount)) {
+                        return false;
+                    }
+
+                    headers.emplace(header.substr(4, 32), std::move(header));
+                }
+            } else if ("cfheaders" == command) {
+                if (65 > size) { return false; }
+
+                recording_.cfheaders_.emplace(std::string{it + 1, 32}, wire);
+            } else if ("cfilter" == command) {
+                if (33 > size) { return false; }
+
+                recording_.cfilters_.emplace(std::string{it + 1, 32}, wire);
+            }
+        }
+
+        const auto& genesisHash =
+            bc::HeaderOracle::GenesisBlockHash(chain.type_);
+        const auto genesis = std::string{genesisHash.Bytes()};
+        recording_.hashes_.emplace_back(genesis);
+        recording_.headers_.emplace_back();
+        recording_.heights_.emplace(genesis, 0);
+
+        for (auto it = headers.find(genesis); headers.end() != it;
+             it = headers.find(recording_.hashes_.back())) {
+            const auto& header = it->second;
+            const auto next = hash(header);
+            recording_.heights_.emplace(next, recording_.hashes_.size());
+            recording_.hashes_.emplace_back(next);
+            recording_.headers_.emplace_back(header);
+        }
+
+        for (const auto& [stop, wire] : recording_.cfheaders_) {
+            const auto* it = wire.data() + message_header_size_ + 65;
+            auto count = std::uint64_t{0};
+            const auto last = height(stop);
+
+            if ((0 > last) ||
+                (false ==
+                 read_compact(it, wire.data() + wire.size(), count)) ||
+                (0 == count)) {
+                continue;
+            }
+
+            ranges.emplace(last - static_cast<bb::Height>(count) + 1, stop);
+        }
+
+        for (auto it = ranges.find(1); ranges.end() != it;
+             it = ranges.find(recording_.cfheader_tip_ + 1)) {
+            recording_.cfheader_tip_ = height(it->second);
+        }
+
+        for (auto i = std::size_t{1}; i < recording_.hashes_.size(); ++i) {
+            if (0 == recording_.cfilters_.count(recording_.hashes_.at(i))) {
+                break;
+            }
+
+            recording_.cfilter_tip_ = static_cast<bb::Height>(i);
+        }
+
+        return false == recording_.version_.empty();
+    }
+
+    auto message(const std::string& command, const std::string& payload) const
+        -> std::string
+    {
+        auto output = std::string{recording_.magic_.data(), 4};
+        auto name = command;
+        name.resize(12, '\0');
+        output += name;
+        const auto size = static_cast<std::uint32_t>(payload.size());
+
+        for (auto i = std::size_t{0}; i < 4; ++i) {
+            output.push_back(static_cast<char>((size >> (8 * i)) & 0xff));
+        }
+
+        output += checksum(payload);
+        output += payload;
+
+        return output;
+    }
+
+    auto record(const Stage stage, const bb::Height height) -> void
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        const auto now = Clock::now();
+        first_request_.emplace(stage, now);
+        events_.emplace_back(Event{stage, height, now});
+    }
+
+    // Returns the wire messages to send in reply to one received message
+    auto respond(const std::string& command, const std::string& payload)
+        -> std::vector<std::string>
+    {
+        auto output = std::vector<std::string>{};
+        const auto* it = payload.data();
+        const auto* end = it + payload.size();
+
+        if ("version" == command) {
+            output.emplace_back(recording_.version_);
+            output.emplace_back(message("verack", {}));
+        } else if ("ping" == command) {
+            output.emplace_back(message("pong", payload));
+        } else if ("getheaders" == command) {
+            auto count = std::uint64_t{0};
+            auto start = bb::Height{-1};
+            it += 4;
+
+            if (false == read_compact(it, end, count)) { return output; }
+
+            for (auto i = std::uint64_t{0}; (i < count) && (32 <= (end - it));
+                 ++i, it += 32) {
+                start = height(std::string{it, 32});
+
+                if (0 <= start) { break; }
+            }
+
+            auto reply = std::string{};
+            const auto first = static_cast<std::size_t>(start + 1);
+            const auto last = std::min(
+                first + header_batch_, recording_.headers_.size());
+            write_compact(reply, (0 > start) ? 0 : last - first);
+
+            for (auto i = first; (0 <= start) && (i < last); ++i) {
+                reply += recording_.headers_.at(i);
+                reply.push_back('\0');
+            }
+
+            output.emplace_back(message("headers", reply));
+
+            if ((0 <= start) && (last > first)) {
+                record(Stage::headers, static_cast<bb::Height>(last - 1));
+            }
+        } else if ("getcfheaders" == command) {
+            if (37 > payload.size()) { return output; }
+
+            const auto stop = std::string{it + 5, 32};
+            const auto found = recording_.cfheaders_.find(stop);
+
+            if (recording_.cfheaders_.end() != found) {
+                output.emplace_back(found->second);
+                record(Stage::cfheaders, height(stop));
+            }
+        } else if ("getcfilters" == command) {
+            if (37 > payload.size()) { return output; }
+
+            const auto start = static_cast<bb::Height>(read_u32(it + 1));
+            const auto stop = height(std::string{it + 5, 32});
+
+            for (auto i = start; (0 < i) && (i <= stop); ++i) {
+                const auto found = recording_.cfilters_.find(
+                    recording_.hashes_.at(static_cast<std::size_t>(i)));
+
+                if (recording_.cfilters_.end() == found) { break; }
+
+                output.emplace_back(found->second);
+            }
+
+            if (false == output.empty()) { record(Stage::cfilters, stop); }
+        }
+
+        return output;
+    }
+
+    auto serve(tcp::acceptor& acceptor) -> void
+    {
+        while (false == stop_) {
+            auto socket = tcp::socket{acceptor.get_executor()};
+            auto ec = boost::system::error_code{};
+            acceptor.accept(socket, ec);
+
+            if (ec || stop_) { return; }
+
+            auto header = std::string(message_header_size_, '\0');
+
+            while (false == stop_) {
+                boost::asio::read(socket, boost::asio::buffer(header), ec);
+
+                if (ec) { break; }
+
+                auto payload = std::string(read_u32(header.data() + 16), '\0');
+                boost::asio::read(socket, boost::asio::buffer(payload), ec);
+
+                if (ec) { break; }
+
+                const auto command = std::string{
+                    header.data() + 4, ::strnlen(header.data() + 4, 12)};
+
+                for (const auto& reply : respond(command, payload)) {
+                    boost::asio::write(socket, boost::asio::buffer(reply), ec);
+                }
+            }
+        }
+    }
+
+    Benchmark_Sync()
+        : api_(dynamic_cast<const ot::api::client::internal::Manager&>(
+              ot::Context().StartClient(OTTestEnvironment::test_args_, 0)))
+        , recording_()
+        , lock_()
+        , events_()
+        , first_request_()
+        , stop_(false)
+    {
+    }
+};
+
+TEST_F(Benchmark_Sync, replay)
+{
+    const auto path = env("OT_BENCHMARK_RECORDING", "");
+
+    if (path.empty()) {
+        std::cout << "OT_BENCHMARK_RECORDING is not set\n";
+
+        return;
+    }
+
+    const auto& chain = chains_.at(env("OT_BENCHMARK_CHAIN", "bch"));
+    const auto address = env("OT_BENCHMARK_ADDRESS", "127.0.0.2");
+    const auto timeout =
+        std::chrono::seconds{std::stoll(env("OT_BENCHMARK_TIMEOUT", "3600"))};
+
+    ASSERT_TRUE(load(path, chain));
+
+    const auto targets = std::map<Stage, bb::Height>{
+        {Stage::headers,
+         static_cast<bb::Height>(recording_.hashes_.size()) - 1},
+        {Stage::cfheaders, recording_.cfheader_tip_},
+        {Stage::cfilters, recording_.cfilter_tip_},
+    };
+    std::cout << "Replaying " << targets.at(Stage::headers) << " headers, "
+              << recording_.cfheader_tip_ << " cfheaders and "
+              << recording_.cfilter_tip_ << " cfilters\n";
+
+    auto context = boost::asio::io_context{};
+    auto acceptor = tcp::acceptor{
+        context,
+        tcp::endpoint{boost::asio::ip::make_address(address), chain.port_}};
+    auto server = std::thread{[&] { serve(acceptor); }};
+
+    ASSERT_TRUE(api_.Blockchain().Start(chain.type_, address));
+
+    const auto& network = dynamic_cast<const bc::internal::Network&>(
+        api_.Blockchain().GetChain(chain.type_));
+    const auto& filters = network.FilterOracle();
+    const auto tip = [&](const Stage stage) -> bb::Height {
+        switch (stage) {
+            case Stage::headers: {
+                return network.HeaderOracle().BestChain().first;
+            }
+            case Stage::cfheaders: {
+                return filters.FilterHeaderTip(chain.filter_).first;
+            }
+            case Stage::cfilters:
+            default: {
+                return filters.FilterTip(chain.filter_).first;
+            }
+        }
+    };
+    auto histograms = std::map<Stage, Histogram>{};
+    auto finished = std::map<Stage, Clock::time_point>{};
+    const auto begin = Clock::now();
+
+    while ((finished.size() < targets.size()) &&
+           ((Clock::now() - begin) < timeout)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        const auto now = Clock::now();
+        auto current = std::map<Stage, bb::Height>{};
+
+        for (const auto& [stage, target] : targets) {
+            current[stage] = tip(stage);
+
+            if ((current[stage] >= target) && (0 == finished.count(stage))) {
+                finished.emplace(stage, now);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(lock_);
+        auto it = events_.begin();
+
+        while (events_.end() != it) {
+            if (current.at(it->stage_) >= it->height_) {
+                histograms[it->stage_].Add(now - it->time_);
+                it = events_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    for (const auto& [stage, target] : targets) {
+        const auto& name = stage_names_.at(stage);
+        const auto reached = tip(stage);
+        std::cout << name << ": reached height " << reached << " of " << target;
+
+        if ((0 < finished.count(stage)) && (0 < first_request_.count(stage))) {
+            const auto elapsed = std::chrono::duration<double>(
+                finished.at(stage) - first_request_.at(stage));
+            std::cout << " in " << elapsed.count() << " s ("
+                      << (static_cast<double>(target) / elapsed.count())
+                      << " per second)";
+        }
+
+        std::cout << "\n  per batch latency:\n";
+        histograms[stage].Print(std::cout);
+    }
+
+    if (0 < recording_.cfilter_tip_) {
+        auto elements = std::vector<ot::OTData>{};
+
+        for (auto i = 0; i < 100; ++i) {
+            auto element = ot::Data::Factory();
+            element->Randomize(20);
+            elements.emplace_back(std::move(element));
+        }
+
+        const auto start = Clock::now();
+        filters.Match(chain.filter_, elements, 1, recording_.cfilter_tip_);
+        const auto elapsed =
+            std::chrono::duration<double>(Clock::now() - start);
+        std::cout << "rescan: " << recording_.cfilter_tip_ << " filters in "
+                  << elapsed.count() << " s ("
+                  << (static_cast<double>(recording_.cfilter_tip_) /
+                      elapsed.count())
+                  << " per second)\n";
+    }
+
+#ifndef _WIN32
+    auto usage = ::rusage{};
+    ::getrusage(RUSAGE_SELF, &usage);
+    std::cout << "peak RSS: " << usage.ru_maxrss << " kB\n";
+#endif
+
+    EXPECT_TRUE(api_.Blockchain().Stop(chain.type_));
+
+    stop_ = true;
+    // Wake the server thread if it is waiting for a connection
+    auto wake = tcp::socket{context};
+    auto ec = boost::system::error_code{};
+    wake.connect(acceptor.local_endpoint(), ec);
+    server.join();
+}
+}  // namespace
@@ -22,6 +22,35 @@ TEST_F(Test_HeaderOracle, stage_headers)
     }
 }
 
+TEST_F(Test_HeaderOracle, reject_invalid_work)
+{
+    auto headers = std::vector<std::unique_ptr<bb::Header>>{};
+
+    for (const auto& hex : bitcoin_) {
+        auto raw = ot::Data::Factory(hex, ot::Data::Mode::Hex);
+
+        if (headers.size() == (bitcoin_.size() / 2)) {
+            // Changing the nonce invalidates the proof of work
+            auto* nonce = static_cast<std::uint8_t*>(raw->data()) + 76;
+            *nonce ^= 0x01;
+        }
+
+        auto pHeader =
+            api_.Factory().BlockHeader(ot::blockchain::Type::Bitcoin, raw);
+
+        ASSERT_TRUE(pHeader);
+
+        headers.emplace_back(std::move(pHeader));
+    }
+
+    EXPECT_FALSE(headers.at(bitcoin_.size() / 2)->Valid());
+    EXPECT_FALSE(header_oracle_.AddHeaders(headers));
+
+    const auto [height, hash] = header_oracle_.BestChain();
+
+    EXPECT_EQ(height, 0);
+}
+
 TEST_F(Test_HeaderOracle, receive)
 {
     EXPECT_TRUE(header_oracle_.AddHeaders(headers_));
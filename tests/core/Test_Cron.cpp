@@ -0,0 +1,112 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "OTTestEnvironment.hpp"
+
+#include "opentxs/core/cron/OTCron.hpp"
+
+namespace
+{
+constexpr std::int64_t transaction_number_{1001};
+
+struct Cron : public ::testing::Test {
+    const ot::api::server::Manager& server_;
+    ot::OTPasswordPrompt reason_;
+    ot::Nym_p nym_;
+
+    auto load() const -> std::unique_ptr<ot::OTCron>
+    {
+        auto cron = server_.Factory().Cron();
+
+        EXPECT_TRUE(cron);
+
+        cron->SetServerNym(nym_);
+        cron->SetNotaryID(server_.ID());
+
+        return cron;
+    }
+
+    // Mimics the signature update a cron item makes after each round
+    auto resign(ot::OTCronItem& item) const -> void
+    {
+        item.ReleaseSignatures();
+
+        EXPECT_TRUE(item.SignContract(*nym_, reason_));
+        EXPECT_TRUE(item.SaveContract());
+    }
+
+    Cron()
+        : server_(
+              ot::Context().StartServer(OTTestEnvironment::test_args_, 0, true))
+        , reason_(server_.Factory().PasswordPrompt(__FUNCTION__))
+        , nym_(server_.Wallet().Nym(server_.NymID()))
+    {
+    }
+};
+
+TEST_F(Cron, modified_item_survives_reload)
+{
+    ASSERT_TRUE(nym_);
+
+    const auto start = ot::Clock::from_time_t(1500000000);
+    const auto original = ot::Clock::from_time_t(1600000000);
+    const auto modified = ot::Clock::from_time_t(1700000000);
+
+    {
+        auto plan = server_.Factory().PaymentPlan(
+            server_.ID(),
+            server_.Factory().UnitID(ot::Identifier::Random()->str()),
+            ot::Identifier::Random(),
+            server_.NymID(),
+            ot::Identifier::Random(),
+            server_.NymID());
+
+        ASSERT_TRUE(plan);
+
+        plan->SetTransactionNum(transaction_number_);
+
+        ASSERT_TRUE(plan->SetDateRange(start, original));
+        ASSERT_TRUE(plan->SetPaymentPlan(100));
+
+        resign(*plan);
+        auto cron = load();
+
+        ASSERT_TRUE(cron->AddCronItem(
+            std::shared_ptr<ot::OTCronItem>{plan.release()}, false, start));
+        EXPECT_TRUE(cron->SaveCron());
+    }
+
+    {
+        auto cron = load();
+
+        ASSERT_TRUE(cron->LoadCron());
+
+        auto item = cron->GetItemByOfficialNum(transaction_number_);
+
+        ASSERT_TRUE(item);
+        EXPECT_EQ(item->GetValidTo(), original);
+
+        // The item was loaded from its own file, so the cron object already
+        // holds a digest for it. Once marked, saving must notice the change.
+        ASSERT_TRUE(item->SetDateRange(start, modified));
+
+        resign(*item);
+        cron->MarkDirty(transaction_number_);
+
+        EXPECT_TRUE(cron->SaveCron());
+    }
+
+    {
+        auto cron = load();
+
+        ASSERT_TRUE(cron->LoadCron());
+
+        const auto item = cron->GetItemByOfficialNum(transaction_number_);
+
+        ASSERT_TRUE(item);
+        EXPECT_EQ(item->GetValidTo(), modified);
+    }
+}
+}  // namespace
@@ -574,6 +574,72 @@ public:
 
         return true;
     }
+
+    bool test_bip32_public_child(const ot::crypto::Bip32& library)
+    {
+        const auto hard = ot::Bip32Index{
+            static_cast<ot::Bip32Index>(ot::Bip32Child::HARDENED)};
+
+        for (const auto& testVector : bip_32_) {
+            const auto& [hex, cases] = testVector;
+
+            for (const auto& testCase : cases) {
+                const auto& rawPath = std::get<0>(testCase);
+
+                if (rawPath.empty() || (hard <= rawPath.back())) { continue; }
+
+                const auto pSeed = get_seed(hex);
+                const auto& seed = *pSeed;
+                const auto parentPath =
+                    Path{rawPath.begin(), std::prev(rawPath.end())};
+                const auto parent = library.DeriveKey(
+                    ot::EcdsaCurve::secp256k1, seed, parentPath);
+                const auto expected =
+                    library.DeriveKey(ot::EcdsaCurve::secp256k1, seed, rawPath);
+                const auto derived = library.DerivePublic(
+                    ot::EcdsaCurve::secp256k1, parent, {rawPath.back()});
+                const auto& [ePrv, eCode, ePub, ePath, eParent] = expected;
+                const auto& [dPrv, dCode, dPub, dPath, dParent] = derived;
+
+                EXPECT_EQ(0, dPrv.getMemorySize());
+                EXPECT_EQ(ePub.get(), dPub.get());
+                EXPECT_EQ(
+                    ot::Data::Factory(eCode.getMemory(), eCode.getMemorySize())
+                        .get(),
+                    ot::Data::Factory(dCode.getMemory(), dCode.getMemorySize())
+                        .get());
+                EXPECT_EQ(ePath, dPath);
+                EXPECT_EQ(eParent, dParent);
+
+                constexpr auto batch = std::size_t{4};
+                auto keys = ot::Space{};
+
+                EXPECT_TRUE(library.DerivePublic(
+                    ot::EcdsaCurve::secp256k1,
+                    parent,
+                    rawPath.back(),
+                    batch,
+                    ot::writer(keys)));
+                EXPECT_EQ(batch * 33, keys.size());
+
+                if (batch * 33 != keys.size()) { continue; }
+
+                for (std::size_t i{0}; i < batch; ++i) {
+                    const auto child = library.DerivePublic(
+                        ot::EcdsaCurve::secp256k1,
+                        parent,
+                        {rawPath.back() + static_cast<ot::Bip32Index>(i)});
+                    const auto& pub = std::get<2>(child);
+
+                    EXPECT_EQ(
+                        pub.get(),
+                        ot::Data::Factory(&keys.at(i * 33), 33).get());
+                }
+            }
+        }
+
+        return true;
+    }
 #endif
 
     bool test_bip39(const ot::crypto::Bip32& library)
@@ -623,6 +689,7 @@ TEST_F(Test_Bitcoin_Providers, Common)
 #if OT_CRYPTO_WITH_BIP32
     EXPECT_TRUE(test_bip32_seed(crypto_.BIP32()));
     EXPECT_TRUE(test_bip32_child_key(crypto_.BIP32()));
+    EXPECT_TRUE(test_bip32_public_child(crypto_.BIP32()));
 #endif  // OT_CRYPTO_WITH_BIP32
 }
 }  // namespace
@@ -0,0 +1,119 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "OTTestEnvironment.hpp"
+
+#include "api/server/BoxCache.hpp"
+
+#include <string>
+
+namespace
+{
+using BoxCache = ot::api::server::implementation::BoxCache;
+
+auto cached(const BoxCache& cache, const std::string& location) -> bool
+{
+    auto contents = std::string{};
+
+    return cache.Load(location, contents);
+}
+
+TEST(Test_BoxCache, eviction_order)
+{
+    const auto cache = BoxCache{10, 10};
+    cache.Store("a", "aaaa");
+    cache.Store("b", "bbbb");
+
+    // Loading a box makes it the most recently used
+    ASSERT_TRUE(cached(cache, "a"));
+
+    cache.Store("c", "cccc");
+
+    EXPECT_TRUE(cached(cache, "a"));
+    EXPECT_FALSE(cached(cache, "b"));
+    EXPECT_TRUE(cached(cache, "c"));
+
+    // Filling the cache exactly to the limit evicts nothing
+    cache.Store("d", "dd");
+
+    EXPECT_TRUE(cached(cache, "a"));
+    EXPECT_TRUE(cached(cache, "c"));
+    EXPECT_TRUE(cached(cache, "d"));
+
+    // A box larger than the limit is never cached
+    cache.Store("e", std::string(11, 'e'));
+
+    EXPECT_FALSE(cached(cache, "e"));
+    EXPECT_TRUE(cached(cache, "a"));
+}
+
+TEST(Test_BoxCache, replace_and_erase)
+{
+    const auto cache = BoxCache{10, 10};
+    cache.Store("a", "aaaaaa");
+    cache.Store("b", "bbbb");
+
+    // Replacing a box only counts the new contents, so c fits without
+    // evicting anything
+    cache.Store("a", "aa");
+    cache.Store("c", "cccc");
+
+    auto contents = std::string{};
+
+    ASSERT_TRUE(cache.Load("a", contents));
+    EXPECT_EQ(contents, "aa");
+    EXPECT_TRUE(cached(cache, "b"));
+    EXPECT_TRUE(cached(cache, "c"));
+
+    // Erasing a box releases its bytes
+    cache.Erase("b");
+    cache.Erase("missing");
+    cache.Store("d", "dddd");
+
+    EXPECT_FALSE(cached(cache, "b"));
+    EXPECT_TRUE(cached(cache, "a"));
+    EXPECT_TRUE(cached(cache, "c"));
+    EXPECT_TRUE(cached(cache, "d"));
+
+    // One more byte evicts the least recently used box
+    cache.Store("e", "e");
+
+    EXPECT_FALSE(cached(cache, "a"));
+    EXPECT_TRUE(cached(cache, "c"));
+    EXPECT_TRUE(cached(cache, "d"));
+    EXPECT_TRUE(cached(cache, "e"));
+
+    // Replacing a box with contents which can not be cached drops the old
+    // copy instead of leaving it stale
+    cache.Store("c", std::string(11, 'c'));
+
+    EXPECT_FALSE(cached(cache, "c"));
+}
+
+TEST(Test_BoxCache, signature_cap)
+{
+    const auto cache = BoxCache{10, 3};
+
+    EXPECT_FALSE(cache.Verified("1"));
+
+    cache.SetVerified("1");
+    cache.SetVerified("2");
+    cache.SetVerified("3");
+    // Marking a known digest again does not add a second entry
+    cache.SetVerified("1");
+
+    EXPECT_TRUE(cache.Verified("1"));
+    EXPECT_TRUE(cache.Verified("2"));
+    EXPECT_TRUE(cache.Verified("3"));
+
+    // The oldest digest is dropped once the cap is exceeded
+    cache.SetVerified("4");
+
+    EXPECT_FALSE(cache.Verified("1"));
+    EXPECT_TRUE(cache.Verified("2"));
+    EXPECT_TRUE(cache.Verified("3"));
+    EXPECT_TRUE(cache.Verified("4"));
+}
+}  // namespace
@@ -0,0 +1,245 @@
+// Copyright (c) 2010-2020 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "OTTestEnvironment.hpp"
+
+#include "server/RequestScheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using Scheduler = ot::server::RequestScheduler;
+using Resources = Scheduler::Resources;
+
+constexpr std::size_t threads_{4};
+constexpr std::size_t jobs_{300};
+
+const std::string alice_{"alice"};
+const std::string bob_{"bob"};
+const std::string carol_{"carol"};
+
+// Records which jobs ran, in what order, and whether any of them overlapped
+// with another job holding the same resource
+struct Recorder {
+    std::mutex lock_{};
+    std::map<std::string, std::vector<std::size_t>> order_{};
+    std::map<std::string, std::size_t> holders_{};
+    std::size_t running_{0};
+    bool exclusive_{false};
+    std::size_t conflicts_{0};
+
+    auto enter(const std::size_t index, const Resources& resources) -> void
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+
+        if (exclusive_) { ++conflicts_; }
+
+        for (const auto& resource : resources) {
+            if (0 < holders_[resource]++) { ++conflicts_; }
+
+            order_[resource].emplace_back(index);
+        }
+
+        ++running_;
+    }
+
+    auto enter_exclusive() -> void
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+
+        if (0 < running_) { ++conflicts_; }
+
+        exclusive_ = true;
+    }
+
+    auto leave(const Resources& resources) -> void
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+
+        for (const auto& resource : resources) { --holders_[resource]; }
+
+        --running_;
+    }
+
+    auto leave_exclusive() -> void
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        exclusive_ = false;
+    }
+};
+
+auto pause() -> void
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+}
+
+TEST(Test_RequestScheduler, per_resource_order)
+{
+    const auto sets = std::vector<Resources>{
+        {alice_}, {alice_, bob_}, {bob_}, {bob_, carol_}, {carol_}};
+    auto recorder = Recorder{};
+    auto scheduler = Scheduler{};
+    scheduler.Start(threads_);
+
+    for (std::size_t i{0}; i < jobs_; ++i) {
+        const auto& resources = sets.at(i % sets.size());
+        scheduler.Queue(resources, false, [&recorder, i, resources] {
+            recorder.enter(i, resources);
+            pause();
+            recorder.leave(resources);
+        });
+    }
+
+    // An exclusive job starts only after every earlier job has finished
+    auto finished = false;
+    scheduler.RunExclusive([&finished] { finished = true; });
+
+    EXPECT_TRUE(finished);
+    EXPECT_EQ(recorder.conflicts_, 0u);
+
+    for (const auto& resource : {alice_, bob_, carol_}) {
+        const auto& order = recorder.order_.at(resource);
+
+        EXPECT_EQ(order.size(), 2 * jobs_ / sets.size());
+        EXPECT_TRUE(std::is_sorted(order.begin(), order.end()));
+    }
+
+    scheduler.Stop();
+}
+
+TEST(Test_RequestScheduler, exclusive_jobs)
+{
+    auto recorder = Recorder{};
+    auto completed = std::atomic<std::size_t>{0};
+    auto stale = std::atomic<std::size_t>{0};
+    auto scheduler = Scheduler{};
+    scheduler.Start(threads_);
+
+    for (std::size_t i{0}; i < jobs_; ++i) {
+        if (0 == (i % 10)) {
+            scheduler.Queue({}, true, [&, i] {
+                recorder.enter_exclusive();
+
+                // Every job queued ahead of this one has already finished
+                if (completed.load() != i) { ++stale; }
+
+                pause();
+                recorder.leave_exclusive();
+                ++completed;
+            });
+        } else {
+            const auto resources = Resources{std::to_string(i)};
+            scheduler.Queue(resources, false, [&, i, resources] {
+                recorder.enter(i, resources);
+                pause();
+                recorder.leave(resources);
+                ++completed;
+            });
+        }
+    }
+
+    scheduler.RunExclusive([] {});
+
+    EXPECT_EQ(completed.load(), jobs_);
+    EXPECT_EQ(stale.load(), 0u);
+    EXPECT_EQ(recorder.conflicts_, 0u);
+
+    scheduler.Stop();
+}
+
+TEST(Test_RequestScheduler, run_exclusive_waits_for_running_jobs)
+{
+    auto started = std::promise<void>{};
+    auto gate = std::promise<void>{};
+    auto release = gate.get_future().share();
+    auto blocked = std::atomic<bool>{true};
+    auto ran = std::atomic<bool>{false};
+    auto scheduler = Scheduler{};
+    scheduler.Start(threads_);
+    scheduler.Queue({alice_}, false, [&] {
+        started.set_value();
+        release.wait();
+        blocked = false;
+    });
+    started.get_future().wait();
+
+    auto exclusive = std::thread{[&] {
+        scheduler.RunExclusive([&] {
+            // The job holding a resource must have finished first
+            ran = (false == blocked.load());
+        });
+    }};
+
+    // Jobs on unrelated resources queued behind the exclusive job wait too
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto later = std::atomic<bool>{false};
+    scheduler.Queue({bob_}, false, [&] { later = ran.load(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    EXPECT_FALSE(ran.load());
+
+    gate.set_value();
+    exclusive.join();
+
+    EXPECT_TRUE(ran.load());
+
+    scheduler.RunExclusive([] {});
+
+    EXPECT_TRUE(later.load());
+
+    scheduler.Stop();
+}
+
+TEST(Test_RequestScheduler, stop_discards_queued_jobs)
+{
+    auto started = std::promise<void>{};
+    auto gate = std::promise<void>{};
+    auto release = gate.get_future().share();
+    auto finished = std::atomic<bool>{false};
+    auto ran = std::atomic<std::size_t>{0};
+    auto token = std::make_shared<int>(0);
+    auto scheduler = Scheduler{};
+    scheduler.Start(1);
+    scheduler.Queue({alice_}, false, [&] {
+        started.set_value();
+        release.wait();
+        finished = true;
+    });
+
+    for (std::size_t i{0}; i < 10; ++i) {
+        scheduler.Queue({bob_}, false, [&ran, token] { ++ran; });
+    }
+
+    started.get_future().wait();
+    auto stop = std::thread{[&] { scheduler.Stop(); }};
+    // Give Stop time to flag the scheduler before the running job returns
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    gate.set_value();
+    stop.join();
+
+    // The running job completes, the queued jobs are dropped unrun and
+    // release everything they captured
+    EXPECT_TRUE(finished.load());
+    EXPECT_EQ(ran.load(), 0u);
+    EXPECT_EQ(token.use_count(), 1);
+
+    // Nothing is accepted after stopping, and waiting callers are released
+    auto late = false;
+    scheduler.Queue({}, false, [&late] { late = true; });
+    scheduler.RunExclusive([&late] { late = true; });
+
+    EXPECT_FALSE(late);
+}
+}  // namespace